@@ -101,6 +101,27 @@ static int arduino_setPixel(int x, int y, Bool turnOn)
     return 0;
 }
 
+//
+// @note ScreenRows is indexed by x, that is why the frame gets transposed here
+//
+static int arduino_drawFrame(const unsigned char rows[CLOCK_PATTERN_SIZE])
+{
+    for(size_t x = 0; x < countof(ScreenRows); ++x) {
+        const unsigned char bit = 1 << (CLOCK_SCREEN_WIDTH - x - 1);
+        byte column = 0;
+
+        for(size_t y = 0; y < CLOCK_PATTERN_SIZE; ++y) {
+            if(rows[y] & bit) {
+                column |= 1 << y;
+            }
+        }
+
+        ScreenRows[x] = column;
+    }
+
+    return 0;
+}
+
 static int arduino_uptimeMillis(unsigned long *milliseconds)
 {
     *milliseconds = millis();
@@ -135,6 +156,8 @@ void setup()
     clock_extern_uptimeMillis = arduino_uptimeMillis;
     clock_extern_initDateTime = arduino_initDateTime;
     clock_extern_clearScreen  = arduino_clearScreen;
+    clock_extern_drawFrame    = arduino_drawFrame;
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_PIXELS));
 
     // Set pins to output so you can control the shift register
     pinMode(LATCH_PIN, OUTPUT);
@@ -19,7 +19,10 @@
 
 #include <ncurses.h>
 #include <errno.h>
-#include <time.h>       // for localtime_r()
+#include <pthread.h>
+#include <unistd.h>     // for STDIN_FILENO
+#include <time.h>       // for localtime_r(), nanosleep()
+#include <sys/select.h> // for select()
 #include <sys/time.h>   // for gettimeofday()
 
 #include <logger.h>
@@ -32,6 +35,11 @@
 
 #define GETCH_TIMEOUT 50
 
+//
+// How often the refresh thread looks for a new frame
+//
+#define REFRESH_MILLIS 10
+
 static const char BannerStr[] = "BinaryClock by sealemar v."
                                 TOSTRING(VERSION_MAJOR) "."
                                 TOSTRING(VERSION_MINOR) "."
@@ -42,6 +50,16 @@ static WINDOW *WndBanner    = NULL;
 static WINDOW *WndClockFace = NULL;
 static WINDOW *WndNotes     = NULL;
 
+//
+// With the refresh thread the clock face is drawn by that thread from
+// clock_readFrame() and the library doesn't touch the terminal. ncurses is
+// not thread safe, so every terminal access takes TerminalLock then.
+// clock_update() doesn't need it, since it only renders frames.
+//
+static pthread_t       RefreshThread;
+static Bool            IsRefreshThreadRunning = FALSE;
+static int             IsRefreshThreadStopping = 0;
+static pthread_mutex_t TerminalLock = PTHREAD_MUTEX_INITIALIZER;
 
 static int destroyWindows()
 {
@@ -115,6 +133,53 @@ static int emulator_setPixel(int x, int y, Bool turnOn)
     return 0;
 }
 
+//
+// @brief draws a whole frame and refreshes the clock face once
+// @param rows one byte per row, the most significant bit is x = 0
+// @returns 0 on ok
+//
+static int emulator_drawFrame(const unsigned char rows[CLOCK_PATTERN_SIZE])
+{
+    NullCheck(rows);
+
+    for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        for(int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+            Call(emulator_setPixelRaw(x, y, rows[y] & 1 << (CLOCK_SCREEN_WIDTH - x - 1)));
+        }
+    }
+    CallNcurses( wrefresh(WndClockFace) );
+
+    return 0;
+}
+
+//
+// @brief draws the frames which the library publishes until
+//        IsRefreshThreadStopping is set
+//
+static void *emulator_refreshScreen(void *arg)
+{
+    (void)arg;
+
+    const struct timespec delay = { 0, REFRESH_MILLIS * 1000000L };
+    unsigned char rows[CLOCK_PATTERN_SIZE];
+    ClockFrame frame;
+    Bool isNew;
+
+    while(!__atomic_load_n(&IsRefreshThreadStopping, __ATOMIC_ACQUIRE)) {
+        if(clock_readFrame(&frame, &isNew) == 0 && isNew) {
+            clock_frame_toPattern(frame, rows);
+
+            pthread_mutex_lock(&TerminalLock);
+            emulator_drawFrame(rows);
+            pthread_mutex_unlock(&TerminalLock);
+        }
+
+        nanosleep(&delay, NULL);
+    }
+
+    return NULL;
+}
+
 static int emulator_uptimeMillis(unsigned long *millis)
 {
     struct timeval tv;
@@ -160,13 +225,20 @@ static int emulator_clearScreen()
 
 //
 // @brief initializes emulator
+// @param useRefreshThread if not FALSE, the clock face is drawn by a separate
+//        thread on its own cadence, so clock_update() never waits for
+//        the terminal
 //
-int emulator_init()
+int emulator_init(Bool useRefreshThread)
 {
     clock_extern_setPixel     = emulator_setPixel;
     clock_extern_uptimeMillis = emulator_uptimeMillis;
     clock_extern_initDateTime = emulator_initDateTime;
     clock_extern_clearScreen  = emulator_clearScreen;
+    clock_extern_drawFrame    = emulator_drawFrame;
+
+    // every terminal update is expensive, send only what has changed
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_PIXELS));
 
     CallMallocQuiet( initscr() );         // Start curses mode
     CallNcurses( raw() );                 // Line buffering disabled
@@ -186,6 +258,64 @@ int emulator_init()
     Call(initWindowBanner());
     Call(clock_extern_clearScreen());
 
+    if(useRefreshThread) {
+        // the thread waits for the keys in emulator_getch()
+        timeout(0);
+        Call(clock_setFlushPolicy(CLOCK_FLUSH_NONE));
+        Call(pthread_create(&RefreshThread, NULL, emulator_refreshScreen, NULL));
+        IsRefreshThreadRunning = TRUE;
+    }
+
+    return 0;
+}
+
+//
+// @brief waits for a key for up to GETCH_TIMEOUT milliseconds
+// @returns the key as getch() does or ERR if there was no key
+//
+int emulator_getch()
+{
+    if(!IsRefreshThreadRunning) {
+        return getch();
+    }
+
+    //
+    // Wait outside of TerminalLock, so that the refresh thread may draw meanwhile
+    //
+    struct timeval tv = { 0, GETCH_TIMEOUT * 1000L };
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(STDIN_FILENO, &fds);
+    select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv);
+
+    pthread_mutex_lock(&TerminalLock);
+    const int ch = getch();
+    pthread_mutex_unlock(&TerminalLock);
+
+    return ch;
+}
+
+//
+// @brief takes the terminal from the refresh thread. Every ncurses call out
+//        of the emulator functions should be made between
+//        emulator_lockTerminal() and emulator_unlockTerminal()
+// @returns 0 on success
+//
+int emulator_lockTerminal()
+{
+    if(IsRefreshThreadRunning) {
+        Call(pthread_mutex_lock(&TerminalLock));
+    }
+
+    return 0;
+}
+
+int emulator_unlockTerminal()
+{
+    if(IsRefreshThreadRunning) {
+        Call(pthread_mutex_unlock(&TerminalLock));
+    }
+
     return 0;
 }
 
@@ -201,6 +331,12 @@ int emulator_update(const ClockState *cs)
 
 int emulator_deinit()
 {
+    if(IsRefreshThreadRunning) {
+        __atomic_store_n(&IsRefreshThreadStopping, 1, __ATOMIC_RELEASE);
+        Call(pthread_join(RefreshThread, NULL));
+        IsRefreshThreadRunning = FALSE;
+    }
+
     Call(destroyWindows());
     CallNcurses( endwin() );
 
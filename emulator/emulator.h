@@ -27,7 +27,26 @@
 #define COLOR_ON     1
 #define COLOR_OFF    2
 
-int emulator_init();
+//
+// @brief initializes emulator
+// @param useRefreshThread if not FALSE, the clock face is drawn by a separate
+//        thread from clock_readFrame()
+//
+int emulator_init(Bool useRefreshThread);
+
+//
+// @brief waits for a key for a short time
+// @returns the key as getch() does or ERR if there was no key
+//
+int emulator_getch();
+
+//
+// @brief guard the terminal against the refresh thread. Every ncurses call
+//        out of the emulator functions should be made between them
+// @returns 0 on success
+//
+int emulator_lockTerminal();
+int emulator_unlockTerminal();
 
 //
 // @brief call this function from the main loop
@@ -0,0 +1,232 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock emulator events
+//
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include <logger.h>
+#include <clock_event_db.h>
+#include <clock_main.h>
+
+#include "emulator_events.h"
+
+//
+// A database and the events set from it. One generation is shown and
+// another one may be published, but not swapped in yet
+//
+typedef struct {
+    ClockEventDb        db;
+    ClockEvent         *events;
+    ClockEventIndex    *order;
+    ClockEventDayIndex  dayIndex;
+    Bool                isUsed;
+} Generation;
+
+static Generation Generations[2];
+
+static const char *Path      = NULL;
+static const char *FileName  = NULL;   // the last component of _Path_
+static int         WatchFd   = -1;
+static Bool        IsChanged = FALSE;
+
+static int releaseGeneration(Generation *g)
+{
+    if(g->db.mapping != NULL) Call(clock_event_db_unmap(&(g->db)));
+    free(g->events);
+    free(g->order);
+    memset(g, 0, sizeof(Generation));
+
+    return 0;
+}
+
+//
+// @brief maps the database to a free generation and sets its events to _list_
+//
+static int loadGeneration(Generation **generation, ClockEventList *list)
+{
+    Generation *g = Generations[0].isUsed ? &Generations[1] : &Generations[0];
+
+#ifdef PARAM_CHECKS
+    if(g->isUsed) OriginateErrorEx(EBUSY, "%d", "both generations of the events are used");
+#endif
+
+    g->isUsed = TRUE;
+
+    int res = clock_event_db_map(&(g->db), Path);
+    if(res == 0) {
+        g->events = calloc(g->db.count + 1, sizeof(ClockEvent));
+        g->order  = calloc(g->db.count + 1, sizeof(ClockEventIndex));
+        if(g->events == NULL || g->order == NULL) res = ENOMEM;
+    }
+    if(res == 0) res = clock_event_db_setList(&(g->db), list, g->events, g->order);
+    if(res == 0) res = clock_event_setDayIndex(list, &(g->dayIndex));
+
+    if(res) {
+        Call(releaseGeneration(g));
+        ContinueError(res, "%d");
+    }
+
+    *generation = g;
+
+    return 0;
+}
+
+//
+// @brief drains the notifications of the directory of the database
+//
+static void readChanges()
+{
+#ifdef __linux__
+    union {
+        struct inotify_event event;
+        char                 bytes[4096];
+    } buffer;
+
+    for(;;) {
+        const ssize_t size = read(WatchFd, &buffer, sizeof(buffer));
+        if(size <= 0) break;
+
+        for(ssize_t offset = 0; offset < size; ) {
+            const struct inotify_event *event = (const struct inotify_event *)(buffer.bytes + offset);
+
+            if(event->len > 0 && strcmp(event->name, FileName) == 0) {
+                IsChanged = TRUE;
+            }
+            offset += (ssize_t)(sizeof(struct inotify_event) + event->len);
+        }
+    }
+#endif
+}
+
+int emulator_events_init(const char *path, ClockEventList *list)
+{
+    NullCheck(path);
+    NullCheck(list);
+
+    Path = path;
+
+    const char *slash = strrchr(path, '/');
+    FileName = slash != NULL ? slash + 1 : path;
+
+    Generation *g;
+    Call(loadGeneration(&g, list));
+
+#ifdef __linux__
+    //
+    // The directory is watched, so that the replaced files are seen too
+    //
+    char directory[FILENAME_MAX];
+    if(slash == NULL) {
+        strcpy(directory, ".");
+    } else if(slash == path) {
+        strcpy(directory, "/");
+    } else if((size_t)(slash - path) < sizeof(directory)) {
+        memcpy(directory, path, (size_t)(slash - path));
+        directory[slash - path] = '\0';
+    } else {
+        OriginateErrorEx(ENAMETOOLONG, "%d", "the directory of '%s' is too long", path);
+    }
+
+    WatchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(WatchFd == -1) OriginateErrorEx(errno, "%d", "inotify_init1() failed: %s", strerror(errno));
+
+    if(inotify_add_watch(WatchFd, directory, IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+        OriginateErrorEx(errno, "%d", "watching '%s' failed: %s", directory, strerror(errno));
+#endif
+
+    return 0;
+}
+
+int emulator_events_update(ClockState *cs)
+{
+    NullCheck(cs);
+
+    if(Path == NULL) return 0;
+
+    //
+    // The clock doesn't use the swapped out events anymore
+    //
+    ClockEventList retired;
+    Bool           isRetired;
+    Call(clock_reclaimEvents(cs, &retired, &isRetired));
+
+    if(isRetired) {
+        for(size_t i = 0; i < countof(Generations); ++i) {
+            if(Generations[i].isUsed && Generations[i].events == retired.events) {
+                Call(releaseGeneration(&Generations[i]));
+            }
+        }
+    }
+
+    //
+    // The published events are sorted again if the clock has gone to another year
+    //
+    if(cs->events.swap == CLOCK_EVENTS_SWAP_STALE) {
+        ClockEventList list = cs->events.next;
+        Call(clock_publishEvents(cs, &list));
+    }
+
+    readChanges();
+
+    //
+    // The next change is published once the last one is swapped in
+    //
+    if(IsChanged && cs->events.swap == CLOCK_EVENTS_SWAP_NONE) {
+        Generation    *g;
+        ClockEventList list;
+
+        IsChanged = FALSE;
+
+        //
+        // The events which are shown stay if the new database is bad
+        //
+        if(loadGeneration(&g, &list) == 0) {
+            int res = clock_publishEvents(cs, &list);
+            if(res) {
+                Call(releaseGeneration(g));
+                ContinueError(res, "%d");
+            }
+        }
+    }
+
+    return 0;
+}
+
+int emulator_events_deinit()
+{
+#ifdef __linux__
+    if(WatchFd != -1) {
+        close(WatchFd);
+        WatchFd = -1;
+    }
+#endif
+
+    for(size_t i = 0; i < countof(Generations); ++i) {
+        Call(releaseGeneration(&Generations[i]));
+    }
+
+    Path = NULL;
+
+    return 0;
+}
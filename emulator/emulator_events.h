@@ -0,0 +1,49 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock emulator events. The events are loaded from a database
+//        made by tools/event_db, which is watched and swapped in again with
+//        clock_publishEvents() when it changes
+//
+
+#ifndef BINARY_CLOCK_EMULATOR_EMULATOR_EVENTS_H
+#define BINARY_CLOCK_EMULATOR_EMULATOR_EVENTS_H
+
+#include <clock_state.h>
+
+//
+// @brief maps an event database and starts watching it. A new database
+//        should replace the file with rename(), as tools/event_db does,
+//        since the shown events are read from the mapping of the old one
+//        until they are swapped out
+// @param path the database
+// @param list the events of the database will be set here. Pass it to
+//        clock_setEvents()
+// @returns 0 on success
+//
+int emulator_events_init(const char *path, ClockEventList *list);
+
+//
+// @brief call this function from the main loop between clock_update() calls.
+//        It releases the events which the clock has swapped out and publishes
+//        the database again if it has changed
+//
+int emulator_events_update(ClockState *cs);
+
+//
+// @brief releases the events and stops watching the database
+//
+int emulator_events_deinit();
+
+#endif
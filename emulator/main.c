@@ -18,12 +18,14 @@
 //
 
 #include <stdlib.h>
+#include <string.h>
 #include <ncurses.h>
 
 #include <logger.h>
 #include <clock_main.h>
 #include "emulator.h"
 #include "emulator_button.h"
+#include "emulator_events.h"
 
 FILE *errStream;
 FILE *outStream;
@@ -31,24 +33,66 @@ FILE *outStream;
 void atExit()
 {
     emulator_deinit();
+    emulator_events_deinit();
 }
 
-int main()
+//
+// Usage: terminal-binary-clock [-t] [-f atlas] [-e events]
+//
+//   -t        draw the clock face from a separate refresh thread
+//   -f atlas  slide the text with a font atlas made by tools/bdf_atlas
+//   -e events show the events of a database made by tools/event_db. They are
+//             swapped in again every time the database changes
+//
+int main(int argc, char *argv[])
 {
     errStream = stderr;
     outStream = stdout;
 
-    Call(emulator_init());
+    Bool useRefreshThread = FALSE;
+    const char *fontPath = NULL;
+    const char *eventsPath = NULL;
+    for(int i = 1; i < argc; ++i) {
+        if(strcmp(argv[i], "-t") == 0) {
+            useRefreshThread = TRUE;
+        } else if(strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            fontPath = argv[++i];
+        } else if(strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            eventsPath = argv[++i];
+        }
+    }
+
+    //
+    // The font and the events are mapped before the terminal is taken, so that an error is seen
+    //
+    static ClockFont font;
+    if(fontPath != NULL) {
+        Call(clock_font_map(&font, fontPath));
+        clock_setFont(&font);
+    }
+
+    ClockEventList events;
+    if(eventsPath != NULL) {
+        Call(emulator_events_init(eventsPath, &events));
+    }
+
+    Call(emulator_init(useRefreshThread));
     atexit(atExit);
 
     ClockState cs;
     Call(clock_init(&cs));
+    if(eventsPath != NULL) Call(clock_setEvents(&cs, &events));
 
-    for(int ch = getch(); ch != 27; ch = getch())
+    for(int ch = emulator_getch(); ch != 27; ch = emulator_getch())
     {
-        Call(emulator_button_press(&cs.buttons, ch, NULL));
-        Call(emulator_update(&cs));
+        Call(emulator_lockTerminal());
+        int res = emulator_button_press(&cs.buttons, ch, NULL);
+        if(res == 0) res = emulator_update(&cs);
+        Call(emulator_unlockTerminal());
+        if(res) ContinueError(res, "%d");
+
         Call(clock_update(&cs));
+        Call(emulator_events_update(&cs));
     }
 
     return 0;
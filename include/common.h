@@ -32,6 +32,27 @@ typedef enum { FALSE = 0, TRUE } Bool;
 
 #define countof(x) (sizeof(x) / sizeof(*x))
 
+//
+// @brief Constant lookup tables. On AVR they are kept in the program memory (flash),
+//        so that they don't take RAM, and have to be read with romRead*() macros.
+//        On other platforms these macros are plain memory reads.
+//
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#define ROM_DATA PROGMEM
+#define romReadByte(addr)  pgm_read_byte(addr)
+#define romReadWord(addr)  pgm_read_word(addr)
+#define romReadDword(addr) pgm_read_dword(addr)
+#define romReadQword(addr) \
+    ( (uint64_t)pgm_read_dword(addr) | (uint64_t)pgm_read_dword((const char *)(addr) + 4) << 32 )
+#else
+#define ROM_DATA
+#define romReadByte(addr)  (*(addr))
+#define romReadWord(addr)  (*(addr))
+#define romReadDword(addr) (*(addr))
+#define romReadQword(addr) (*(addr))
+#endif
+
 //
 // @brief Call(function) makes a function call taking PARAM_CHECKS macro into
 //        consideration. If the macro is defined, ContinueError(functionResult, "%d");
@@ -25,9 +25,399 @@
 #include <string.h>
 
 #include "clock.h"
+#include "clock_buffer.h"
+#include "clock_font.h"
 #include "clock_state.h" // for MIN_YEAR
+#include "clock_transition.h"
 
-#define DATE_TIME_BINARY_WIDTH 2
+//
+// Every column is set in this mask
+//
+#define ALL_COLUMNS ( (1U << CLOCK_SCREEN_WIDTH) - 1 )
+
+//
+// @brief returns a mask of _width_ columns starting from _pos_.
+//        Column x = 0 is the most significant bit
+//
+#define columnsMask(pos, width) \
+    ( ((1U << (width)) - 1) << (CLOCK_SCREEN_WIDTH - (pos) - (width)) )
+
+//
+// @brief a binary bar of _n_ over the whole width of the screen. Bit y of _n_
+//        lights row (CLOCK_SCREEN_HEIGHT - y - 1), so the least significant bit
+//        is at the bottom
+//
+#define binaryBar(n) ( \
+    ((ClockFrame)(((n) >> 7) & 1) * 0xff)       | ((ClockFrame)(((n) >> 6) & 1) * 0xff) <<  8 \
+  | ((ClockFrame)(((n) >> 5) & 1) * 0xff) << 16 | ((ClockFrame)(((n) >> 4) & 1) * 0xff) << 24 \
+  | ((ClockFrame)(((n) >> 3) & 1) * 0xff) << 32 | ((ClockFrame)(((n) >> 2) & 1) * 0xff) << 40 \
+  | ((ClockFrame)(((n) >> 1) & 1) * 0xff) << 48 | ((ClockFrame)( (n)       & 1) * 0xff) << 56 )
+
+#define binaryBars4(n)   binaryBar(n),        binaryBar((n) + 1),   binaryBar((n) + 2),    binaryBar((n) + 3)
+#define binaryBars16(n)  binaryBars4(n),      binaryBars4((n) + 4), binaryBars4((n) + 8),  binaryBars4((n) + 12)
+#define binaryBars64(n)  binaryBars16(n),     binaryBars16((n) + 16), binaryBars16((n) + 32), binaryBars16((n) + 48)
+
+//
+// Bit spreading table. BinaryBars[n] is binaryBar(n), so that a bar of any
+// width at any position is BinaryBars[n] masked with the bar columns.
+//
+static const ClockFrame BinaryBars[CLOCK_MAX_BINARY_NUMBER + 1] ROM_DATA = {
+    binaryBars64(0), binaryBars64(64), binaryBars64(128), binaryBars64(192)
+};
+
+//
+// The frame which the library has drawn last. All the drawing functions
+// update the frame in memory first and then send it to the screen either
+// with clock_extern_drawFrame() or pixel by pixel with clock_extern_setPixel()
+//
+static ClockFrame Frame = CLOCK_FRAME_BLANK;
+
+//
+// The frame which was last sent to the screen. _emitFrame() compares Frame
+// against it to forward only what has changed (depending on FlushPolicy).
+// ShadowIsValid is FALSE until the screen contents become known.
+//
+static ClockFrame   Shadow        = CLOCK_FRAME_BLANK;
+static Bool         ShadowIsValid = FALSE;
+static unsigned int FlushPolicy   = CLOCK_FLUSH_ALL;
+
+//
+// Every frame sent to the screen is published here as well, so that
+// clock_readFrame() always gets a complete one. Published is the last
+// frame which went to FrontBuffer
+//
+static ClockBuffer FrontBuffer = CLOCK_BUFFER_INITIALIZER;
+static ClockFrame  Published   = CLOCK_FRAME_BLANK;
+
+//
+// While a transition is running, the screen shows a blend of TransitionFrom
+// and Frame instead of Frame (see clock_beginTransition())
+//
+static unsigned int TransitionType = CLOCK_TRANSITION_NONE;
+static unsigned int TransitionStep = 0;
+static ClockFrame   TransitionFrom = CLOCK_FRAME_BLANK;
+
+//
+// @brief packs a pattern into a frame
+// @param pattern should be one of defined in alphabet.h or of the same format
+// @returns the frame
+//
+ClockFrame clock_frame_fromPattern(const unsigned char pattern[CLOCK_PATTERN_SIZE])
+{
+    ClockFrame frame = CLOCK_FRAME_BLANK;
+
+    for(int y = CLOCK_SCREEN_HEIGHT - 1; y >= 0; --y) {
+        frame = (frame << 8) | pattern[y];
+    }
+
+    return frame;
+}
+
+//
+// @brief unpacks a frame into a pattern
+// @param frame
+// @param pattern the result will be written here
+//
+void clock_frame_toPattern(ClockFrame frame, unsigned char pattern[CLOCK_PATTERN_SIZE])
+{
+    for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y, frame >>= 8) {
+        pattern[y] = (unsigned char)frame;
+    }
+}
+
+//
+// @brief mirrors the frame horizontally (pixel x goes to CLOCK_SCREEN_WIDTH - x - 1)
+//
+ClockFrame clock_frame_mirror(ClockFrame frame)
+{
+    frame = ((frame >> 1) & 0x5555555555555555ULL) | ((frame & 0x5555555555555555ULL) << 1);
+    frame = ((frame >> 2) & 0x3333333333333333ULL) | ((frame & 0x3333333333333333ULL) << 2);
+    frame = ((frame >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((frame & 0x0f0f0f0f0f0f0f0fULL) << 4);
+
+    return frame;
+}
+
+//
+// @brief flips the frame vertically (row y goes to CLOCK_SCREEN_HEIGHT - y - 1)
+//
+ClockFrame clock_frame_flip(ClockFrame frame)
+{
+    frame = ((frame >>  8) & 0x00ff00ff00ff00ffULL) | ((frame & 0x00ff00ff00ff00ffULL) <<  8);
+    frame = ((frame >> 16) & 0x0000ffff0000ffffULL) | ((frame & 0x0000ffff0000ffffULL) << 16);
+    frame = ( frame >> 32)                          | ( frame                           << 32);
+
+    return frame;
+}
+
+//
+// @brief transposes the frame (pixel (x, y) goes to (y, x))
+//
+// @note Since pixel x = 0 is the most significant bit of a row, the transposition
+//       is a flip about the anti-diagonal of the 64 bit word. It is done with three
+//       delta swaps, see "Hacker's Delight" 7-3 or
+//       https://www.chessprogramming.org/Flipping_Mirroring_and_Rotating
+//
+ClockFrame clock_frame_transpose(ClockFrame frame)
+{
+    ClockFrame t;
+
+    t      = frame ^ (frame << 36);
+    frame ^= 0xf0f0f0f00f0f0f0fULL & (t ^ (frame >> 36));
+    t      = 0xcccc0000cccc0000ULL & (frame ^ (frame << 18));
+    frame ^= t ^ (t >> 18);
+    t      = 0xaa00aa00aa00aa00ULL & (frame ^ (frame << 9));
+    frame ^= t ^ (t >> 9);
+
+    return frame;
+}
+
+//
+// @brief rotates the frame 90 degrees clockwise
+//
+ClockFrame clock_frame_rotate90(ClockFrame frame)
+{
+    return clock_frame_mirror(clock_frame_transpose(frame));
+}
+
+//
+// @brief rotates the frame 180 degrees
+//
+ClockFrame clock_frame_rotate180(ClockFrame frame)
+{
+    return clock_frame_mirror(clock_frame_flip(frame));
+}
+
+//
+// @brief sends Frame to the screen
+// @param columns a mask of the columns which were changed in Frame. If the
+//        implementation doesn't provide clock_extern_drawFrame(), only these
+//        columns will be sent with clock_extern_setPixel() in CLOCK_FLUSH_ALL
+//        policy. Other policies work out the changes from Shadow.
+// @returns 0 on success
+//
+static int _emitFrame(unsigned int columns)
+{
+    ClockFrame frame = Frame;
+
+    if(TransitionType != CLOCK_TRANSITION_NONE) {
+        Call(clock_transition_blend(TransitionType, TransitionFrom, Frame, TransitionStep, &frame));
+        columns = ALL_COLUMNS;
+    }
+
+    if(frame != Published) {
+        Call(clock_buffer_publish(&FrontBuffer, frame));
+        Published = frame;
+    }
+
+    if(FlushPolicy == CLOCK_FLUSH_NONE) {
+        return 0;
+    }
+
+    const Bool isDiff = FlushPolicy != CLOCK_FLUSH_ALL && ShadowIsValid;
+
+    if(isDiff && frame == Shadow) {
+        return 0;
+    }
+
+    //
+    // If anything fails in the middle, the screen contents are unknown
+    //
+    ShadowIsValid = FALSE;
+
+    if(clock_extern_drawFrame != NULL) {
+        unsigned char rows[CLOCK_PATTERN_SIZE];
+        clock_frame_toPattern(frame, rows);
+        Call(clock_extern_drawFrame(rows));
+    } else {
+        const ClockFrame diff = frame ^ Shadow;
+
+        for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y)
+        {
+            const unsigned char ch = clock_frame_getRow(frame, y);
+            unsigned int changed = columns;
+
+            if(FlushPolicy == CLOCK_FLUSH_ROWS) {
+                changed = (isDiff && clock_frame_getRow(diff, y) == 0) ? 0 : ALL_COLUMNS;
+            } else if(FlushPolicy == CLOCK_FLUSH_PIXELS) {
+                changed = isDiff ? clock_frame_getRow(diff, y) : ALL_COLUMNS;
+            }
+
+            for(int x = 0; changed; ++x) {
+                const unsigned int bit = 1U << (CLOCK_SCREEN_WIDTH - x - 1);
+
+                if(changed & bit) {
+                    Call(clock_extern_setPixel(x, y, ch & bit));
+                    changed &= ~bit;
+                }
+            }
+        }
+    }
+
+    Shadow        = frame;
+    ShadowIsValid = TRUE;
+
+    return 0;
+}
+
+//
+// @brief puts a given number in a binary format to Frame
+// @see clock_displayBinaryNumber() for the parameters description
+//
+static void _putBinaryNumber(unsigned int number, unsigned int width, unsigned int pos)
+{
+    const ClockFrame mask = clock_frame_replicateRow(columnsMask(pos, width));
+
+    Frame = (Frame & ~mask) | (romReadQword(&BinaryBars[number & CLOCK_MAX_BINARY_NUMBER]) & mask);
+}
+
+//
+// @brief puts the three binary bars of the time or the date face to Frame.
+//        Only the bars which fields were changed are put.
+// @param values the new bar values
+// @param fields the DATE_TIME_*_CHANGED field of every bar
+// @param changed a mask of DATE_TIME_*_CHANGED fields
+// @returns a mask of the columns which were put
+//
+static unsigned int _putDateTimeBars(const int values[3], const unsigned char fields[3], unsigned int changed)
+{
+    static const unsigned char positions[] = { DATE_TIME_BAR_1_POS, DATE_TIME_BAR_2_POS, DATE_TIME_BAR_3_POS };
+    unsigned int columns = 0;
+
+    for(size_t i = 0; i < countof(positions); ++i) {
+        if(changed & fields[i]) {
+            _putBinaryNumber(values[i], DATE_TIME_BINARY_WIDTH, positions[i]);
+            columns |= columnsMask(positions[i], DATE_TIME_BINARY_WIDTH);
+        }
+    }
+
+    return columns;
+}
+
+//
+// @brief Clears the frame which the library keeps in memory and the clock screen.
+//        Use clock_clearScreen() macro instead of calling this function directly
+// @returns 0 on success
+//
+int clock_clearFrame(void)
+{
+    Frame          = CLOCK_FRAME_BLANK;
+    TransitionType = CLOCK_TRANSITION_NONE;
+
+    if(clock_extern_clearScreen != NULL && FlushPolicy != CLOCK_FLUSH_NONE) {
+        Call(clock_buffer_publish(&FrontBuffer, CLOCK_FRAME_BLANK));
+        Published     = CLOCK_FRAME_BLANK;
+        ShadowIsValid = FALSE;
+        Call(clock_extern_clearScreen());
+        Shadow        = CLOCK_FRAME_BLANK;
+        ShadowIsValid = TRUE;
+    } else {
+        Call(_emitFrame(ALL_COLUMNS));
+    }
+
+    return 0;
+}
+
+//
+// @brief Starts a transition from what is on the screen now to whatever will be
+//        drawn next. Frame is cleared as clock_clearFrame() does, but the screen
+//        keeps showing the old frame until clock_stepTransition() blends the new
+//        one in step by step.
+// @param type one of CLOCK_TRANSITION_*. CLOCK_TRANSITION_NONE is the same as
+//        clock_clearFrame()
+// @returns 0 on success
+// EINVAL - if _type_ is unknown
+//
+int clock_beginTransition(unsigned int type)
+{
+#ifdef PARAM_CHECKS
+    if(type >= CLOCK_TRANSITION_COUNT)
+        OriginateErrorEx(EINVAL, "%d", "transition type[%u] is unknown", type);
+#endif
+
+    if(type == CLOCK_TRANSITION_NONE) {
+        Call(clock_clearFrame());
+        return 0;
+    }
+
+    TransitionFrom = ShadowIsValid ? Shadow : Frame;
+    TransitionType = type;
+    TransitionStep = 0;
+    Frame          = CLOCK_FRAME_BLANK;
+
+    return 0;
+}
+
+//
+// @brief Advances the running transition by one step and sends the blend to the screen
+// @param isDone is an output variable which is set to TRUE when the transition is over
+//        (or if there was no transition at all)
+// @returns 0 on success
+// EINVAL - if _isDone_ is NULL
+//
+int clock_stepTransition(Bool *isDone)
+{
+    NullCheck(isDone);
+
+    if(TransitionType == CLOCK_TRANSITION_NONE) {
+        *isDone = TRUE;
+        return 0;
+    }
+
+    if(++TransitionStep >= CLOCK_TRANSITION_STEPS) {
+        TransitionType = CLOCK_TRANSITION_NONE;
+    }
+
+    *isDone = TransitionType == CLOCK_TRANSITION_NONE;
+
+    Call(_emitFrame(ALL_COLUMNS));
+
+    return 0;
+}
+
+//
+// @brief Chooses how much of a redrawn frame is forwarded to the screen
+// @param policy one of CLOCK_FLUSH_ALL, CLOCK_FLUSH_ROWS, CLOCK_FLUSH_PIXELS
+// @returns 0 on success
+// EINVAL - if _policy_ is unknown
+//
+// @note the next redraw after this call sends the whole frame
+//
+int clock_setFlushPolicy(unsigned int policy)
+{
+#ifdef PARAM_CHECKS
+    if(policy > CLOCK_FLUSH_NONE)
+        OriginateErrorEx(EINVAL, "%d", "policy[%u] should be <= %u", policy, CLOCK_FLUSH_NONE);
+#endif
+
+    FlushPolicy   = policy;
+    ShadowIsValid = FALSE;
+
+    return 0;
+}
+
+//
+// @brief Reads the last complete frame which the library has drawn
+// @param frame the frame will be written here
+// @param isNew is an output variable which is set to TRUE if the frame has
+//        changed since the last call. May be NULL
+// @returns 0 on success
+// EINVAL - if _frame_ is NULL
+//
+int clock_readFrame(ClockFrame *frame, Bool *isNew)
+{
+    Call(clock_buffer_read(&FrontBuffer, frame, isNew));
+
+    return 0;
+}
+
+//
+// @brief Tells the library that the screen was changed behind its back,
+//        so the next redraw sends the whole frame regardless of the flush policy
+//
+void clock_invalidateFrame(void)
+{
+    ShadowIsValid = FALSE;
+}
 
 //
 // @brief draws a pattern on the screen
@@ -41,13 +431,20 @@ int clock_drawPattern(const unsigned char pattern[CLOCK_PATTERN_SIZE])
 {
     NullCheck(pattern);
 
-    for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y)
-    {
-        const unsigned char ch = pattern[y];
+    Call(clock_drawFrame(clock_frame_fromPattern(pattern)));
 
-        for(int x = 0; x < CLOCK_SCREEN_WIDTH; ++x)
-            clock_extern_setPixel(x, y, ch & 1 << (CLOCK_SCREEN_WIDTH - x - 1));
-    }
+    return 0;
+}
+
+//
+// @brief draws a frame on the screen
+// @param frame a frame to draw
+// @returns 0 on success
+//
+int clock_drawFrame(ClockFrame frame)
+{
+    Frame = frame;
+    Call(_emitFrame(ALL_COLUMNS));
 
     return 0;
 }
@@ -73,11 +470,8 @@ int clock_displayBinaryNumber(unsigned int number, unsigned int width, unsigned
         OriginateErrorEx(EINVAL, "%d", "pos[%u] should be < %u", pos, CLOCK_SCREEN_WIDTH - width);
 #endif
 
-    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
-        for(unsigned int x = pos, xLast = pos + width; x < xLast; ++x) {
-            Call(clock_extern_setPixel(x, CLOCK_SCREEN_HEIGHT - y - 1, number & 1U << y));
-        }
-    }
+    _putBinaryNumber(number, width, pos);
+    Call(_emitFrame(columnsMask(pos, width)));
 
     return 0;
 }
@@ -89,12 +483,33 @@ int clock_displayBinaryNumber(unsigned int number, unsigned int width, unsigned
 // EINVAL - if _dt_ is NULL
 //
 int clock_displayTime(const DateTime *dt)
+{
+    Call(clock_updateTime(dt, DATE_TIME_ALL_CHANGED));
+
+    return 0;
+}
+
+//
+// @brief redraws only those binary bars of the time face which fields
+//        were changed
+// @param dt a pointer to DateTime which time should be displayed
+// @param changed a mask of DATE_TIME_*_CHANGED fields of _dt_ which differ
+//        from the time which is currently displayed (see date_time_clock_refresh()).
+//        DATE_TIME_ALL_CHANGED draws the whole time face
+// @returns 0 on success
+// EINVAL - if _dt_ is NULL
+//
+int clock_updateTime(const DateTime *dt, unsigned int changed)
 {
     NullCheck(dt);
 
-    Call(clock_displayBinaryNumber(dt->hour,   DATE_TIME_BINARY_WIDTH, 0));
-    Call(clock_displayBinaryNumber(dt->minute, DATE_TIME_BINARY_WIDTH, DATE_TIME_BINARY_WIDTH + 1));
-    Call(clock_displayBinaryNumber(dt->second, DATE_TIME_BINARY_WIDTH, ((DATE_TIME_BINARY_WIDTH) * 2) + 2));
+    static const unsigned char fields[] = { DATE_TIME_HOUR_CHANGED, DATE_TIME_MINUTE_CHANGED, DATE_TIME_SECOND_CHANGED };
+    const int values[] = { dt->hour, dt->minute, dt->second };
+    const unsigned int columns = _putDateTimeBars(values, fields, changed);
+
+    if(columns) {
+        Call(_emitFrame(columns));
+    }
 
     return 0;
 }
@@ -106,12 +521,33 @@ int clock_displayTime(const DateTime *dt)
 // EINVAL - if _dt_ is NULL
 //
 int clock_displayDate(const DateTime *dt)
+{
+    Call(clock_updateDate(dt, DATE_TIME_ALL_CHANGED));
+
+    return 0;
+}
+
+//
+// @brief redraws only those binary bars of the date face which fields
+//        were changed
+// @param dt a pointer to DateTime which date should be displayed
+// @param changed a mask of DATE_TIME_*_CHANGED fields of _dt_ which differ
+//        from the date which is currently displayed (see date_time_clock_refresh()).
+//        DATE_TIME_ALL_CHANGED draws the whole date face
+// @returns 0 on success
+// EINVAL - if _dt_ is NULL
+//
+int clock_updateDate(const DateTime *dt, unsigned int changed)
 {
     NullCheck(dt);
 
-    Call(clock_displayBinaryNumber(dt->month + 1, DATE_TIME_BINARY_WIDTH, 0));
-    Call(clock_displayBinaryNumber(dt->day, DATE_TIME_BINARY_WIDTH, DATE_TIME_BINARY_WIDTH + 1));
-    Call(clock_displayBinaryNumber(dt->year - MIN_YEAR, DATE_TIME_BINARY_WIDTH, ((DATE_TIME_BINARY_WIDTH) * 2) + 2));
+    static const unsigned char fields[] = { DATE_TIME_MONTH_CHANGED, DATE_TIME_DAY_CHANGED, DATE_TIME_YEAR_CHANGED };
+    const int values[] = { dt->month + 1, dt->day, dt->year - MIN_YEAR };
+    const unsigned int columns = _putDateTimeBars(values, fields, changed);
+
+    if(columns) {
+        Call(_emitFrame(columns));
+    }
 
     return 0;
 }
@@ -150,29 +586,108 @@ int clock_slidePattern(
     }
 #endif
 
-    for(int i = 0; i < CLOCK_SCREEN_HEIGHT; ++i)
-    {
-        pattern[i] = patternFrom[i] << step
-                   | patternTo[i]   >> (CLOCK_SCREEN_WIDTH - step);
-    }
+    clock_frame_toPattern(
+        clock_frame_shiftLeft(clock_frame_fromPattern(patternFrom), step, 0)
+      | clock_frame_shiftRight(clock_frame_fromPattern(patternTo), CLOCK_SCREEN_WIDTH - step, 0),
+        pattern);
 
     *isLastStep = step == CLOCK_SCREEN_WIDTH;
 
     return 0;
 }
 
+//
+// The font of clock_slideText(). NULL means the built-in alphabet
+//
+static const ClockFont *Font = NULL;
+
+//
+// @brief sets the font which clock_slideText() uses
+// @param font a loaded font or NULL to use the built-in alphabet. The font
+//        should outlive the calls to clock_slideText()
+//
+void clock_setFont(const ClockFont *font)
+{
+    Font = font;
+}
+
+//
+// @brief gets the font which clock_slideText() uses
+// @returns the font or NULL if the built-in alphabet is used
+//
+const ClockFont *clock_getFont(void)
+{
+    return Font;
+}
+
+//
+// @brief gets the frames of the glyphs which clock_slideText() shows at _step_
+// @param text
+// @param step
+// @param first the glyph which slides out will be written here
+// @param second the glyph which slides in will be written here
+// @returns the number of characters in _text_
+//
+static size_t _getSlideGlyphs(const char *text, size_t step, ClockFrame *first, ClockFrame *second)
+{
+    size_t count;
+    const size_t index = step / CLOCK_SCREEN_WIDTH;
+
+    if(Font == NULL) {
+        count = strlen(text);
+
+        int firstCharIndex  = CLOCK_BLANK;
+        int secondCharIndex = CLOCK_BLANK;
+        if(index < count) {
+            clock_alphabet_getIndexByCharacter(text[index], &firstCharIndex);
+            clock_alphabet_getIndexByCharacter(text[index + 1], &secondCharIndex);
+        }
+
+        *first  = clock_alphabet_getGlyph(firstCharIndex);
+        *second = clock_alphabet_getGlyph(secondCharIndex);
+
+        return count;
+    }
+
+    //
+    // Every codepoint of a UTF-8 text takes the whole screen width
+    //
+    uint32_t codepoints[2] = { 0, 0 };
+    const char *p = text;
+
+    for(count = 0; ; ++count) {
+        const uint32_t codepoint = clock_font_decodeUtf8(&p);
+        if(codepoint == 0) break;
+
+        if(count == index)     codepoints[0] = codepoint;
+        if(count == index + 1) codepoints[1] = codepoint;
+    }
+
+    ClockFrame *frames[2] = { first, second };
+    for(unsigned int i = 0; i < 2; ++i) {
+        unsigned int glyph;
+
+        *frames[i] = CLOCK_FRAME_BLANK;
+        if(codepoints[i] != 0 && clock_font_findGlyph(Font, codepoints[i], &glyph) == 0) {
+            *frames[i] = clock_font_getGlyphFrame(Font, glyph);
+        }
+    }
+
+    return count;
+}
+
 //
 // @brief slides _text_ from right to left the same way that clock_slidePattern
-//        slides a pattern. In fact, this function uses clock_slidePattern
-//        internally.
+//        slides a pattern. If a font is set with clock_setFont(), _text_ is
+//        UTF-8 and every codepoint is shown with the glyph of the font.
 //
 // @param text a text to slide
-// @param step indicates current iteration [ step <= CLOCK_SCREEN_WIDTH * (strlen(text) - 1) ]
+// @param step indicates current iteration [ step <= CLOCK_SCREEN_WIDTH * (length(text) - 1) ]
 // @param isLastStep is an output variable which if set to non zero value indicates the last iteration
 // @param pattern resulting pattern will be written here.
 // @returns 0 on success
 // EINVAL - if _text_ is NULL
-//          if _step_ > CLOCK_SCREEN_WIDTH * (strlen(text) - 1)
+//          if _step_ > CLOCK_SCREEN_WIDTH * (length(text) - 1)
 //          if _isLastStep_ is NULL
 //
 int clock_slideText(
@@ -185,7 +700,10 @@ int clock_slideText(
     NullCheck(isLastStep);
     NullCheck(pattern);
 
-    size_t lastStep = CLOCK_SCREEN_WIDTH * (strlen(text) - 1);
+    ClockFrame first;
+    ClockFrame second;
+
+    size_t lastStep = CLOCK_SCREEN_WIDTH * (_getSlideGlyphs(text, step, &first, &second) - 1);
 
 #ifdef PARAM_CHECKS
     if(step > lastStep)
@@ -197,24 +715,14 @@ int clock_slideText(
     }
 #endif
 
-    const char *chPos = text + (step / CLOCK_SCREEN_WIDTH);
     const unsigned char patternStep = step % CLOCK_SCREEN_WIDTH;
 
-    int firstCharIndex  = CLOCK_BLANK;
-    int secondCharIndex = CLOCK_BLANK;
-    clock_alphabet_getIndexByCharacter(chPos[0], &firstCharIndex);
-    clock_alphabet_getIndexByCharacter(chPos[1], &secondCharIndex);
-
     *isLastStep = step == lastStep;
 
-    Bool patternIsLastStep;
-
-    Call(clock_slidePattern(
-            ClockAlphabet[firstCharIndex],
-            ClockAlphabet[secondCharIndex],
-            patternStep,
-           &patternIsLastStep,
-            pattern));
+    clock_frame_toPattern(
+        clock_frame_shiftLeft(first, patternStep, 0)
+      | clock_frame_shiftRight(second, CLOCK_SCREEN_WIDTH - patternStep, 0),
+        pattern);
 
     return 0;
 }
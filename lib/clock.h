@@ -40,24 +40,232 @@ extern "C" {
 
 #define CLOCK_PATTERN_SIZE      (CLOCK_SCREEN_HEIGHT)
 
+//
+// The width of the binary bars of clock_displayTime() and clock_displayDate()
+//
+#define DATE_TIME_BINARY_WIDTH 2
+
+//
+// x positions of the binary bars of clock_displayTime() and clock_displayDate()
+//
+#define DATE_TIME_BAR_1_POS 0
+#define DATE_TIME_BAR_2_POS (DATE_TIME_BINARY_WIDTH + 1)
+#define DATE_TIME_BAR_3_POS (((DATE_TIME_BINARY_WIDTH) * 2) + 2)
+
+//
+// @brief Flush policies for clock_setFlushPolicy(). They define how much of a
+//        redrawn frame is forwarded to clock_extern_setPixel()
+//
+//        CLOCK_FLUSH_ALL    - every pixel of the redrawn area is sent (default)
+//        CLOCK_FLUSH_ROWS   - only the rows which differ from the last sent frame
+//                             are sent, each of them completely
+//        CLOCK_FLUSH_PIXELS - only the pixels which differ from the last sent frame
+//                             are sent
+//        CLOCK_FLUSH_NONE   - nothing is sent. The screen is refreshed on its own
+//                             cadence with the frames from clock_readFrame()
+//
+//        With CLOCK_FLUSH_ROWS and CLOCK_FLUSH_PIXELS clock_extern_drawFrame() is
+//        not called at all if the frame hasn't changed.
+//
+#define CLOCK_FLUSH_ALL     0U
+#define CLOCK_FLUSH_ROWS    1U
+#define CLOCK_FLUSH_PIXELS  2U
+#define CLOCK_FLUSH_NONE    3U
+
+//
+// @brief ClockFrame is the whole 8x8 screen packed into one 64 bit word.
+//        Row y takes byte y (bits 8 * y .. 8 * y + 7), pixel x of a row is
+//        bit (CLOCK_SCREEN_WIDTH - x - 1) of that byte, i.e. a row byte looks
+//        exactly like a row of a ClockAlphabet pattern.
+//
+//        The operations below work on the whole frame at once and don't branch.
+//
+typedef uint64_t ClockFrame;
+
+#define CLOCK_FRAME_BLANK ((ClockFrame)0)
+#define CLOCK_FRAME_FULL  (~(ClockFrame)0)
+
+//
+// @brief a frame which has the byte _b_ in every row
+//
+#define clock_frame_replicateRow(b) ( (ClockFrame)((b) & 0xff) * 0x0101010101010101ULL )
+
+//
+// @brief a frame which has all the pixels set to _fill_ (0 or 1)
+//
+#define clock_frame_fillMask(fill) ( (ClockFrame)0 - (ClockFrame)((fill) & 1) )
+
+//
+// @brief gets / sets row _y_ of a frame
+//
+#define clock_frame_getRow(frame, y) ( (unsigned char)((frame) >> ((y) << 3)) )
+#define clock_frame_setRow(frame, y, row) \
+    ( ((frame) & ~((ClockFrame)0xff << ((y) << 3))) | ((ClockFrame)((row) & 0xff) << ((y) << 3)) )
+
+//
+// @brief gets pixel (x, y) of a frame (0 or 1)
+//
+#define clock_frame_getPixel(frame, x, y) \
+    ( (int)(((frame) >> (((y) << 3) + CLOCK_SCREEN_WIDTH - (x) - 1)) & 1) )
+
+//
+// @brief compose frames
+//
+#define clock_frame_or(a, b)   ( (a) | (b) )
+#define clock_frame_and(a, b)  ( (a) & (b) )
+#define clock_frame_xor(a, b)  ( (a) ^ (b) )
+
+//
+// @brief keeps only the pixels of _frame_ which are set in _mask_
+//
+#define clock_frame_mask(frame, mask) ( (frame) & (mask) )
+
+//
+// @brief switches every pixel
+//
+#define clock_frame_invert(frame) ( ~(frame) )
+
+//
+// @brief shifts the frame by _n_ pixels [ 0 <= n <= CLOCK_SCREEN_WIDTH ] left or right.
+//        The released columns are set to _fill_ (0 or 1)
+//
+#define clock_frame_shiftLeft(frame, n, fill) ( \
+    ( ((frame) << (n)) & clock_frame_replicateRow(0xffU << (n)) ) \
+  | ( clock_frame_fillMask(fill) & clock_frame_replicateRow((1U << (n)) - 1) ) )
+
+#define clock_frame_shiftRight(frame, n, fill) ( \
+    ( ((frame) >> (n)) & clock_frame_replicateRow(0xffU >> (n)) ) \
+  | ( clock_frame_fillMask(fill) & clock_frame_replicateRow(~(0xffU >> (n))) ) )
+
+//
+// @brief shifts the frame by _n_ rows [ 0 <= n <= CLOCK_SCREEN_HEIGHT ] up or down.
+//        The released rows are set to _fill_ (0 or 1)
+//
+// @note the shift is done in two halves, so that n = CLOCK_SCREEN_HEIGHT doesn't shift
+//       a 64 bit word by 64 bits, which is undefined behaviour
+//
+#define clock_frame_shiftUp(frame, n, fill) ( \
+    ( ((frame) >> ((n) << 2)) >> ((n) << 2) ) \
+  | ( clock_frame_fillMask(fill) & ~((CLOCK_FRAME_FULL >> ((n) << 2)) >> ((n) << 2)) ) )
+
+#define clock_frame_shiftDown(frame, n, fill) ( \
+    ( ((frame) << ((n) << 2)) << ((n) << 2) ) \
+  | ( clock_frame_fillMask(fill) & ~((CLOCK_FRAME_FULL << ((n) << 2)) << ((n) << 2)) ) )
+
+//
+// @brief packs a pattern into a frame
+// @param pattern should be one of defined in alphabet.h or of the same format
+// @returns the frame
+//
+ClockFrame clock_frame_fromPattern(const unsigned char pattern[CLOCK_PATTERN_SIZE]);
+
+//
+// @brief unpacks a frame into a pattern
+// @param frame
+// @param pattern the result will be written here
+//
+void clock_frame_toPattern(ClockFrame frame, unsigned char pattern[CLOCK_PATTERN_SIZE]);
+
+//
+// @brief mirrors the frame horizontally (pixel x goes to CLOCK_SCREEN_WIDTH - x - 1)
+//
+ClockFrame clock_frame_mirror(ClockFrame frame);
+
+//
+// @brief flips the frame vertically (row y goes to CLOCK_SCREEN_HEIGHT - y - 1)
+//
+ClockFrame clock_frame_flip(ClockFrame frame);
+
+//
+// @brief transposes the frame (pixel (x, y) goes to (y, x))
+//
+ClockFrame clock_frame_transpose(ClockFrame frame);
+
+//
+// @brief rotates the frame 90 degrees clockwise
+//
+ClockFrame clock_frame_rotate90(ClockFrame frame);
+
+//
+// @brief rotates the frame 180 degrees
+//
+ClockFrame clock_frame_rotate180(ClockFrame frame);
+
 #include "clock_alphabet.h"
+#include "clock_font.h"
 #include "clock_extern.h"
 
 //
 // @brief Clears the clock screen.
 //        If the implementation provides clock_extern_clearScreen(),
-//        that function will be used.
+//        that function will be used. Otherwise if the implementation
+//        provides clock_extern_drawFrame(), a blank frame will be pushed.
 //        clock_drawPattern(ClockAlphabet[CLOCK_BLANK])
 //        will be used otherwise
 //
 #define clock_clearScreen() { \
-    if(clock_extern_clearScreen != NULL) { \
-        Call( clock_extern_clearScreen() ); \
-    } else { \
-        Call( clock_drawPattern(ClockAlphabet[CLOCK_BLANK]) ); \
-    } \
+    Call( clock_clearFrame() ); \
 }
 
+//
+// @brief Clears the frame which the library keeps in memory and the clock screen.
+//        Use clock_clearScreen() macro instead of calling this function directly
+// @returns 0 on success
+//
+int clock_clearFrame(void);
+
+//
+// @brief Starts a transition from what is on the screen now to whatever will be
+//        drawn next. Frame is cleared as clock_clearFrame() does, but the screen
+//        keeps showing the old frame until clock_stepTransition() blends the new
+//        one in step by step. See clock_transition.h for the types
+// @param type one of CLOCK_TRANSITION_*. CLOCK_TRANSITION_NONE is the same as
+//        clock_clearFrame()
+// @returns 0 on success
+// EINVAL - if _type_ is unknown
+//
+int clock_beginTransition(unsigned int type);
+
+//
+// @brief Advances the running transition by one step and sends the blend to the screen
+// @param isDone is an output variable which is set to TRUE when the transition is over
+//        (or if there was no transition at all)
+// @returns 0 on success
+// EINVAL - if _isDone_ is NULL
+//
+int clock_stepTransition(Bool *isDone);
+
+//
+// @brief Chooses how much of a redrawn frame is forwarded to the screen
+// @param policy one of CLOCK_FLUSH_ALL, CLOCK_FLUSH_ROWS, CLOCK_FLUSH_PIXELS, CLOCK_FLUSH_NONE
+// @returns 0 on success
+// EINVAL - if _policy_ is unknown
+//
+// @note the next redraw after this call sends the whole frame
+//
+int clock_setFlushPolicy(unsigned int policy);
+
+//
+// @brief Reads the last complete frame which the library has drawn. Every
+//        redraw publishes its frame with clock_buffer_publish(), so a display
+//        refresh in another thread or in an interrupt can call this function
+//        at any time without locks and never gets a frame half drawn
+// @param frame the frame will be written here
+// @param isNew is an output variable which is set to TRUE if the frame has
+//        changed since the last call. May be NULL
+// @returns 0 on success
+// EINVAL - if _frame_ is NULL
+//
+// @note only one thread may read the frames
+//
+int clock_readFrame(ClockFrame *frame, Bool *isNew);
+
+//
+// @brief Tells the library that the screen was changed behind its back,
+//        so the next redraw sends the whole frame regardless of the flush policy
+//
+void clock_invalidateFrame(void);
+
 //
 // @brief draws a pattern on the screen
 // @param pattern should be one of defined in alphabet.h
@@ -68,6 +276,13 @@ extern "C" {
 //
 int clock_drawPattern(const unsigned char pattern[CLOCK_PATTERN_SIZE]);
 
+//
+// @brief draws a frame on the screen
+// @param frame a frame to draw
+// @returns 0 on success
+//
+int clock_drawFrame(ClockFrame frame);
+
 //
 // @brief displays a given number in a binary format on the clock screen
 // @param number a number to display
@@ -88,6 +303,20 @@ int clock_displayBinaryNumber(unsigned int number, unsigned int width, unsigned
 //
 int clock_displayTime(const DateTime *dt);
 
+//
+// @brief redraws only those binary bars of the time face which fields
+//        were changed
+// @param dt a pointer to DateTime which time should be displayed
+// @param changed a mask of DATE_TIME_*_CHANGED fields of _dt_ which differ
+//        from the time which is currently displayed (see date_time_clock_refresh()).
+//        DATE_TIME_ALL_CHANGED draws the whole time face
+// @returns 0 on success
+// EINVAL - if _dt_ is NULL
+//
+// @note the time face has to be on the screen already (see clock_displayTime())
+//
+int clock_updateTime(const DateTime *dt, unsigned int changed);
+
 //
 // @brief displays date from a given DateTime
 //        MM DD YY
@@ -98,6 +327,20 @@ int clock_displayTime(const DateTime *dt);
 //
 int clock_displayDate(const DateTime *dt);
 
+//
+// @brief redraws only those binary bars of the date face which fields
+//        were changed
+// @param dt a pointer to DateTime which date should be displayed
+// @param changed a mask of DATE_TIME_*_CHANGED fields of _dt_ which differ
+//        from the date which is currently displayed (see date_time_clock_refresh()).
+//        DATE_TIME_ALL_CHANGED draws the whole date face
+// @returns 0 on success
+// EINVAL - if _dt_ is NULL
+//
+// @note the date face has to be on the screen already (see clock_displayDate())
+//
+int clock_updateDate(const DateTime *dt, unsigned int changed);
+
 //
 // @brief slides pattern from right to left
 // @param patternFrom right-side pattern (which initially appears on the screen)
@@ -119,18 +362,23 @@ int clock_slidePattern(
 
 //
 // @brief slides _text_ from right to left the same way that clock_slidePattern
-//        slides a pattern. In fact, this function uses clock_slidePattern
-//        internally.
+//        slides a pattern. If a font is set with clock_setFont(), _text_ is
+//        UTF-8 and every codepoint is shown with the glyph of the font,
+//        otherwise every byte is shown with the built-in alphabet.
 //
 // @param text a text to slide
-// @param step indicates current iteration [ step <= CLOCK_SCREEN_WIDTH * (strlen(text) - 1) ]
+// @param step indicates current iteration [ step <= CLOCK_SCREEN_WIDTH * (length(text) - 1) ]
 // @param isLastStep is an output variable which if set to non zero value indicates the last iteration
 // @param pattern resulting pattern will be written here.
 // @returns 0 on success
 // EINVAL - if _text_ is NULL
-//          if _step_ > CLOCK_SCREEN_WIDTH * (strlen(text) - 1)
+//          if _step_ > CLOCK_SCREEN_WIDTH * (length(text) - 1)
 //          if _isLastStep_ is NULL
 //
+// @note every call walks the whole _text_. To slide a text step by step,
+//       compile it once with clock_text_prepare() or clock_text_prepareFont()
+//       and use clock_text_window()
+//
 int clock_slideText(
         const char    *text,
         size_t         step,
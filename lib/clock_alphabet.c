@@ -563,6 +563,430 @@
 // - - o o o o - -      0x3c
 //
 
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - o o o - - -      0x38
+// - - - - - o - -      0x04
+// - - o o o o - -      0x3c
+// - o - - - o - -      0x44
+// - - o o o o - -      0x3c
+// - - - - - - - -      0x00
+//
+
+//
+// - o - - - - - -      0x40
+// - o - - - - - -      0x40
+// - o - o o - - -      0x58
+// - o o - - o - -      0x64
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o o o o - - -      0x78
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - o o o - - -      0x38
+// - o - - - - - -      0x40
+// - o - - - - - -      0x40
+// - o - - - o - -      0x44
+// - - o o o - - -      0x38
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - o - -      0x04
+// - - - - - o - -      0x04
+// - - o o - o - -      0x34
+// - o - - o o - -      0x4c
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - - o o o o - -      0x3c
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - o o o - - -      0x38
+// - o - - - o - -      0x44
+// - o o o o o - -      0x7c
+// - o - - - - - -      0x40
+// - - o o o - - -      0x38
+// - - - - - - - -      0x00
+//
+
+//
+// - - - o o - - -      0x18
+// - - o - - o - -      0x24
+// - - o - - - - -      0x20
+// - o o o - - - -      0x70
+// - - o - - - - -      0x20
+// - - o - - - - -      0x20
+// - - o - - - - -      0x20
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - o o o o - -      0x3c
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - - o o o o - -      0x3c
+// - - - - - o - -      0x04
+// - - o o o - - -      0x38
+//
+
+//
+// - o - - - - - -      0x40
+// - o - - - - - -      0x40
+// - o - o o - - -      0x58
+// - o o - - o - -      0x64
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - - - - - - - -      0x00
+//
+
+//
+// - - - o - - - -      0x10
+// - - - - - - - -      0x00
+// - - o o - - - -      0x30
+// - - - o - - - -      0x10
+// - - - o - - - -      0x10
+// - - - o - - - -      0x10
+// - - o o o - - -      0x38
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - o - - -      0x08
+// - - - - - - - -      0x00
+// - - - o o - - -      0x18
+// - - - - o - - -      0x08
+// - - - - o - - -      0x08
+// - o - - o - - -      0x48
+// - - o o - - - -      0x30
+// - - - - - - - -      0x00
+//
+
+//
+// - o - - - - - -      0x40
+// - o - - - - - -      0x40
+// - o - - o - - -      0x48
+// - o - o - - - -      0x50
+// - o o - - - - -      0x60
+// - o - o - - - -      0x50
+// - o - - o - - -      0x48
+// - - - - - - - -      0x00
+//
+
+//
+// - - o o - - - -      0x30
+// - - - o - - - -      0x10
+// - - - o - - - -      0x10
+// - - - o - - - -      0x10
+// - - - o - - - -      0x10
+// - - - o - - - -      0x10
+// - - o o o - - -      0x38
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o o - o - - -      0x68
+// - o - o - o - -      0x54
+// - o - o - o - -      0x54
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o - o o - - -      0x58
+// - o o - - o - -      0x64
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - o o o - - -      0x38
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - - o o o - - -      0x38
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o o o o - - -      0x78
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o o o o - - -      0x78
+// - o - - - - - -      0x40
+// - o - - - - - -      0x40
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - o o o o - -      0x3c
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - - o o o o - -      0x3c
+// - - - - - o - -      0x04
+// - - - - - o - -      0x04
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o - o o - - -      0x58
+// - o o - - o - -      0x64
+// - o - - - - - -      0x40
+// - o - - - - - -      0x40
+// - o - - - - - -      0x40
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - o o o o - -      0x3c
+// - o - - - - - -      0x40
+// - - o o o - - -      0x38
+// - - - - - o - -      0x04
+// - o o o o - - -      0x78
+// - - - - - - - -      0x00
+//
+
+//
+// - - o - - - - -      0x20
+// - - o - - - - -      0x20
+// - o o o - - - -      0x70
+// - - o - - - - -      0x20
+// - - o - - - - -      0x20
+// - - o - - o - -      0x24
+// - - - o o - - -      0x18
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o - - o o - -      0x4c
+// - - o o - o - -      0x34
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - - o - o - - -      0x28
+// - - - o - - - -      0x10
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o - o - o - -      0x54
+// - o - o - o - -      0x54
+// - - o - o - - -      0x28
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o - - - o - -      0x44
+// - - o - o - - -      0x28
+// - - - o - - - -      0x10
+// - - o - o - - -      0x28
+// - o - - - o - -      0x44
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - o - - - o - -      0x44
+// - - o o o o - -      0x3c
+// - - - - - o - -      0x04
+// - - o o o - - -      0x38
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o o o o o - -      0x7c
+// - - - - o - - -      0x08
+// - - - o - - - -      0x10
+// - - o - - - - -      0x20
+// - o o o o o - -      0x7c
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - o o - - -      0x18
+// - - - o o - - -      0x18
+// - - - - o - - -      0x08
+// - - - o - - - -      0x10
+//
+
+//
+// - - - - - - - -      0x00
+// - - - o o - - -      0x18
+// - - - o o - - -      0x18
+// - - - - - - - -      0x00
+// - - - o o - - -      0x18
+// - - - o o - - -      0x18
+// - - - - o - - -      0x08
+// - - - o - - - -      0x10
+//
+
+//
+// - - o o o - - -      0x38
+// - o - - - o - -      0x44
+// - - - - - o - -      0x04
+// - - - - o - - -      0x08
+// - - - o - - - -      0x10
+// - - - - - - - -      0x00
+// - - - o - - - -      0x10
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o o o o o o -      0x7e
+// - - - - - - - -      0x00
+// - o o o o o o -      0x7e
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+//
+
+//
+// - o o - o o - -      0x6c
+// - o o - o o - -      0x6c
+// - - o - - o - -      0x24
+// - o - - o - - -      0x48
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+//
+
+//
+// - - o - o - - -      0x28
+// - - o - o - - -      0x28
+// - o o o o o - -      0x7c
+// - - o - o - - -      0x28
+// - o o o o o - -      0x7c
+// - - o - o - - -      0x28
+// - - o - o - - -      0x28
+// - - - - - - - -      0x00
+//
+
+//
+// - o o - - o - -      0x64
+// - o o - - o - -      0x64
+// - - - - o - - -      0x08
+// - - - o - - - -      0x10
+// - - o - - - - -      0x20
+// - o - - o o - -      0x4c
+// - o - - o o - -      0x4c
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - o - - -      0x08
+// - - - o - - - -      0x10
+// - - o - - - - -      0x20
+// - o - - - - - -      0x40
+// - - o - - - - -      0x20
+// - - - o - - - -      0x10
+// - - - - o - - -      0x08
+// - - - - - - - -      0x00
+//
+
+//
+// - - o - - - - -      0x20
+// - - - o - - - -      0x10
+// - - - - o - - -      0x08
+// - - - - - o - -      0x04
+// - - - - o - - -      0x08
+// - - - o - - - -      0x10
+// - - o - - - - -      0x20
+// - - - - - - - -      0x00
+//
+
+//
+// - - o o o - - -      0x38
+// - - o - - - - -      0x20
+// - - o - - - - -      0x20
+// - - o - - - - -      0x20
+// - - o - - - - -      0x20
+// - - o - - - - -      0x20
+// - - o o o - - -      0x38
+// - - - - - - - -      0x00
+//
+
+//
+// - - o o o - - -      0x38
+// - - - - o - - -      0x08
+// - - - - o - - -      0x08
+// - - - - o - - -      0x08
+// - - - - o - - -      0x08
+// - - - - o - - -      0x08
+// - - o o o - - -      0x38
+// - - - - - - - -      0x00
+//
+
+//
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - - - - - - - -      0x00
+// - o o o o o o -      0x7e
+//
+
+//
+// The glyphs above are the reference the packed alphabet is generated from.
+// The library reads only the packed one (see lib/clock_alphabet_packed.c),
+// so this table is left out of AVR builds and takes no program memory there.
+//
+#ifndef __AVR__
 const unsigned char ClockAlphabet[CLOCK_ALPHABET_SIZE][CLOCK_PATTERN_SIZE] = {
     { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },     // blank
     { 0x38, 0x44, 0x4c, 0x54, 0x64, 0x44, 0x38, 0x00 },     // 0
@@ -613,6 +1037,103 @@ const unsigned char ClockAlphabet[CLOCK_ALPHABET_SIZE][CLOCK_PATTERN_SIZE] = {
     { 0x18, 0x18, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00 },     // '
     { 0x3c, 0x42, 0xa5, 0x81, 0xa5, 0x99, 0x42, 0x3c },     // smiley face smile
     { 0x3c, 0x42, 0xa5, 0x81, 0x99, 0xa5, 0x42, 0x3c },     // smiley face sad
+    { 0x00, 0x00, 0x38, 0x04, 0x3c, 0x44, 0x3c, 0x00 },     //  a
+    { 0x40, 0x40, 0x58, 0x64, 0x44, 0x44, 0x78, 0x00 },     //  b
+    { 0x00, 0x00, 0x38, 0x40, 0x40, 0x44, 0x38, 0x00 },     //  c
+    { 0x04, 0x04, 0x34, 0x4c, 0x44, 0x44, 0x3c, 0x00 },     //  d
+    { 0x00, 0x00, 0x38, 0x44, 0x7c, 0x40, 0x38, 0x00 },     //  e
+    { 0x18, 0x24, 0x20, 0x70, 0x20, 0x20, 0x20, 0x00 },     //  f
+    { 0x00, 0x00, 0x3c, 0x44, 0x44, 0x3c, 0x04, 0x38 },     //  g
+    { 0x40, 0x40, 0x58, 0x64, 0x44, 0x44, 0x44, 0x00 },     //  h
+    { 0x10, 0x00, 0x30, 0x10, 0x10, 0x10, 0x38, 0x00 },     //  i
+    { 0x08, 0x00, 0x18, 0x08, 0x08, 0x48, 0x30, 0x00 },     //  j
+    { 0x40, 0x40, 0x48, 0x50, 0x60, 0x50, 0x48, 0x00 },     //  k
+    { 0x30, 0x10, 0x10, 0x10, 0x10, 0x10, 0x38, 0x00 },     //  l
+    { 0x00, 0x00, 0x68, 0x54, 0x54, 0x44, 0x44, 0x00 },     //  m
+    { 0x00, 0x00, 0x58, 0x64, 0x44, 0x44, 0x44, 0x00 },     //  n
+    { 0x00, 0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00 },     //  o
+    { 0x00, 0x00, 0x78, 0x44, 0x44, 0x78, 0x40, 0x40 },     //  p
+    { 0x00, 0x00, 0x3c, 0x44, 0x44, 0x3c, 0x04, 0x04 },     //  q
+    { 0x00, 0x00, 0x58, 0x64, 0x40, 0x40, 0x40, 0x00 },     //  r
+    { 0x00, 0x00, 0x3c, 0x40, 0x38, 0x04, 0x78, 0x00 },     //  s
+    { 0x20, 0x20, 0x70, 0x20, 0x20, 0x24, 0x18, 0x00 },     //  t
+    { 0x00, 0x00, 0x44, 0x44, 0x44, 0x4c, 0x34, 0x00 },     //  u
+    { 0x00, 0x00, 0x44, 0x44, 0x44, 0x28, 0x10, 0x00 },     //  v
+    { 0x00, 0x00, 0x44, 0x44, 0x54, 0x54, 0x28, 0x00 },     //  w
+    { 0x00, 0x00, 0x44, 0x28, 0x10, 0x28, 0x44, 0x00 },     //  x
+    { 0x00, 0x00, 0x44, 0x44, 0x44, 0x3c, 0x04, 0x38 },     //  y
+    { 0x00, 0x00, 0x7c, 0x08, 0x10, 0x20, 0x7c, 0x00 },     //  z
+    { 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x08, 0x10 },     // ,
+    { 0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x08, 0x10 },     // ;
+    { 0x38, 0x44, 0x04, 0x08, 0x10, 0x00, 0x10, 0x00 },     // ?
+    { 0x00, 0x00, 0x7e, 0x00, 0x7e, 0x00, 0x00, 0x00 },     // =
+    { 0x6c, 0x6c, 0x24, 0x48, 0x00, 0x00, 0x00, 0x00 },     // "
+    { 0x28, 0x28, 0x7c, 0x28, 0x7c, 0x28, 0x28, 0x00 },     // #
+    { 0x64, 0x64, 0x08, 0x10, 0x20, 0x4c, 0x4c, 0x00 },     // %
+    { 0x08, 0x10, 0x20, 0x40, 0x20, 0x10, 0x08, 0x00 },     // <
+    { 0x20, 0x10, 0x08, 0x04, 0x08, 0x10, 0x20, 0x00 },     // >
+    { 0x38, 0x20, 0x20, 0x20, 0x20, 0x20, 0x38, 0x00 },     // [
+    { 0x38, 0x08, 0x08, 0x08, 0x08, 0x08, 0x38, 0x00 },     // ]
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7e },     // _
+};
+#endif
+
+//
+// Marks an exact match in CharacterIndices. Every other entry is the closest
+// glyph for the character, which is CLOCK_BLANK if nothing is close enough.
+//
+#define EXACT_MATCH 0x80
+
+#define exact(ch, index)   [(unsigned char)(ch)] = (index) | EXACT_MATCH
+#define closest(ch, index) [(unsigned char)(ch)] = (index)
+
+#define letter(upper, lower, name) exact(upper, CLOCK_##name), exact(lower, CLOCK_SMALL_##name)
+
+//
+// ClockAlphabet index by ASCII character
+//
+static const unsigned char CharacterIndices[256] ROM_DATA = {
+    exact(' ', CLOCK_BLANK),
+    exact('0', CLOCK_0), exact('1', CLOCK_1), exact('2', CLOCK_2), exact('3', CLOCK_3), exact('4', CLOCK_4),
+    exact('5', CLOCK_5), exact('6', CLOCK_6), exact('7', CLOCK_7), exact('8', CLOCK_8), exact('9', CLOCK_9),
+
+    letter('A', 'a', A), letter('B', 'b', B), letter('C', 'c', C), letter('D', 'd', D), letter('E', 'e', E),
+    letter('F', 'f', F), letter('G', 'g', G), letter('H', 'h', H), letter('I', 'i', I), letter('J', 'j', J),
+    letter('K', 'k', K), letter('L', 'l', L), letter('M', 'm', M), letter('N', 'n', N), letter('O', 'o', O),
+    letter('P', 'p', P), letter('Q', 'q', Q), letter('R', 'r', R), letter('S', 's', S), letter('T', 't', T),
+    letter('U', 'u', U), letter('V', 'v', V), letter('W', 'w', W), letter('X', 'x', X), letter('Y', 'y', Y),
+    letter('Z', 'z', Z),
+
+    exact('+',  CLOCK_PLUS),
+    exact('-',  CLOCK_MINUS),
+    exact('*',  CLOCK_MULTIPLY),
+    exact('/',  CLOCK_SLASH),
+    exact(':',  CLOCK_COLON),
+    exact('.',  CLOCK_POINT),
+    exact('!',  CLOCK_EXCLAMATION_MARK),
+    exact('(',  CLOCK_OPENING_PARENTHESES),
+    exact(')',  CLOCK_CLOSING_PARENTHESES),
+    exact('\'', CLOCK_TICK),
+    exact(001,  CLOCK_SMILEY_FACE_SMILE),
+    exact(002,  CLOCK_SMILEY_FACE_SAD),
+    exact(',',  CLOCK_COMMA),
+    exact(';',  CLOCK_SEMICOLON),
+    exact('?',  CLOCK_QUESTION_MARK),
+    exact('=',  CLOCK_EQUALS),
+    exact('"',  CLOCK_QUOTE),
+    exact('#',  CLOCK_HASH),
+    exact('%',  CLOCK_PERCENT),
+    exact('<',  CLOCK_LESS_THAN),
+    exact('>',  CLOCK_GREATER_THAN),
+    exact('[',  CLOCK_OPENING_BRACKET),
+    exact(']',  CLOCK_CLOSING_BRACKET),
+    exact('_',  CLOCK_UNDERSCORE),
+
+    closest('{', CLOCK_OPENING_PARENTHESES),
+    closest('}', CLOCK_CLOSING_PARENTHESES),
+    closest('`', CLOCK_TICK),
+    closest('\\', CLOCK_SLASH),
+    closest('|', CLOCK_EXCLAMATION_MARK),
 };
 
 //
@@ -621,7 +1142,7 @@ const unsigned char ClockAlphabet[CLOCK_ALPHABET_SIZE][CLOCK_PATTERN_SIZE] = {
 // @param clockAlphabetIndex a closest suitable index from ClockAlphabet for _ch_
 // @returns 0 on success
 // ERANGE if an exact match for _ch_ is not found (a closest pattern will be returned, i.e.
-//        if "a" is not found than an index to "A" will be returned. If a closest pattern can't be
+//        if "{" is not found than an index to "(" will be returned. If a closest pattern can't be
 //        identified, an index to blank patter will be returned in _clockAlphabetIndex_)
 //
 // EINVAL if _clockAlphabetIndex_ is NULL
@@ -630,35 +1151,88 @@ int clock_alphabet_getIndexByCharacter(unsigned char ch, int *clockAlphabetIndex
 {
     NullCheck(clockAlphabetIndex);
 
-    if(ch >= '0' && ch <= '9') {
-        *clockAlphabetIndex = CLOCK_0 + (ch - '0');
-        return 0;
-    }
-    if(ch >= 'A' && ch <= 'Z') {
-        *clockAlphabetIndex = CLOCK_A + (ch - 'A');
-        return 0;
-    }
-    if(ch >= 'a' && ch <= 'z') {
-        *clockAlphabetIndex = CLOCK_A + (ch - 'a');
-        return ERANGE;
+    const unsigned char index = romReadByte(&CharacterIndices[ch]);
+
+    *clockAlphabetIndex = index & ~EXACT_MATCH;
+
+    return (index & EXACT_MATCH) ? 0 : ERANGE;
+}
+
+//
+// @brief gets the used columns of a glyph from the packed alphabet. A glyph
+//        is found from the offset of its block plus the widths of the glyphs
+//        before it in the block
+// @param index an index of the glyph [ index < CLOCK_ALPHABET_SIZE ]
+// @param columns the first used column will be written here. It points
+//        to program memory on AVR, so it has to be read with romReadByte()
+// @param left the first used column of the 8x8 glyph will be written here
+// @param width the number of used columns will be written here
+// @warning _index_ is not checked for overflow
+//
+void clock_alphabet_getGlyphColumns(int index, const unsigned char **columns, unsigned int *left, unsigned int *width)
+{
+    const int first = index - index % CLOCK_ALPHABET_BLOCK;
+    unsigned int offset = romReadWord(&ClockAlphabetOffsets[index / CLOCK_ALPHABET_BLOCK]);
+
+    for(int i = first; i < index; ++i) {
+        offset += romReadByte(&ClockAlphabetExtents[i]) & 0x0f;
     }
 
-    switch(ch) {
-        case '+': *clockAlphabetIndex = CLOCK_PLUS;                return 0;
-        case '-': *clockAlphabetIndex = CLOCK_MINUS;               return 0;
-        case '*': *clockAlphabetIndex = CLOCK_MULTIPLY;            return 0;
-        case '/': *clockAlphabetIndex = CLOCK_SLASH;               return 0;
-        case ':': *clockAlphabetIndex = CLOCK_COLON;               return 0;
-        case '.': *clockAlphabetIndex = CLOCK_POINT;               return 0;
-        case '!': *clockAlphabetIndex = CLOCK_EXCLAMATION_MARK;    return 0;
-        case '(': *clockAlphabetIndex = CLOCK_OPENING_PARENTHESES; return 0;
-        case ')': *clockAlphabetIndex = CLOCK_CLOSING_PARENTHESES; return 0;
-        case '\'': *clockAlphabetIndex = CLOCK_TICK;               return 0;
-        case ' ': *clockAlphabetIndex = CLOCK_BLANK;               return 0;
-        case 001: *clockAlphabetIndex = CLOCK_SMILEY_FACE_SMILE;   return 0;
-        case 002: *clockAlphabetIndex = CLOCK_SMILEY_FACE_SAD;     return 0;
+    const unsigned char extent = romReadByte(&ClockAlphabetExtents[index]);
+
+    *columns = &ClockAlphabetColumns[offset];
+    *left    = extent >> 4;
+    *width   = extent & 0x0f;
+}
+
+//
+// @brief reads a glyph from the packed alphabet
+// @param index an index of the glyph [ index < CLOCK_ALPHABET_SIZE ]
+// @returns the glyph as a frame
+//
+ClockFrame clock_alphabet_getGlyph(int index)
+{
+    const unsigned char *columns;
+    unsigned int left, width;
+
+    clock_alphabet_getGlyphColumns(index, &columns, &left, &width);
+
+    unsigned char pattern[CLOCK_PATTERN_SIZE] = { 0 };
+    for(unsigned int x = 0; x < width; ++x) {
+        pattern[left + x] = romReadByte(columns + x);
     }
 
-    *clockAlphabetIndex = CLOCK_BLANK;
-    return ERANGE;
+    //
+    // The columns are the rows of the transposed glyph
+    //
+    return clock_frame_transpose(clock_frame_fromPattern(pattern));
+}
+
+//
+// @brief computes which columns of a glyph are used by its bitmap
+// @param index an index of the glyph [ index < CLOCK_ALPHABET_SIZE ]
+// @param left the first used column will be written here
+// @param width the number of columns from _left_ to the last used column
+//        will be written here. It is 0 for a blank glyph
+// @returns 0 on success
+// EINVAL if _left_ is NULL
+//        if _width_ is NULL
+// ERANGE if _index_ is out of the alphabet
+//
+int clock_alphabet_getGlyphExtent(int index, unsigned int *left, unsigned int *width)
+{
+    NullCheck(left);
+    NullCheck(width);
+
+#ifdef PARAM_CHECKS
+    if(index < 0 || index >= CLOCK_ALPHABET_SIZE)
+        OriginateErrorEx(ERANGE, "%d", "index[%d] should be 0 <= index < %d", index, CLOCK_ALPHABET_SIZE);
+#endif
+
+    const unsigned char extent = romReadByte(&ClockAlphabetExtents[index]);
+
+    *left  = extent >> 4;
+    *width = extent & 0x0f;
+
+    return 0;
 }
@@ -74,10 +74,72 @@ extern "C" {
 #define CLOCK_TICK              46
 #define CLOCK_SMILEY_FACE_SMILE 47
 #define CLOCK_SMILEY_FACE_SAD   48
-#define CLOCK_ALPHABET_LAST     CLOCK_SMILEY_FACE_SAD
+#define CLOCK_SMALL_A           49
+#define CLOCK_SMALL_B           50
+#define CLOCK_SMALL_C           51
+#define CLOCK_SMALL_D           52
+#define CLOCK_SMALL_E           53
+#define CLOCK_SMALL_F           54
+#define CLOCK_SMALL_G           55
+#define CLOCK_SMALL_H           56
+#define CLOCK_SMALL_I           57
+#define CLOCK_SMALL_J           58
+#define CLOCK_SMALL_K           59
+#define CLOCK_SMALL_L           60
+#define CLOCK_SMALL_M           61
+#define CLOCK_SMALL_N           62
+#define CLOCK_SMALL_O           63
+#define CLOCK_SMALL_P           64
+#define CLOCK_SMALL_Q           65
+#define CLOCK_SMALL_R           66
+#define CLOCK_SMALL_S           67
+#define CLOCK_SMALL_T           68
+#define CLOCK_SMALL_U           69
+#define CLOCK_SMALL_V           70
+#define CLOCK_SMALL_W           71
+#define CLOCK_SMALL_X           72
+#define CLOCK_SMALL_Y           73
+#define CLOCK_SMALL_Z           74
+#define CLOCK_COMMA             75
+#define CLOCK_SEMICOLON         76
+#define CLOCK_QUESTION_MARK     77
+#define CLOCK_EQUALS            78
+#define CLOCK_QUOTE             79
+#define CLOCK_HASH              80
+#define CLOCK_PERCENT           81
+#define CLOCK_LESS_THAN         82
+#define CLOCK_GREATER_THAN      83
+#define CLOCK_OPENING_BRACKET   84
+#define CLOCK_CLOSING_BRACKET   85
+#define CLOCK_UNDERSCORE        86
+#define CLOCK_ALPHABET_LAST     CLOCK_UNDERSCORE
 #define CLOCK_ALPHABET_SIZE     (CLOCK_ALPHABET_LAST + 1)
 
+//
+// The reference glyphs, row by row. They are not linked into AVR builds, the
+// library reads the packed alphabet below
+//
+#ifndef __AVR__
 extern const unsigned char ClockAlphabet[CLOCK_ALPHABET_SIZE][CLOCK_PATTERN_SIZE];
+#endif
+
+//
+// The packed alphabet, generated by tools/gen_frames into
+// lib/clock_alphabet_packed.c. Only the used columns of every glyph are kept,
+// column by column, bit (7 - y) is row y. ClockAlphabetExtents[i] is
+// (left << 4 | width) of glyph i and ClockAlphabetOffsets[b] is the offset of
+// the first glyph of block b of CLOCK_ALPHABET_BLOCK glyphs in ClockAlphabetColumns.
+// It takes about 3/4 of the program memory of the 8x8 glyphs.
+//
+// After changing ClockAlphabet run 'make frames' from the top directory.
+// ut_clock_alphabet fails while the packed alphabet is stale.
+//
+#define CLOCK_ALPHABET_BLOCK  8
+#define CLOCK_ALPHABET_BLOCKS ( (CLOCK_ALPHABET_SIZE + CLOCK_ALPHABET_BLOCK - 1) / CLOCK_ALPHABET_BLOCK )
+
+extern const unsigned char ClockAlphabetColumns[];
+extern const unsigned char ClockAlphabetExtents[CLOCK_ALPHABET_SIZE];
+extern const uint16_t      ClockAlphabetOffsets[CLOCK_ALPHABET_BLOCKS];
 
 //
 // @brief finds a suitable index from ClockAlphabet by a given character
@@ -85,7 +147,7 @@ extern const unsigned char ClockAlphabet[CLOCK_ALPHABET_SIZE][CLOCK_PATTERN_SIZE
 // @param clockAlphabetIndex a closest suitable index from ClockAlphabet for _ch_
 // @returns 0 on success
 // ERANGE if an exact match for _ch_ is not found (a closest pattern will be returned, i.e.
-//        if "a" is not found than an index to "A" will be returned. If a closest pattern can't be
+//        if "{" is not found than an index to "(" will be returned. If a closest pattern can't be
 //        identified, an index to blank patter will be returned in _clockAlphabetIndex_)
 //
 // EINVAL if _clockAlphabetIndex_ is NULL
@@ -95,6 +157,41 @@ extern const unsigned char ClockAlphabet[CLOCK_ALPHABET_SIZE][CLOCK_PATTERN_SIZE
 //
 int clock_alphabet_getIndexByCharacter(unsigned char ch, int *clockAlphabetIndex);
 
+//
+// @brief reads a glyph from the packed alphabet
+// @param index an index of the glyph [ index < CLOCK_ALPHABET_SIZE ]
+// @returns the glyph as a frame
+//
+// @warning _index_ is not checked for overflow
+//
+ClockFrame clock_alphabet_getGlyph(int index);
+
+//
+// @brief gets the used columns of a glyph from the packed alphabet
+// @param index an index of the glyph [ index < CLOCK_ALPHABET_SIZE ]
+// @param columns the first used column will be written here. It points
+//        to program memory on AVR, so it has to be read with romReadByte()
+// @param left the first used column of the 8x8 glyph will be written here
+// @param width the number of used columns will be written here. It is 0
+//        for a blank glyph
+//
+// @warning _index_ is not checked for overflow
+//
+void clock_alphabet_getGlyphColumns(int index, const unsigned char **columns, unsigned int *left, unsigned int *width);
+
+//
+// @brief computes which columns of a glyph are used by its bitmap
+// @param index an index of the glyph [ index < CLOCK_ALPHABET_SIZE ]
+// @param left the first used column will be written here
+// @param width the number of columns from _left_ to the last used column
+//        will be written here. It is 0 for a blank glyph
+// @returns 0 on success
+// EINVAL if _left_ is NULL
+//        if _width_ is NULL
+// ERANGE if _index_ is out of the alphabet
+//
+int clock_alphabet_getGlyphExtent(int index, unsigned int *left, unsigned int *width);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,73 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock packed alphabet
+//
+// @warning generated by tools/gen_frames, do not edit. Run 'make frames'
+//          from the top directory instead
+//
+
+#include "clock_alphabet.h"
+
+const unsigned char ClockAlphabetColumns[401] ROM_DATA = {
+    0x7c, 0x8a, 0x92, 0xa2, 0x7c, 0x20, 0x40, 0xfe, 0x42, 0x86, 0x8a, 0x92,
+    0x62, 0x44, 0x82, 0x92, 0x92, 0x6c, 0xe0, 0x10, 0x10, 0x10, 0xfe, 0xe4,
+    0xa2, 0xa2, 0xa2, 0x9c, 0x7c, 0x92, 0x92, 0x92, 0x0c, 0x80, 0x80, 0x8e,
+    0x90, 0xe0, 0x6c, 0x92, 0x92, 0x92, 0x6c, 0x60, 0x92, 0x92, 0x92, 0x7c,
+    0x3e, 0x48, 0x88, 0x48, 0x3e, 0xfe, 0x92, 0x92, 0x72, 0x0e, 0x7c, 0x82,
+    0x82, 0x82, 0x44, 0xfe, 0x82, 0x82, 0x44, 0x38, 0xfe, 0x92, 0x92, 0x92,
+    0x82, 0xfe, 0x90, 0x90, 0x90, 0x80, 0x7c, 0x82, 0x82, 0x8a, 0xcc, 0xfe,
+    0x10, 0x10, 0x10, 0xfe, 0x82, 0xfe, 0x82, 0x04, 0x02, 0x82, 0xfc, 0xfe,
+    0x10, 0x28, 0x44, 0x82, 0xfe, 0x02, 0x02, 0x02, 0x02, 0xfe, 0x40, 0x20,
+    0x40, 0xfe, 0xfe, 0x60, 0x10, 0x0c, 0xfe, 0x7c, 0x82, 0x82, 0x82, 0x7c,
+    0xfe, 0x90, 0x90, 0x90, 0x60, 0x7c, 0x82, 0x8e, 0x82, 0x7c, 0xfe, 0x98,
+    0x94, 0x92, 0x62, 0x64, 0x92, 0x92, 0x92, 0x4c, 0x80, 0x80, 0xfe, 0x80,
+    0x80, 0xfc, 0x02, 0x02, 0x02, 0xfc, 0xf8, 0x04, 0x02, 0x04, 0xf8, 0xfc,
+    0x02, 0x1c, 0x02, 0xfc, 0xc6, 0x28, 0x10, 0x28, 0xc6, 0xe0, 0x10, 0x0e,
+    0x10, 0xe0, 0x86, 0x8a, 0x92, 0xa2, 0xc2, 0x10, 0x10, 0x7c, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x44, 0x28, 0x10, 0x28, 0x44, 0x02,
+    0x04, 0x08, 0x10, 0x20, 0x40, 0x66, 0x66, 0x06, 0x06, 0xf6, 0xf6, 0x38,
+    0x44, 0x82, 0x82, 0x44, 0x38, 0xd0, 0xe0, 0x3c, 0x42, 0xa9, 0x85, 0x85,
+    0xa9, 0x42, 0x3c, 0x3c, 0x42, 0xa5, 0x89, 0x89, 0xa5, 0x42, 0x3c, 0x04,
+    0x2a, 0x2a, 0x2a, 0x1e, 0xfe, 0x12, 0x22, 0x22, 0x1c, 0x1c, 0x22, 0x22,
+    0x22, 0x04, 0x1c, 0x22, 0x22, 0x12, 0xfe, 0x1c, 0x2a, 0x2a, 0x2a, 0x18,
+    0x10, 0x7e, 0x90, 0x80, 0x40, 0x18, 0x25, 0x25, 0x25, 0x3e, 0xfe, 0x10,
+    0x20, 0x20, 0x1e, 0x22, 0xbe, 0x02, 0x04, 0x02, 0x22, 0xbc, 0xfe, 0x08,
+    0x14, 0x22, 0x82, 0xfe, 0x02, 0x3e, 0x20, 0x18, 0x20, 0x1e, 0x3e, 0x10,
+    0x20, 0x20, 0x1e, 0x1c, 0x22, 0x22, 0x22, 0x1c, 0x3f, 0x24, 0x24, 0x24,
+    0x18, 0x18, 0x24, 0x24, 0x24, 0x3f, 0x3e, 0x10, 0x20, 0x20, 0x10, 0x12,
+    0x2a, 0x2a, 0x2a, 0x24, 0x20, 0xfc, 0x22, 0x02, 0x04, 0x3c, 0x02, 0x02,
+    0x04, 0x3e, 0x38, 0x04, 0x02, 0x04, 0x38, 0x3c, 0x02, 0x0c, 0x02, 0x3c,
+    0x22, 0x14, 0x08, 0x14, 0x22, 0x38, 0x05, 0x05, 0x05, 0x3e, 0x22, 0x26,
+    0x2a, 0x32, 0x22, 0x0d, 0x0e, 0x6d, 0x6e, 0x40, 0x80, 0x8a, 0x90, 0x60,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0xd0, 0xe0, 0x00, 0xd0, 0xe0, 0x28,
+    0xfe, 0x28, 0xfe, 0x28, 0xc6, 0xc8, 0x10, 0x26, 0xc6, 0x10, 0x28, 0x44,
+    0x82, 0x82, 0x44, 0x28, 0x10, 0xfe, 0x82, 0x82, 0x82, 0x82, 0xfe, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01,
+};
+
+const unsigned char ClockAlphabetExtents[CLOCK_ALPHABET_SIZE] ROM_DATA = {
+    0x00, 0x15, 0x23, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+    0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x23, 0x24, 0x15, 0x15, 0x15,
+    0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+    0x15, 0x15, 0x16, 0x15, 0x16, 0x32, 0x32, 0x32, 0x23, 0x23, 0x32, 0x08,
+    0x08, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x23, 0x14, 0x14,
+    0x23, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+    0x15, 0x15, 0x15, 0x32, 0x32, 0x15, 0x16, 0x15, 0x15, 0x15, 0x14, 0x24,
+    0x23, 0x23, 0x16,
+};
+
+const uint16_t ClockAlphabetOffsets[CLOCK_ALPHABET_BLOCKS] ROM_DATA = {
+    0, 33, 73, 110, 150, 191, 219, 262, 296, 336, 371,
+};
@@ -0,0 +1,495 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock batch renderer
+//
+
+#include <errno.h>
+
+#ifdef PARAM_CHECKS
+#include <logger.h>
+#endif
+
+#include <string.h>
+
+#include "clock_batch.h"
+#include "clock_state.h" // for MIN_YEAR
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <immintrin.h>
+#define BATCH_HAS_SSE2
+#if defined(__x86_64__) || defined(__i386__)
+#define BATCH_HAS_AVX2
+#define BATCH_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+//
+// Byte y has only bit (CLOCK_SCREEN_HEIGHT - y - 1) set. A number replicated
+// to every row and masked with it keeps in row y the bit which lights that
+// row of a binary bar, see binaryBar() in clock.c
+//
+#define ROW_BITS 0x0102040810204080ULL
+
+#define BYTES_LOW_7 0x7f7f7f7f7f7f7f7fULL
+#define BYTES_BIT_0 0x0101010101010101ULL
+
+//
+// @brief a mask of _width_ columns starting from _pos_ in every row
+//
+#define barColumns(pos) \
+    clock_frame_replicateRow(((1U << DATE_TIME_BINARY_WIDTH) - 1) << (CLOCK_SCREEN_WIDTH - (pos) - DATE_TIME_BINARY_WIDTH))
+
+//
+// A clock face is three binary bars. The value of bar i is the int at
+// _offsets[i]_ of a DateTime plus _addends[i]_
+//
+typedef struct {
+    size_t offsets[3];
+    int    addends[3];
+} ClockFace;
+
+static const ClockFace TimeFace = {
+    { offsetof(DateTime, hour), offsetof(DateTime, minute), offsetof(DateTime, second) },
+    { 0, 0, 0 }
+};
+
+static const ClockFace DateFace = {
+    { offsetof(DateTime, month), offsetof(DateTime, day), offsetof(DateTime, year) },
+    { 1, 0, -MIN_YEAR }
+};
+
+static const ClockFrame BarColumns[3] = {
+    barColumns(DATE_TIME_BAR_1_POS), barColumns(DATE_TIME_BAR_2_POS), barColumns(DATE_TIME_BAR_3_POS)
+};
+
+static unsigned int Path = CLOCK_BATCH_AUTO;
+
+#define faceValue(face, dt, i) \
+    ( *(const int *)((const char *)(dt) + (face)->offsets[i]) + (face)->addends[i] )
+
+//
+// @brief a binary bar of _number_ in _columns_. It is the same as
+//        BinaryBars[number] & columns in clock.c, but without the table
+//
+static ClockFrame _bar(unsigned int number, ClockFrame columns)
+{
+    //
+    // A row byte of _bits_ is either 0 or a single bit, so adding 0x7f carries
+    // it into bit 7 without touching the next byte
+    //
+    const ClockFrame bits = clock_frame_replicateRow(number) & ROW_BITS;
+    const ClockFrame lit  = ((bits + BYTES_LOW_7) >> 7) & BYTES_BIT_0;
+
+    return (lit * 0xff) & columns;
+}
+
+static void _renderFacesScalar(const ClockFace *face, const DateTime *dts, size_t count, ClockFrame *frames)
+{
+    for(size_t i = 0; i < count; ++i) {
+        frames[i] = _bar(faceValue(face, &dts[i], 0), BarColumns[0])
+                  | _bar(faceValue(face, &dts[i], 1), BarColumns[1])
+                  | _bar(faceValue(face, &dts[i], 2), BarColumns[2]);
+    }
+}
+
+//
+// @brief the frame of _step_ of a strip. The columns beyond the end of
+//        the strip are blank
+//
+static ClockFrame _window(const ClockText *strip, size_t step)
+{
+    if(step + CLOCK_SCREEN_WIDTH <= strip->size) {
+        return clock_frame_transpose(clock_frame_fromPattern(strip->columns + step));
+    }
+
+    unsigned char columns[CLOCK_SCREEN_WIDTH] = { 0 };
+    if(step < strip->size) {
+        memcpy(columns, strip->columns + step, strip->size - step);
+    }
+
+    return clock_frame_transpose(clock_frame_fromPattern(columns));
+}
+
+//
+// Step (s + k) of a strip is step s shifted k columns left with step (s + 8)
+// coming in from the right, so the transposes are done once per 8 steps and
+// the steps in between are independent of each other
+//
+static void _slideTextScalar(const ClockText *strip, size_t firstStep, size_t count, ClockFrame *frames)
+{
+    ClockFrame right = _window(strip, firstStep);
+
+    for(size_t i = 0; i < count; i += CLOCK_SCREEN_WIDTH) {
+        const ClockFrame left = right;
+        const size_t     last = count - i < CLOCK_SCREEN_WIDTH ? count - i : CLOCK_SCREEN_WIDTH;
+
+        right = _window(strip, firstStep + i + CLOCK_SCREEN_WIDTH);
+
+        for(size_t k = 0; k < last; ++k) {
+            frames[i + k] = clock_frame_shiftLeft(left, k, 0) | clock_frame_shiftRight(right, CLOCK_SCREEN_WIDTH - k, 0);
+        }
+    }
+}
+
+#ifdef BATCH_HAS_SSE2
+
+//
+// @brief renders 2 frames per iteration. Every row byte of a value is compared
+//        with its row bit, which gives 0xff for the lit rows of a bar
+//
+static void _renderFacesSse2(const ClockFace *face, const DateTime *dts, size_t count, ClockFrame *frames)
+{
+    const __m128i rowBits = _mm_set1_epi64x((long long)ROW_BITS);
+    const __m128i columns[3] = {
+        _mm_set1_epi64x((long long)BarColumns[0]),
+        _mm_set1_epi64x((long long)BarColumns[1]),
+        _mm_set1_epi64x((long long)BarColumns[2])
+    };
+    size_t i = 0;
+
+    for(; i + 2 <= count; i += 2) {
+        __m128i result = _mm_setzero_si128();
+
+        for(size_t bar = 0; bar < 3; ++bar) {
+            const __m128i values = _mm_unpacklo_epi64(
+                    _mm_set1_epi8((char)faceValue(face, &dts[i], bar)),
+                    _mm_set1_epi8((char)faceValue(face, &dts[i + 1], bar)));
+            const __m128i lit = _mm_cmpeq_epi8(_mm_and_si128(values, rowBits), rowBits);
+
+            result = _mm_or_si128(result, _mm_and_si128(lit, columns[bar]));
+        }
+
+        _mm_storeu_si128((__m128i *)&frames[i], result);
+    }
+
+    _renderFacesScalar(face, dts + i, count - i, frames + i);
+}
+
+//
+// @brief renders 16 steps per iteration. The lanes are steps (s + k) and
+//        (s + 8 + k), which are shifted by the same number of columns
+//
+static void _slideTextSse2(const ClockText *strip, size_t firstStep, size_t count, ClockFrame *frames)
+{
+    ClockFrame left = _window(strip, firstStep);
+    size_t i = 0;
+
+    for(; i + 2 * CLOCK_SCREEN_WIDTH <= count; i += 2 * CLOCK_SCREEN_WIDTH) {
+        const ClockFrame middle = _window(strip, firstStep + i + CLOCK_SCREEN_WIDTH);
+        const ClockFrame right  = _window(strip, firstStep + i + 2 * CLOCK_SCREEN_WIDTH);
+        const __m128i    lefts  = _mm_set_epi64x((long long)middle, (long long)left);
+        const __m128i    rights = _mm_set_epi64x((long long)right, (long long)middle);
+
+        for(unsigned int k = 0; k < CLOCK_SCREEN_WIDTH; ++k) {
+            const __m128i leftMask  = _mm_set1_epi8((char)(0xffU << k));
+            const __m128i rightMask = _mm_set1_epi8((char)(0xffU >> (CLOCK_SCREEN_WIDTH - k)));
+            const __m128i result    = _mm_or_si128(
+                    _mm_and_si128(_mm_sll_epi64(lefts, _mm_cvtsi32_si128(k)), leftMask),
+                    _mm_and_si128(_mm_srl_epi64(rights, _mm_cvtsi32_si128(CLOCK_SCREEN_WIDTH - k)), rightMask));
+
+            _mm_storel_epi64((__m128i *)&frames[i + k], result);
+            _mm_storel_epi64((__m128i *)&frames[i + CLOCK_SCREEN_WIDTH + k], _mm_unpackhi_epi64(result, result));
+        }
+
+        left = right;
+    }
+
+    if(i < count) {
+        _slideTextScalar(strip, firstStep + i, count - i, frames + i);
+    }
+}
+
+#endif // BATCH_HAS_SSE2
+
+#ifdef BATCH_HAS_AVX2
+
+//
+// @brief spreads the low byte of every 32 bit lane of _values_ to the row
+//        bytes of a frame. The result holds the frames of lanes 0..3 if
+//        _isHigh_ is 0 or of lanes 4..7 otherwise
+//
+BATCH_AVX2
+static __m256i _spreadAvx2(__m256i values, int isHigh)
+{
+    const __m256i low   = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i high  = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+    const __m256i bytes = _mm256_setr_epi8(
+            0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8,
+            0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8);
+
+    return _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(values, isHigh ? high : low), bytes);
+}
+
+//
+// @brief renders 8 frames per iteration. The values of 8 DateTimes are
+//        gathered at once, then every half of them is spread to 4 frames
+//
+BATCH_AVX2
+static void _renderFacesAvx2(const ClockFace *face, const DateTime *dts, size_t count, ClockFrame *frames)
+{
+    const int     stride  = (int)sizeof(DateTime);
+    const __m256i offsets = _mm256_setr_epi32(0, stride, 2 * stride, 3 * stride, 4 * stride, 5 * stride, 6 * stride, 7 * stride);
+    const __m256i rowBits = _mm256_set1_epi64x((long long)ROW_BITS);
+    size_t i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m256i low  = _mm256_setzero_si256();
+        __m256i high = _mm256_setzero_si256();
+
+        for(size_t bar = 0; bar < 3; ++bar) {
+            const __m256i columns = _mm256_set1_epi64x((long long)BarColumns[bar]);
+            const int *base = (const int *)((const char *)&dts[i] + face->offsets[bar]);
+            const __m256i values = _mm256_add_epi32(
+                    _mm256_i32gather_epi32(base, offsets, 1), _mm256_set1_epi32(face->addends[bar]));
+
+            const __m256i lowBits  = _mm256_and_si256(_spreadAvx2(values, 0), rowBits);
+            const __m256i highBits = _mm256_and_si256(_spreadAvx2(values, 1), rowBits);
+
+            low  = _mm256_or_si256(low,  _mm256_and_si256(_mm256_cmpeq_epi8(lowBits, rowBits), columns));
+            high = _mm256_or_si256(high, _mm256_and_si256(_mm256_cmpeq_epi8(highBits, rowBits), columns));
+        }
+
+        _mm256_storeu_si256((__m256i *)&frames[i], low);
+        _mm256_storeu_si256((__m256i *)&frames[i + 4], high);
+    }
+
+    _renderFacesScalar(face, dts + i, count - i, frames + i);
+}
+
+//
+// @brief renders 8 steps per iteration. Every lane is shifted by its own
+//        number of columns
+//
+BATCH_AVX2
+static void _slideTextAvx2(const ClockText *strip, size_t firstStep, size_t count, ClockFrame *frames)
+{
+    const __m256i leftShifts[2]  = { _mm256_setr_epi64x(0, 1, 2, 3), _mm256_setr_epi64x(4, 5, 6, 7) };
+    const __m256i rightShifts[2] = { _mm256_setr_epi64x(8, 7, 6, 5), _mm256_setr_epi64x(4, 3, 2, 1) };
+    __m256i leftMasks[2];
+    __m256i rightMasks[2];
+
+    for(unsigned int half = 0; half < 2; ++half) {
+        const unsigned int k = half * 4;
+
+        leftMasks[half] = _mm256_setr_epi64x(
+                (long long)clock_frame_replicateRow(0xffU << k),       (long long)clock_frame_replicateRow(0xffU << (k + 1)),
+                (long long)clock_frame_replicateRow(0xffU << (k + 2)), (long long)clock_frame_replicateRow(0xffU << (k + 3)));
+        rightMasks[half] = _mm256_setr_epi64x(
+                (long long)clock_frame_replicateRow(0xffU >> (8 - k)), (long long)clock_frame_replicateRow(0xffU >> (7 - k)),
+                (long long)clock_frame_replicateRow(0xffU >> (6 - k)), (long long)clock_frame_replicateRow(0xffU >> (5 - k)));
+    }
+
+    ClockFrame left = _window(strip, firstStep);
+    size_t i = 0;
+
+    for(; i + CLOCK_SCREEN_WIDTH <= count; i += CLOCK_SCREEN_WIDTH) {
+        const ClockFrame right  = _window(strip, firstStep + i + CLOCK_SCREEN_WIDTH);
+        const __m256i    lefts  = _mm256_set1_epi64x((long long)left);
+        const __m256i    rights = _mm256_set1_epi64x((long long)right);
+
+        for(unsigned int half = 0; half < 2; ++half) {
+            const __m256i result = _mm256_or_si256(
+                    _mm256_and_si256(_mm256_sllv_epi64(lefts, leftShifts[half]), leftMasks[half]),
+                    _mm256_and_si256(_mm256_srlv_epi64(rights, rightShifts[half]), rightMasks[half]));
+
+            _mm256_storeu_si256((__m256i *)&frames[i + half * 4], result);
+        }
+
+        left = right;
+    }
+
+    if(i < count) {
+        _slideTextScalar(strip, firstStep + i, count - i, frames + i);
+    }
+}
+
+#endif // BATCH_HAS_AVX2
+
+static int _renderFaces(const ClockFace *face, const DateTime *dts, size_t count, ClockFrame *frames)
+{
+    NullCheck(dts);
+    NullCheck(frames);
+
+    switch(clock_batch_getPath()) {
+#ifdef BATCH_HAS_AVX2
+        case CLOCK_BATCH_AVX2:
+            _renderFacesAvx2(face, dts, count, frames);
+            break;
+#endif
+#ifdef BATCH_HAS_SSE2
+        case CLOCK_BATCH_SSE2:
+            _renderFacesSse2(face, dts, count, frames);
+            break;
+#endif
+        default:
+            _renderFacesScalar(face, dts, count, frames);
+    }
+
+    return 0;
+}
+
+//
+// @brief tells if a path can be used on this machine
+// @param path one of CLOCK_BATCH_*
+// @returns TRUE if the path is compiled in and the CPU supports it
+//
+Bool clock_batch_isSupported(unsigned int path)
+{
+    switch(path) {
+        case CLOCK_BATCH_AUTO:
+        case CLOCK_BATCH_SCALAR:
+            return TRUE;
+
+#ifdef BATCH_HAS_SSE2
+        case CLOCK_BATCH_SSE2:
+            return TRUE;
+#endif
+
+#ifdef BATCH_HAS_AVX2
+        case CLOCK_BATCH_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? TRUE : FALSE;
+#endif
+
+        default:
+            return FALSE;
+    }
+}
+
+//
+// @brief chooses the path for all the following batch calls
+// @param path one of CLOCK_BATCH_*
+// @returns 0 on success
+// EINVAL  - if _path_ is unknown
+// ENOTSUP - if _path_ is not supported on this machine
+//
+int clock_batch_setPath(unsigned int path)
+{
+#ifdef PARAM_CHECKS
+    if(path >= CLOCK_BATCH_PATH_COUNT)
+        OriginateErrorEx(EINVAL, "%d", "batch path[%u] is unknown", path);
+#endif
+
+    if(!clock_batch_isSupported(path)) {
+        return ENOTSUP;
+    }
+
+    Path = path;
+
+    return 0;
+}
+
+//
+// @brief gets the path which the batch calls use. CLOCK_BATCH_AUTO is
+//        resolved to the actual path
+//
+unsigned int clock_batch_getPath(void)
+{
+    if(Path == CLOCK_BATCH_AUTO) {
+        Path = CLOCK_BATCH_SCALAR;
+
+        for(unsigned int path = CLOCK_BATCH_PATH_COUNT - 1; path > CLOCK_BATCH_SCALAR; --path) {
+            if(clock_batch_isSupported(path)) {
+                Path = path;
+                break;
+            }
+        }
+    }
+
+    return Path;
+}
+
+//
+// @brief renders the time faces of _count_ DateTimes. frames[i] is what
+//        clock_displayTime(&dts[i]) draws on a blank screen
+// @param dts
+// @param count
+// @param frames the result will be written here. It should fit _count_ frames
+// @returns 0 on success
+// EINVAL - if _dts_ is NULL
+//          if _frames_ is NULL
+//
+int clock_batch_renderTime(const DateTime *dts, size_t count, ClockFrame *frames)
+{
+    Call(_renderFaces(&TimeFace, dts, count, frames));
+
+    return 0;
+}
+
+//
+// @brief renders the date faces of _count_ DateTimes. frames[i] is what
+//        clock_displayDate(&dts[i]) draws on a blank screen
+// @see clock_batch_renderTime() for the parameters description
+//
+int clock_batch_renderDate(const DateTime *dts, size_t count, ClockFrame *frames)
+{
+    Call(_renderFaces(&DateFace, dts, count, frames));
+
+    return 0;
+}
+
+//
+// @brief renders _count_ consecutive steps of a sliding text.
+//        frames[i] is what clock_text_window() gives for step (firstStep + i)
+// @param strip a strip prepared with clock_text_prepare() or clock_text_prepareProportional()
+// @param firstStep the step of frames[0]
+// @param count
+// @param frames the result will be written here. It should fit _count_ frames
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _frames_ is NULL
+//          if (firstStep + count - 1) is beyond the last step of the strip
+//
+int clock_batch_slideText(const ClockText *strip, size_t firstStep, size_t count, ClockFrame *frames)
+{
+    NullCheck(strip);
+    NullCheck(frames);
+
+    if(count == 0) {
+        return 0;
+    }
+
+    const size_t steps = strip->size < CLOCK_SCREEN_WIDTH ? 0 : strip->size - CLOCK_SCREEN_WIDTH + 1;
+
+#ifdef PARAM_CHECKS
+    if(firstStep >= steps || count > steps - firstStep)
+        OriginateErrorEx(EINVAL, "%d", "steps [%zu, %zu] should be < %zu for a strip of %zu columns",
+                                       firstStep, firstStep + count - 1, steps, strip->size);
+#else
+    if(firstStep >= steps) {
+        return 0;
+    }
+    if(count > steps - firstStep) {
+        count = steps - firstStep;
+    }
+#endif
+
+    switch(clock_batch_getPath()) {
+#ifdef BATCH_HAS_AVX2
+        case CLOCK_BATCH_AVX2:
+            _slideTextAvx2(strip, firstStep, count, frames);
+            break;
+#endif
+#ifdef BATCH_HAS_SSE2
+        case CLOCK_BATCH_SSE2:
+            _slideTextSse2(strip, firstStep, count, frames);
+            break;
+#endif
+        default:
+            _slideTextScalar(strip, firstStep, count, frames);
+    }
+
+    return 0;
+}
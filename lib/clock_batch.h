@@ -0,0 +1,107 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock batch renderer. It renders the clock faces of many
+//        DateTimes and many steps of a sliding text into packed frames at
+//        once, without going through the screen callbacks. Every frame is
+//        bit for bit the same as the library draws on a blank screen.
+//
+//        There is a portable scalar path and, on x86, an SSE2 path, which
+//        renders 2 frames per instruction, and an AVX2 path, which renders
+//        4 frames per instruction.
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_BATCH_H
+#define BINARY_CLOCK_LIB_CLOCK_BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock.h"
+#include "clock_text.h"
+
+//
+// CLOCK_BATCH_AUTO   - the fastest path which the CPU supports (default)
+// CLOCK_BATCH_SCALAR - plain 64 bit word operations, available everywhere
+// CLOCK_BATCH_SSE2   - 128 bit vectors, 2 frames at once
+// CLOCK_BATCH_AVX2   - 256 bit vectors, 4 frames at once
+//
+#define CLOCK_BATCH_AUTO    0U
+#define CLOCK_BATCH_SCALAR  1U
+#define CLOCK_BATCH_SSE2    2U
+#define CLOCK_BATCH_AVX2    3U
+
+#define CLOCK_BATCH_PATH_COUNT 4U
+
+//
+// @brief tells if a path can be used on this machine
+// @param path one of CLOCK_BATCH_*
+// @returns TRUE if the path is compiled in and the CPU supports it
+//
+Bool clock_batch_isSupported(unsigned int path);
+
+//
+// @brief chooses the path for all the following batch calls
+// @param path one of CLOCK_BATCH_*
+// @returns 0 on success
+// EINVAL  - if _path_ is unknown
+// ENOTSUP - if _path_ is not supported on this machine
+//
+int clock_batch_setPath(unsigned int path);
+
+//
+// @brief gets the path which the batch calls use. CLOCK_BATCH_AUTO is
+//        resolved to the actual path
+//
+unsigned int clock_batch_getPath(void);
+
+//
+// @brief renders the time faces of _count_ DateTimes. frames[i] is what
+//        clock_displayTime(&dts[i]) draws on a blank screen
+// @param dts
+// @param count
+// @param frames the result will be written here. It should fit _count_ frames
+// @returns 0 on success
+// EINVAL - if _dts_ is NULL
+//          if _frames_ is NULL
+//
+int clock_batch_renderTime(const DateTime *dts, size_t count, ClockFrame *frames);
+
+//
+// @brief renders the date faces of _count_ DateTimes. frames[i] is what
+//        clock_displayDate(&dts[i]) draws on a blank screen
+// @see clock_batch_renderTime() for the parameters description
+//
+int clock_batch_renderDate(const DateTime *dts, size_t count, ClockFrame *frames);
+
+//
+// @brief renders _count_ consecutive steps of a sliding text.
+//        frames[i] is what clock_text_window() gives for step (firstStep + i)
+// @param strip a strip prepared with clock_text_prepare() or clock_text_prepareProportional()
+// @param firstStep the step of frames[0]
+// @param count
+// @param frames the result will be written here. It should fit _count_ frames
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _frames_ is NULL
+//          if (firstStep + count - 1) is beyond the last step of the strip
+//
+int clock_batch_slideText(const ClockText *strip, size_t firstStep, size_t count, ClockFrame *frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,122 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock frame buffer
+//
+
+#ifdef PARAM_CHECKS
+#include <errno.h>
+
+#include <logger.h>
+#endif
+
+#include <string.h>
+
+#include "clock_buffer.h"
+
+//
+// The middle index has this bit set when it holds a frame which
+// the reader hasn't taken yet
+//
+#define FRESH       0x80U
+#define INDEX_MASK  0x03U
+
+//
+// @brief stores _value_ to _*index_ and returns the old value as one
+//        atomic operation. On AVR the reader is an interrupt, so it is
+//        enough to keep the interrupts off
+//
+#ifdef __AVR__
+#include <util/atomic.h>
+
+static unsigned char _exchange(volatile unsigned char *index, unsigned char value)
+{
+    unsigned char old;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        old    = *index;
+        *index = value;
+    }
+
+    return old;
+}
+
+#define _load(index) ( *(index) )
+#else
+#define _exchange(index, value) __atomic_exchange_n(index, value, __ATOMIC_ACQ_REL)
+#define _load(index)            __atomic_load_n(index, __ATOMIC_ACQUIRE)
+#endif
+
+//
+// @brief initializes a buffer with three blank frames
+// @returns 0 on success
+// EINVAL - if _buffer_ is NULL
+//
+int clock_buffer_init(ClockBuffer *buffer)
+{
+    NullCheck(buffer);
+
+    memset(buffer, 0, sizeof(ClockBuffer));
+    buffer->back   = 0;
+    buffer->middle = 1;
+    buffer->front  = 2;
+
+    return 0;
+}
+
+//
+// @brief publishes a complete frame. The reader gets it on its next
+//        clock_buffer_read(). Call it from the writer only
+// @returns 0 on success
+// EINVAL - if _buffer_ is NULL
+//
+int clock_buffer_publish(ClockBuffer *buffer, ClockFrame frame)
+{
+    NullCheck(buffer);
+
+    buffer->frames[buffer->back] = frame;
+    buffer->back = _exchange(&buffer->middle, (unsigned char)(buffer->back | FRESH)) & INDEX_MASK;
+
+    return 0;
+}
+
+//
+// @brief reads the latest published frame. Call it from the reader only
+// @param buffer
+// @param frame the frame will be written here
+// @param isNew is an output variable which is set to TRUE if a frame was
+//        published since the last read. May be NULL
+// @returns 0 on success
+// EINVAL - if _buffer_ is NULL
+//          if _frame_ is NULL
+//
+int clock_buffer_read(ClockBuffer *buffer, ClockFrame *frame, Bool *isNew)
+{
+    NullCheck(buffer);
+    NullCheck(frame);
+
+    const Bool isFresh = (_load(&buffer->middle) & FRESH) ? TRUE : FALSE;
+
+    if(isFresh) {
+        buffer->front = _exchange(&buffer->middle, buffer->front) & INDEX_MASK;
+    }
+
+    *frame = buffer->frames[buffer->front];
+
+    if(isNew != NULL) {
+        *isNew = isFresh;
+    }
+
+    return 0;
+}
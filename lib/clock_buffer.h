@@ -0,0 +1,79 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock frame buffer. It hands complete frames over from the
+//        code which renders them to a display refresh, which runs on its own
+//        cadence in another thread or in an interrupt. There are three
+//        frames: the back one is written by the renderer, the front one is
+//        read by the refresh and the middle one is swapped between them with
+//        a single atomic exchange. Neither side ever waits for the other one
+//        and the refresh never sees a frame half written.
+//
+// @note there should be exactly one writer and one reader
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_BUFFER_H
+#define BINARY_CLOCK_LIB_CLOCK_BUFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock.h"
+
+typedef struct {
+    ClockFrame             frames[3];
+    unsigned char          back;    // owned by the writer
+    unsigned char          front;   // owned by the reader
+    volatile unsigned char middle;  // the index of the middle frame, exchanged atomically
+} ClockBuffer;
+
+//
+// A static initializer, which is the same as clock_buffer_init()
+//
+#define CLOCK_BUFFER_INITIALIZER \
+    { { CLOCK_FRAME_BLANK, CLOCK_FRAME_BLANK, CLOCK_FRAME_BLANK }, 0, 2, 1 }
+
+//
+// @brief initializes a buffer with three blank frames
+// @returns 0 on success
+// EINVAL - if _buffer_ is NULL
+//
+int clock_buffer_init(ClockBuffer *buffer);
+
+//
+// @brief publishes a complete frame. The reader gets it on its next
+//        clock_buffer_read(). Call it from the writer only
+// @returns 0 on success
+// EINVAL - if _buffer_ is NULL
+//
+int clock_buffer_publish(ClockBuffer *buffer, ClockFrame frame);
+
+//
+// @brief reads the latest published frame. Call it from the reader only
+// @param buffer
+// @param frame the frame will be written here
+// @param isNew is an output variable which is set to TRUE if a frame was
+//        published since the last read. May be NULL
+// @returns 0 on success
+// EINVAL - if _buffer_ is NULL
+//          if _frame_ is NULL
+//
+int clock_buffer_read(ClockBuffer *buffer, ClockFrame *frame, Bool *isNew);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,89 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock frame cache
+//
+
+#ifdef PARAM_CHECKS
+#include <errno.h>
+
+#include <logger.h>
+#endif
+
+#include "clock_cache.h"
+
+//
+// @brief looks a packed text up in the cache
+// @param entries
+// @param size the number of _entries_
+// @param packed
+// @param entry the entry of _packed_ will be written here or NULL if the text is not cached
+// @returns 0 on success
+// EINVAL - if _entries_ is NULL and _size_ is not 0
+//          if _packed_ is NULL
+//          if _entry_ is NULL
+//
+int clock_cache_find(const ClockCacheEntry *entries, size_t size, const unsigned char *packed, const ClockCacheEntry **entry)
+{
+    NullCheck(packed);
+    NullCheck(entry);
+    if(size) {
+        NullCheck(entries);
+    }
+
+    *entry = NULL;
+
+    for(size_t i = 0; i < size; ++i) {
+        if(entries[i].packed == packed) {
+            *entry = &entries[i];
+            break;
+        }
+    }
+
+    return 0;
+}
+
+//
+// @brief gets the frame of a step of a cached text
+// @param entry
+// @param step indicates current iteration [ step < entry->count ]
+// @param isLastStep is an output variable which if set to non zero value indicates the last iteration
+// @param frame the result will be written here
+// @returns 0 on success
+// EINVAL - if _entry_ is NULL
+//          if _isLastStep_ is NULL
+//          if _frame_ is NULL
+//          if _step_ is out of range
+//
+int clock_cache_getFrame(const ClockCacheEntry *entry, size_t step, Bool *isLastStep, ClockFrame *frame)
+{
+    NullCheck(entry);
+    NullCheck(isLastStep);
+    NullCheck(frame);
+
+#ifdef PARAM_CHECKS
+    if(step >= entry->count)
+        OriginateErrorEx(EINVAL, "%d", "step[%zu] should be < %zu", step, entry->count);
+#else
+    if(step >= entry->count) {
+        *isLastStep = TRUE;
+        return 0;
+    }
+#endif
+
+    *isLastStep = step + 1 == entry->count;
+    *frame = romReadQword(&entry->frames[step]);
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock frame cache. A cache entry keeps the frames of every
+//        step of a sliding text, so that sliding it is a single table read
+//        per step. The frames of the constant messages are generated at
+//        build time into ROM_DATA tables (see lib/clock_messages.c).
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_CACHE_H
+#define BINARY_CLOCK_LIB_CLOCK_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock.h"
+
+typedef struct {
+    const unsigned char *packed;  // the packed text which frames are cached, a ROM_DATA table
+    const ClockFrame    *frames;  // one frame per step, a ROM_DATA table
+    size_t               count;   // the number of steps
+} ClockCacheEntry;
+
+//
+// @brief looks a packed text up in the cache. Constant texts are cached, so
+//        they are found by their address
+// @param entries
+// @param size the number of _entries_
+// @param packed a packed text (see clock_packed.h)
+// @param entry the entry of _packed_ will be written here or NULL if the text is not cached
+// @returns 0 on success
+// EINVAL - if _entries_ is NULL and _size_ is not 0
+//          if _packed_ is NULL
+//          if _entry_ is NULL
+//
+int clock_cache_find(const ClockCacheEntry *entries, size_t size, const unsigned char *packed, const ClockCacheEntry **entry);
+
+//
+// @brief gets the frame of a step of a cached text. It slides the same way as
+//        clock_text_window() over a strip prepared with clock_text_prepareProportional()
+//        with CLOCK_TEXT_DEFAULT_SPACING
+// @param entry
+// @param step indicates current iteration [ step < entry->count ]
+// @param isLastStep is an output variable which if set to non zero value indicates the last iteration
+// @param frame the result will be written here
+// @returns 0 on success
+// EINVAL - if _entry_ is NULL
+//          if _isLastStep_ is NULL
+//          if _frame_ is NULL
+//          if _step_ is out of range
+//
+int clock_cache_getFrame(const ClockCacheEntry *entry, size_t step, Bool *isLastStep, ClockFrame *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -25,7 +25,6 @@
 #endif
 
 #include <string.h>
-#include <stdlib.h> // for qsort()
 
 #include "clock_event.h"
 
@@ -84,25 +83,185 @@ static void intToString(int n, char *str)
 }
 
 //
-// @brief qsort() comparator for ClockEvent
+// @brief gets a key of the date of an event, which orders events
+//        by month and then by day of month
 //
-static int _clock_event_compare(const void *l, const void *r)
+#define _dateKey(event) ( (unsigned int)clock_event_getMonth(event) << 5 | clock_event_getDayOfMonth(event) )
+
+//
+// @brief sorts positions [ from, to ) of the order of _list_ into the
+//        sorted positions [ 0, from )
+//
+// @note an insertion sort. Events move in the order only as far as their
+//       dates have moved, so this costs a pass plus those moves
+//
+static void _sortOrder(ClockEventList *list, size_t from, size_t to)
+{
+    ClockEventIndex *order = list->order;
+
+    for(size_t i = (from ? from : 1); i < to; ++i) {
+        const ClockEventIndex index = order[i];
+        const unsigned int key = _dateKey(list->events[index]);
+        size_t j = i;
+
+        for(; j > 0 && _dateKey(list->events[order[j - 1]]) > key; --j) {
+            order[j] = order[j - 1];
+        }
+        order[j] = index;
+    }
+}
+
+//
+// @brief moves the cursor of _list_ forward to the first event which is
+//        not before _month_ and _day_
+//
+static void _advanceCursor(ClockEventList *list, int month, int day)
+{
+    while(list->cursor < list->size && clock_event_isBefore(clock_event_listAt(list, list->cursor), month, day)) {
+        ++(list->cursor);
+    }
+}
+
+//
+// @brief builds the day index of _list_ from its order
+//
+static int _buildDayIndex(ClockEventList *list)
 {
-    ClockEvent *lhs = (ClockEvent *)l;
-    ClockEvent *rhs = (ClockEvent *)r;
-
-    uint_fast8_t lMonth = clock_event_getMonth(*lhs);
-    uint_fast8_t rMonth = clock_event_getMonth(*rhs);
-    uint_fast8_t lDay = clock_event_getDayOfMonth(*lhs);
-    uint_fast8_t rDay = clock_event_getDayOfMonth(*rhs);
-
-    if(lMonth < rMonth) return -1;
-    if(lMonth == rMonth) {
-        if(lDay < rDay) return -1;
-        if(lDay == rDay) return 0;
+    ClockEventIndex *first = list->dayIndex->first;
+    size_t position = 0;
+
+    for(int month = JANUARY; month <= DECEMBER; ++month) {
+        int daysInMonth;
+        Call( date_time_daysInMonth(0, month, &daysInMonth) ); // leap year to account for February 29
+
+        for(int day = 1; day <= daysInMonth; ++day) {
+            while(position < list->size && clock_event_isBefore(clock_event_listAt(list, position), month, day)) {
+                ++position;
+            }
+            *first++ = position;
+        }
     }
 
-    return 1;
+    return 0;
+}
+
+//
+// @brief finds the position in the order of _list_ of the first event which
+//        is not before _month_ and _dayOfMonth_
+// @param position the result will be written here. It is the size of _list_
+//        if there is no such event
+//
+static int _findDay(const ClockEventList *list, int month, int dayOfMonth, size_t *position)
+{
+    if(list->dayIndex != NULL) {
+        int dayOfYear;
+        Call( date_time_dayOfYear(0, month, dayOfMonth, &dayOfYear) ); // leap year to account for February 29
+        *position = list->dayIndex->first[dayOfYear - 1];
+        return 0;
+    }
+
+    size_t i = 0;
+    while(i < list->size && clock_event_isBefore(clock_event_listAt(list, i), month, dayOfMonth)) {
+        ++i;
+    }
+    *position = i;
+
+    return 0;
+}
+
+//
+// @brief packs and unpacks ClockEventDate
+//
+#define _packDate(details) \
+    ( (ClockEventDate)((details).dayOfWeek << 9 | (details).month << 5 | (details).dayOfMonth) )
+
+#define _unpackDate(date, details) { \
+    (details).dayOfWeek  = ((date) >> 9) & 7; \
+    (details).month      = ((date) >> 5) & 0x0f; \
+    (details).dayOfMonth = (date) & 0x1f; \
+}
+
+//
+// @brief gets the dates of _year_ from the calendar of _list_. If the year is
+//        not there, the least recently used one is given to it
+// @returns the dates of the year
+//
+static ClockEventDate *_getCalendarYear(ClockEventList *list, int year)
+{
+    ClockEventCalendar *calendar = list->calendar;
+    size_t i = 0;
+
+    while(i < CLOCK_EVENT_CALENDAR_YEARS - 1 && calendar->years[i].year != year) {
+        ++i;
+    }
+
+    ClockEventDate *dates = calendar->years[i].dates;
+
+    if(calendar->years[i].year != year) {
+        memset(dates, 0, list->size * sizeof(ClockEventDate));
+    }
+
+    //
+    // Move the year to the front
+    //
+    for(; i > 0; --i) {
+        calendar->years[i] = calendar->years[i - 1];
+    }
+    calendar->years[0].year  = year;
+    calendar->years[0].dates = dates;
+
+    return dates;
+}
+
+//
+// @brief gets the details of event _i_ of _list_ for _year_, from the
+//        calendar of the list if it has one
+//
+static int _getDetails(ClockEventList *list, ClockEventIndex i, int year, ClockEventDetails *eventDetails)
+{
+    if(list->calendar == NULL) {
+        CallEx( clock_event_getEventDetails(list->events + i, year, eventDetails),
+                "on events[%zu], size %zu", i, list->size);
+        return 0;
+    }
+
+    ClockEventDate *date = _getCalendarYear(list, year) + i;
+
+    if(*date == 0) {
+        CallEx( clock_event_getEventDetails(list->events + i, year, eventDetails),
+                "on events[%zu], size %zu", i, list->size);
+        *date = _packDate(*eventDetails);
+    } else {
+        _unpackDate(*date, *eventDetails);
+    }
+
+    return 0;
+}
+
+//
+// @brief moves an event of _list_, which comes before _dateTime_, to the next
+//        year if that year's date of it comes before _dateTime_ as well
+// @param wasChanged is set to TRUE if the date of the event was changed
+//
+static int _rollOverEvent(ClockEventList *list, ClockEventIndex i, const DateTime *dateTime, Bool *wasChanged)
+{
+    ClockEvent *event = list->events + i;
+    const int nextYear = dateTime->year + 1;
+
+    // don't recalculate the event if it has been already updated to the next year
+    if(event->yearCalculated == nextYear) {
+        return 0;
+    }
+
+    ClockEventDetails eventDetails;
+    Call( _getDetails(list, i, nextYear, &eventDetails) );
+
+    if(clock_event_detailsIsBefore(eventDetails, dateTime->month, dateTime->day)) {
+        clock_event_setEventDetails(*event, eventDetails, nextYear);
+        *wasChanged = TRUE;
+    }
+
+    return 0;
 }
 
 static inline int _getDetailsForDayOfMonthEvent(const ClockEvent *event, int year, ClockEventDetails *eventDetails)
@@ -163,17 +322,12 @@ static inline int _getDetailsForDayOfWeekEvent(const ClockEvent *event, int year
 
 static inline int _getDetailsForDayOfYearEvent(const ClockEvent *event, int year, ClockEventDetails *eventDetails)
 {
-    int d = clock_event_getDayOfYear(*event);
-    int daysInMonth = 0;
-    int_fast8_t month = JANUARY - 1;
-
-    while(d > daysInMonth) {
-        ++month;
-        d -= daysInMonth;
-        Call( date_time_daysInMonth(year, month, &daysInMonth) );
-    }
+    int month = JANUARY;
+    int dayOfMonth = 0;
+
+    Call( date_time_fromDayOfYear(year, clock_event_getDayOfYear(*event), &month, &dayOfMonth) );
 
-    eventDetails->dayOfMonth = d;
+    eventDetails->dayOfMonth = dayOfMonth;
     eventDetails->month = month;
 
     Call( date_time_calculateDayOfWeek(
@@ -259,7 +413,7 @@ int clock_event_toStr(const ClockEvent *event, char str[EVENT_STRING_BUFFER_SIZE
 //       it will print
 //       13 years - started in 2000
 //
-int clock_event_yearInfoToStr(const ClockEvent *event, char str[EVENT_STRING_BUFFER_SIZE])
+int clock_event_yearInfoToStr(const ClockEvent *event, char str[EVENT_YEAR_INFO_STR_SIZE])
 {
     NullCheck(event);
     NullCheck(str);
@@ -273,115 +427,292 @@ int clock_event_yearInfoToStr(const ClockEvent *event, char str[EVENT_STRING_BUF
     return 0;
 }
 
+//
+// @brief binds an events array and its order array to a list. The order
+//        starts the same as the array, clock_event_initList() sorts it
+// @param list
+// @param events an array of ClockEvent
+// @param order an array of _sz_ elements which the list keeps its order in
+// @param sz the number of elements in _events_
+//
+// @returns 0 on ok
+//   EINVAL if _list_ is NULL
+//          if _events_ or _order_ is NULL
+//
+int clock_event_setList(ClockEventList *list, ClockEvent *events, ClockEventIndex *order, size_t sz)
+{
+    NullCheck(list);
+    NullCheck(events);
+    NullCheck(order);
+
+    for(size_t i = 0; i < sz; ++i) {
+        order[i] = i;
+    }
+
+    list->events   = events;
+    list->order    = order;
+    list->size     = sz;
+    list->cursor   = 0;
+    list->year     = CLOCK_EVENT_YEAR_NOT_CALCULATED;
+    list->month    = JANUARY;
+    list->day      = 1;
+    list->calendar = NULL;
+    list->dayIndex = NULL;
+
+    return 0;
+}
+
+//
+// @brief attaches a calendar to a list, so that the dates of its events are
+//        calculated once per year for the years which are used the most
+// @param list a list bound with clock_event_setList()
+// @param calendar
+// @param dates an array of CLOCK_EVENT_CALENDAR_YEARS * list->size elements
+//        which the calendar keeps the dates in
+//
+// @returns 0 on ok
+//   EINVAL if _list_ is NULL
+//          if _calendar_ is NULL
+//          if _dates_ is NULL
+//
+// @note call it again after the events of the list have been changed
+//
+int clock_event_setCalendar(ClockEventList *list, ClockEventCalendar *calendar, ClockEventDate *dates)
+{
+    NullCheck(list);
+    NullCheck(calendar);
+    NullCheck(dates);
+
+    for(size_t i = 0; i < CLOCK_EVENT_CALENDAR_YEARS; ++i, dates += list->size) {
+        calendar->years[i].year  = CLOCK_EVENT_YEAR_NOT_CALCULATED;
+        calendar->years[i].dates = dates;
+    }
+
+    list->calendar = calendar;
+
+    return 0;
+}
+
+//
+// @brief attaches a day index to a list, so that the events of a day are
+//        found with a single lookup. The index is built right away and then
+//        every time the dates of the events change
+// @param list a list bound with clock_event_setList()
+// @param dayIndex
+//
+// @returns 0 on ok
+//   EINVAL if _list_ is NULL
+//          if _dayIndex_ is NULL
+//
+int clock_event_setDayIndex(ClockEventList *list, ClockEventDayIndex *dayIndex)
+{
+    NullCheck(list);
+    NullCheck(dayIndex);
+
+    list->dayIndex = dayIndex;
+    Call( _buildDayIndex(list) );
+
+    return 0;
+}
+
+//
+// @brief initializes a list of ClockEvents by setting the missing date/time parts
+//        for _year_ and sorts its order. The list is then updated for January 1
+// @param list a list bound with clock_event_setList()
+// @param year a year to init the list to
+//
+// @returns 0 on ok
+//   EINVAL if _list_ is NULL
+//
+// @note the order of a list only changes a little from one year to another,
+//       so sorting it again costs little more than a pass over it
+//
+int clock_event_initList(ClockEventList *list, int year)
+{
+    NullCheck(list);
+
+    ClockEvent *event = list->events;
+    for(size_t i = 0; i < list->size; ++i, ++event) {
+        ClockEventDetails eventDetails;
+        Call( _getDetails(list, i, year, &eventDetails) );
+        clock_event_setEventDetails(*event, eventDetails, year);
+    }
+
+    _sortOrder(list, 0, list->size);
+
+    if(list->dayIndex != NULL) {
+        Call( _buildDayIndex(list) );
+    }
+
+    list->cursor = 0;
+    list->year   = year;
+    list->month  = JANUARY;
+    list->day    = 1;
+
+    return 0;
+}
+
 //
 // @brief Updates a list of ClockEvents by setting the missing date/time parts.
 //        This function should be called on a list of events every time the day changes.
 //        In addition this function should be called after clock_event_initList().
-//        It updates and then sorts _eventsList_ such that if an event comes before
+//        It updates and then sorts _list_ such that if an event comes before
 //        dateTime->day / dateTime->month than it will be treated like the next year event.
 //        Any other event will be treated as the same to dateTime->year event.
 //
-// @param eventsList a pointer to an array of ClockEvent
-// @param sz the number of elements in _eventsList_
+// @param list a list initialized with clock_event_initList()
 // @param dateTime a pointer to DateTime for which the event list should be updated
 //
 // @returns 0 on ok
-//   EINVAL if _eventsList_ is NULL
+//   EINVAL if _list_ is NULL
+//          if _dateTime_ is NULL
+//
+// @note moving forward within a year only looks at the events which have
+//       passed since the last update and at those of the last
+//       CLOCK_EVENT_MAX_DRIFT_DAYS + 1 days, which may be due to move to the
+//       next year. Any other change of the date goes over the whole list
 //
-int clock_event_updateList(ClockEvent *eventsList, size_t sz, const DateTime *dateTime)
+int clock_event_updateList(ClockEventList *list, const DateTime *dateTime)
 {
-    NullCheck(eventsList);
+    NullCheck(list);
     NullCheck(dateTime);
 
-    if(sz == 0) return 0;
+    if(list->size == 0) return 0;
 
     Bool wasChanged = FALSE;
 
-    //
-    // See if anything needs to be updated
-    //
-    int nextYear = dateTime->year + 1;
-    ClockEvent *event = eventsList;
-    for(size_t i = 0; i < sz; ++i, ++event) {
-        if(clock_event_isBefore(*event, dateTime->month, dateTime->day)) {
-            // don't recalculate the event if it has been already updated to the next year
-            if(event->yearCalculated == nextYear) {
-                continue;
-            }
+    if(dateTime->year == list->year
+    && (dateTime->month > list->month || (dateTime->month == list->month && dateTime->day >= list->day))) {
+        //
+        // The events, which have passed since the last update, were not before
+        // that date, so they still have their this year's dates. An event may
+        // have been left on its this year's date too if its next year's date,
+        // which is at most CLOCK_EVENT_MAX_DRIFT_DAYS later, had not passed yet.
+        // Nothing before those can change
+        //
+        DateTime since = date_time_initDate(dateTime->year, dateTime->month, dateTime->day - CLOCK_EVENT_MAX_DRIFT_DAYS - 1);
+        Call( date_time_normalize(&since) );
+        if(since.year != dateTime->year) {
+            since = (DateTime)date_time_initDate(dateTime->year, JANUARY, 1);
+        }
+
+        size_t from = list->cursor;
+        while(from > 0 && ! clock_event_isBefore(clock_event_listAt(list, from - 1), since.month, since.day)) {
+            --from;
+        }
 
-            ClockEventDetails eventDetails;
-            CallEx( clock_event_getEventDetails(event, nextYear, &eventDetails),
-                    "on eventsList[%zu], size %zu", i, sz);
+        _advanceCursor(list, dateTime->month, dateTime->day);
 
-            if(clock_event_detailsIsBefore(eventDetails, dateTime->month, dateTime->day)) {
-                clock_event_setEventDetails(*event, eventDetails, nextYear);
-                wasChanged = TRUE;
-            }
-        } else if(event->yearCalculated == nextYear) {
-            ClockEventDetails eventDetails;
-            CallEx( clock_event_getEventDetails(event, dateTime->year, &eventDetails),
-                    "on eventsList[%zu], size %zu", i, sz);
-
-            if( ! clock_event_detailsIsBefore(eventDetails, dateTime->month, dateTime->day)) {
-                clock_event_setEventDetails(*event, eventDetails, dateTime->year);
-                wasChanged = TRUE;
+        for(size_t i = from; i < list->cursor; ++i) {
+            Call( _rollOverEvent(list, list->order[i], dateTime, &wasChanged) );
+        }
+
+        //
+        // Moved events still come before _dateTime_
+        //
+        if(wasChanged) {
+            _sortOrder(list, from, list->cursor);
+        }
+    } else {
+        ClockEvent *event = list->events;
+        for(size_t i = 0; i < list->size; ++i, ++event) {
+            if(clock_event_isBefore(*event, dateTime->month, dateTime->day)) {
+                Call( _rollOverEvent(list, i, dateTime, &wasChanged) );
+            } else if(event->yearCalculated != dateTime->year) {
+                ClockEventDetails eventDetails;
+                Call( _getDetails(list, i, dateTime->year, &eventDetails) );
+
+                if( ! clock_event_detailsIsBefore(eventDetails, dateTime->month, dateTime->day)) {
+                    clock_event_setEventDetails(*event, eventDetails, dateTime->year);
+                    wasChanged = TRUE;
+                }
             }
         }
+
+        //
+        // Sort the order if something was changed
+        //
+        if(wasChanged) {
+            _sortOrder(list, 0, list->size);
+        }
+
+        list->cursor = 0;
+        _advanceCursor(list, dateTime->month, dateTime->day);
     }
 
-    //
-    // Sort the events list if something was changed
-    //
-    if(wasChanged) {
-        qsort(eventsList, sz, sizeof(ClockEvent), _clock_event_compare);
+    if(wasChanged && list->dayIndex != NULL) {
+        Call( _buildDayIndex(list) );
     }
 
+    list->year  = dateTime->year;
+    list->month = dateTime->month;
+    list->day   = dateTime->day;
+
     return 0;
 }
 
 //
-// @brief initializes a list of ClockEvents by setting the missing date/time parts
-// @param eventsList a pointer to an array of ClockEvent
-// @param sz the number of elements in _eventsList_
-// @param year a year to init the list to
-//
+// @brief finds the next closest to _month_ and _dayOfMonth_ event from _list_
+// @param list
+// @param month
+// @param dayOfMonth
+// @param index the position in the date order of _list_ will be returned here,
+//        see clock_event_listAt()
 // @returns 0 on ok
-//   EINVAL if _eventsList_ is NULL
+//   EINVAL if _list_ is NULL
+//   EINVAL if _index_ is NULL
+//   ERANGE if _month_ is < JANUARY of _month_ is > DECEMBER
+//   ERANGE if _dayOfMonth_ is < 1 or _dayOfMonth_ is > daysInMonth(month)
 //
-int clock_event_initList(ClockEvent *eventsList, size_t sz, int year)
+// @note the next closest event to the date the list was updated for is its cursor
+//
+int clock_event_findClosestFromList(const ClockEventList *list, int month, int dayOfMonth, int *index)
 {
-    NullCheck(eventsList);
+    NullCheck(list);
+    NullCheck(index);
+#if PARAM_CHECKS
+    if(month < JANUARY || month > DECEMBER) {
+        OriginateErrorEx(ERANGE, "%d", "month = [%d] should be >= %d and < %d", month, JANUARY, DECEMBER);
+    }
+    int _d;
+    Call( date_time_daysInMonth(0, month, &_d) ); // leap year to account for February 29
+    if(dayOfMonth < 1 || dayOfMonth > _d) {
+        OriginateErrorEx(ERANGE, "%d", "dayOfMonth = [%d] should be > 0 and <= %d", dayOfMonth, _d);
+    }
+#endif
 
-    if(sz == 0) return 0;
+    *index = 0;
 
-    ClockEvent *event = eventsList;
-    for(size_t i = 0; i < sz; ++i, ++event) {
-        ClockEventDetails eventDetails;
-        CallEx( clock_event_getEventDetails(event, year, &eventDetails),
-                "on eventsList[%zu], size %zu", i, sz);
-        clock_event_setEventDetails(*event, eventDetails, year);
+    if(list->size == 0) return 0;
+
+    size_t position = list->cursor;
+    if(month != list->month || dayOfMonth != list->day) {
+        Call( _findDay(list, month, dayOfMonth, &position) );
+    }
+
+    if(position < list->size) {
+        *index = (int)position;
     }
 
     return 0;
 }
 
 //
-// @brief finds the next closest to _month_ and _dayOfMonth_ event from _eventsList_
-// @param eventsList
-// @param sz the number of elements in _eventsList_
+// @brief checks whether any event of _list_ is on _month_ and _dayOfMonth_
+// @param list
 // @param month
 // @param dayOfMonth
-// @param index the result will be returned here
+// @param isEventDay the result will be returned here
 // @returns 0 on ok
-//   EINVAL if _eventsList_ is NULL
-//   EINVAL if _index_ is NULL
+//   EINVAL if _list_ is NULL
+//   EINVAL if _isEventDay_ is NULL
 //   ERANGE if _month_ is < JANUARY of _month_ is > DECEMBER
 //   ERANGE if _dayOfMonth_ is < 1 or _dayOfMonth_ is > daysInMonth(month)
 //
-int clock_event_findClosestFromList(const ClockEvent *eventsList, size_t sz, int month, int dayOfMonth, int *index)
+int clock_event_isEventDay(const ClockEventList *list, int month, int dayOfMonth, Bool *isEventDay)
 {
-    NullCheck(eventsList);
-    NullCheck(index);
+    NullCheck(list);
+    NullCheck(isEventDay);
 #if PARAM_CHECKS
     if(month < JANUARY || month > DECEMBER) {
         OriginateErrorEx(ERANGE, "%d", "month = [%d] should be >= %d and < %d", month, JANUARY, DECEMBER);
@@ -393,16 +724,13 @@ int clock_event_findClosestFromList(const ClockEvent *eventsList, size_t sz, int
     }
 #endif
 
-    *index = 0;
+    size_t position;
+    Call( _findDay(list, month, dayOfMonth, &position) );
 
-    if(sz == 0) return 0;
-
-    const ClockEvent *event = eventsList;
-    for(size_t i = 0; i < sz; ++i, ++event) {
-        if( ! clock_event_isBefore(*event, month, dayOfMonth)) {
-            *index = i;
-            break;
-        }
+    *isEventDay = FALSE;
+    if(position < list->size) {
+        const ClockEvent *event = &clock_event_listAt(list, position);
+        *isEventDay = (clock_event_getMonth(*event) == month && clock_event_getDayOfMonth(*event) == dayOfMonth) ? TRUE : FALSE;
     }
 
     return 0;
@@ -102,6 +102,96 @@ typedef struct {
     int dayOfMonth;
 } ClockEventDetails;
 
+//
+// An index of an event in an events array
+//
+typedef size_t ClockEventIndex;
+
+//
+// The date of an event in a year packed into 16 bits:
+//
+//        0000 000 0000 00000
+//            |DoW| Mnth| DoM |
+//
+// 0 means the date has not been calculated yet
+//
+typedef uint16_t ClockEventDate;
+
+//
+// The number of years a ClockEventCalendar keeps, i.e. the current year
+// and two years around it. May be overridden at build time
+//
+#ifndef CLOCK_EVENT_CALENDAR_YEARS
+#define CLOCK_EVENT_CALENDAR_YEARS 5
+#endif
+
+//
+// @brief ClockEventCalendar keeps the dates of the events of a list for the
+//        last CLOCK_EVENT_CALENDAR_YEARS used years. A date is calculated the
+//        first time it is needed. When a year which is not kept is needed,
+//        the least recently used one makes room for it
+//
+// @note attach a calendar to a list with clock_event_setCalendar()
+//
+typedef struct {
+    struct {
+        int             year;   // CLOCK_EVENT_YEAR_NOT_CALCULATED if not used
+        ClockEventDate *dates;  // a date per event of the list
+    } years[CLOCK_EVENT_CALENDAR_YEARS];   // the most recently used first
+} ClockEventCalendar;
+
+//
+// The number of days of a year in a ClockEventDayIndex, February 29 included
+//
+#define CLOCK_EVENT_DAY_INDEX_SIZE 366
+
+//
+// @brief ClockEventDayIndex maps every day of a year to the position in the
+//        order of a list of the first event which is not before that day,
+//        or to the size of the list if there is no such event. Day 0 is
+//        January 1, the days are counted in a leap year
+//
+// @note attach an index to a list with clock_event_setDayIndex()
+//
+typedef struct {
+    ClockEventIndex first[CLOCK_EVENT_DAY_INDEX_SIZE];
+} ClockEventDayIndex;
+
+//
+// @brief ClockEventList keeps the events in the order of their dates
+//        without moving them. _order_ lists the indexes of _events_
+//        sorted by month and day of month. _cursor_ is the position in
+//        _order_ of the first event which is not before the date the
+//        list was updated for, or _size_ if there is no such event.
+//
+// @warning Don't change the fields directly, use clock_event_setList(),
+//          clock_event_initList() and clock_event_updateList()
+//
+typedef struct {
+    ClockEvent      *events;
+    ClockEventIndex *order;
+    size_t           size;
+    size_t           cursor;
+    int              year;      // the date the list was updated for
+    int              month;
+    int              day;
+    ClockEventCalendar *calendar;   // if not NULL, the dates of the events are looked up here
+    ClockEventDayIndex *dayIndex;   // if not NULL, the events of a day are looked up here
+} ClockEventList;
+
+//
+// @brief gets the event at position _i_ of the date order of a list
+// @warning neither _list_ nor _i_ are checked
+//
+#define clock_event_listAt(list, i) ( (list)->events[(list)->order[i]] )
+
+//
+// The most days a day of week or a day of year event moves from one year
+// to the next. The n-th day of week of a month stays within a week, and
+// the n-th day of year moves by one day at most around a leap year
+//
+#define CLOCK_EVENT_MAX_DRIFT_DAYS 6
+
 #define DAY_OF_WEEK_FLAG 0x01ff
 #define WEEK_FROM_START 1
 #define WEEK_FROM_END   0
@@ -109,8 +199,11 @@ typedef struct {
 
 #define clock_event_detailsInit(month, dayOfMonth, dayOfWeek) { month, dayOfWeek, dayOfMonth }
 
+// "-2147483648 years - started in -2147483648" + '\0'
+#define EVENT_YEAR_INFO_STR_SIZE 43U
+
 #include "clock_state.h"
-#define EVENT_STRING_BUFFER_SIZE STATE_TEXT_SIZE
+#define EVENT_STRING_BUFFER_SIZE 101U
 
 //
 // @brief Initializer for an event which is set with month and day
@@ -207,7 +300,7 @@ int clock_event_toStr(const ClockEvent *event, char str[EVENT_STRING_BUFFER_SIZE
 //       it will print
 //       13 years - started in 2000
 //
-int clock_event_yearInfoToStr(const ClockEvent *event, char str[EVENT_STRING_BUFFER_SIZE]);
+int clock_event_yearInfoToStr(const ClockEvent *event, char str[EVENT_YEAR_INFO_STR_SIZE]);
 
 //
 // @brief Calculates event details for a given year
@@ -222,48 +315,118 @@ int clock_event_yearInfoToStr(const ClockEvent *event, char str[EVENT_STRING_BUF
 //
 int clock_event_getEventDetails(const ClockEvent *event, int year, ClockEventDetails *eventDetails);
 
+//
+// @brief binds an events array and its order array to a list. The order
+//        starts the same as the array, clock_event_initList() sorts it
+// @param list
+// @param events an array of ClockEvent
+// @param order an array of _sz_ elements which the list keeps its order in
+// @param sz the number of elements in _events_
+//
+// @returns 0 on ok
+//   EINVAL if _list_ is NULL
+//          if _events_ or _order_ is NULL
+//
+int clock_event_setList(ClockEventList *list, ClockEvent *events, ClockEventIndex *order, size_t sz);
+
+//
+// @brief attaches a calendar to a list, so that the dates of its events are
+//        calculated once per year for the years which are used the most
+// @param list a list bound with clock_event_setList()
+// @param calendar
+// @param dates an array of CLOCK_EVENT_CALENDAR_YEARS * list->size elements
+//        which the calendar keeps the dates in
+//
+// @returns 0 on ok
+//   EINVAL if _list_ is NULL
+//          if _calendar_ is NULL
+//          if _dates_ is NULL
+//
+// @note call it again after the events of the list have been changed
+//
+int clock_event_setCalendar(ClockEventList *list, ClockEventCalendar *calendar, ClockEventDate *dates);
+
+//
+// @brief attaches a day index to a list, so that the events of a day are
+//        found with a single lookup. The index is built right away and then
+//        every time the dates of the events change
+// @param list a list bound with clock_event_setList()
+// @param dayIndex
+//
+// @returns 0 on ok
+//   EINVAL if _list_ is NULL
+//          if _dayIndex_ is NULL
+//
+int clock_event_setDayIndex(ClockEventList *list, ClockEventDayIndex *dayIndex);
+
+//
+// @brief initializes a list of ClockEvents by setting the missing date/time parts
+//        for _year_ and sorts its order. The list is then updated for January 1
+// @param list a list bound with clock_event_setList()
+// @param year a year to init the list to
+//
+// @returns 0 on ok
+//   EINVAL if _list_ is NULL
+//
+// @note the order of a list only changes a little from one year to another,
+//       so sorting it again costs little more than a pass over it
+//
+int clock_event_initList(ClockEventList *list, int year);
+
 //
 // @brief Updates a list of ClockEvents by setting the missing date/time parts.
 //        This function should be called on a list of events every time the day changes.
 //        In addition this function should be called after clock_event_initList().
-//        It updates and then sorts _eventsList_ such that if an event comes before
+//        It updates and then sorts _list_ such that if an event comes before
 //        dateTime->day / dateTime->month than it will be treated like the next year event.
 //        Any other event will be treated as the same to dateTime->year event.
 //
-// @param eventsList a pointer to an array of ClockEvent
-// @param sz the number of elements in _eventsList_
+// @param list a list initialized with clock_event_initList()
 // @param dateTime a pointer to DateTime for which the event list should be updated
 //
 // @returns 0 on ok
-//   EINVAL if _eventsList_ is NULL
+//   EINVAL if _list_ is NULL
+//          if _dateTime_ is NULL
 //
-int clock_event_updateList(ClockEvent *eventsList, size_t sz, const DateTime *dateTime);
-
+// @note moving forward within a year only looks at the events which have
+//       passed since the last update and at those of the last
+//       CLOCK_EVENT_MAX_DRIFT_DAYS + 1 days, which may be due to move to the
+//       next year. Any other change of the date goes over the whole list
 //
-// @brief initializes a list of ClockEvents by setting the missing date/time parts
-// @param eventsList a pointer to an array of ClockEvent
-// @param sz the number of elements in _eventsList_
-// @param year a year to init the list to
+int clock_event_updateList(ClockEventList *list, const DateTime *dateTime);
+
 //
+// @brief finds the next closest to _month_ and _dayOfMonth_ event from _list_
+// @param list
+// @param month
+// @param dayOfMonth
+// @param index the position in the date order of _list_ will be returned here,
+//        see clock_event_listAt()
 // @returns 0 on ok
-//   EINVAL if _eventsList_ is NULL
+//   EINVAL if _list_ is NULL
+//   EINVAL if _index_ is NULL
+//   ERANGE if _month_ is < JANUARY of _month_ is > DECEMBER
+//   ERANGE if _dayOfMonth_ is < 1 or _dayOfMonth_ is > daysInMonth(month)
 //
-int clock_event_initList(ClockEvent *eventsList, size_t sz, int year);
+// @note the next closest event to the date the list was updated for is its cursor.
+//       The one to any other date is looked up in the day index of the list
+//       if it has one
+//
+int clock_event_findClosestFromList(const ClockEventList *list, int month, int dayOfMonth, int *index);
 
 //
-// @brief finds the next closest to _month_ and _dayOfMonth_ event from _eventsList_
-// @param eventsList
-// @param sz the number of elements in _eventsList_
+// @brief checks whether any event of _list_ is on _month_ and _dayOfMonth_
+// @param list
 // @param month
 // @param dayOfMonth
-// @param index the result will be returned here
+// @param isEventDay the result will be returned here
 // @returns 0 on ok
-//   EINVAL if _eventsList_ is NULL
-//   EINVAL if _index_ is NULL
+//   EINVAL if _list_ is NULL
+//   EINVAL if _isEventDay_ is NULL
 //   ERANGE if _month_ is < JANUARY of _month_ is > DECEMBER
 //   ERANGE if _dayOfMonth_ is < 1 or _dayOfMonth_ is > daysInMonth(month)
 //
-int clock_event_findClosestFromList(const ClockEvent *eventsList, size_t sz, int month, int dayOfMonth, int *index);
+int clock_event_isEventDay(const ClockEventList *list, int month, int dayOfMonth, Bool *isEventDay);
 
 #include "clock_event_personal.h"
 
@@ -0,0 +1,326 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock event database
+//
+
+#ifndef __AVR__
+
+#ifdef PARAM_CHECKS
+#include <logger.h>
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "clock_event_db.h"
+
+//
+// @brief reports a malformed database
+//
+#ifdef PARAM_CHECKS
+#define BadDb(error, format, ...) OriginateErrorEx(error, "%d", "malformed event database: " format, ##__VA_ARGS__)
+#else
+#define BadDb(error, format, ...) return error
+#endif
+
+//
+// @brief read little-endian numbers of a database
+//
+static uint32_t _read16(const unsigned char *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8;
+}
+
+static uint32_t _read32(const unsigned char *p)
+{
+    return _read16(p) | _read16(p + 2) << 16;
+}
+
+//
+// @brief checks the rule of the date of an event, so that its fields
+//        are in range of the tables, which the dates are calculated with
+// @returns 0 on success
+// ERANGE - if a field of the rule is out of range
+//
+static int _checkRule(const ClockEvent *event, size_t i)
+{
+#ifndef PARAM_CHECKS
+    (void)i; // only reported
+#endif
+
+    if(clock_event_isDayOfYearEvent(*event)) {
+        if(clock_event_getDayOfYear(*event) > 366)
+            BadDb(ERANGE, "the day of year of event %zu is out of range", i);
+
+        return 0;
+    }
+
+    const int month = clock_event_getMonth(*event);
+    if(month > DECEMBER)
+        BadDb(ERANGE, "the month of event %zu is out of range", i);
+
+    if(clock_event_isDayOfWeekEvent(*event)) {
+        if(clock_event_getDayOfWeek(*event) > SATURDAY)
+            BadDb(ERANGE, "the day of week of event %zu is out of range", i);
+    } else {
+        //
+        // A leap year, so that February 29 passes
+        //
+        int daysInMonth;
+        Call( date_time_daysInMonth(0, month, &daysInMonth) );
+
+        const int day = clock_event_getDayOfMonth(*event);
+        if(day < 1 || day > daysInMonth)
+            BadDb(ERANGE, "the day of month of event %zu is out of range", i);
+    }
+
+    return 0;
+}
+
+//
+// @brief loads a database. Only the header is read, the events are
+//        checked when they are set to a list. _bytes_ are used in place,
+//        so they should outlive the database and the lists set from it
+// @param db
+// @param bytes the database
+// @param size the size of _bytes_
+// @returns 0 on success
+// EINVAL - if _db_ is NULL
+//          if _bytes_ is NULL
+//          if _bytes_ is not a valid database of CLOCK_EVENT_DB_VERSION
+//
+int clock_event_db_load(ClockEventDb *db, const unsigned char *bytes, size_t size)
+{
+    NullCheck(db);
+    NullCheck(bytes);
+
+    if(size < CLOCK_EVENT_DB_HEADER_SIZE)
+        BadDb(EINVAL, "%zu bytes is too short for the header", size);
+
+    if(memcmp(bytes, CLOCK_EVENT_DB_MAGIC, sizeof(CLOCK_EVENT_DB_MAGIC) - 1) != 0)
+        BadDb(EINVAL, "bad magic");
+
+    const unsigned int version = bytes[4];
+    if(version != CLOCK_EVENT_DB_VERSION)
+        BadDb(EINVAL, "version %u is not supported", version);
+
+    const size_t count = _read32(bytes + 8);
+    if(count > (size - CLOCK_EVENT_DB_HEADER_SIZE) / (CLOCK_EVENT_DB_EVENT_SIZE + CLOCK_EVENT_DB_ORDER_SIZE))
+        BadDb(EINVAL, "%zu events don't fit %zu bytes", count, size);
+
+    memset(db, 0, sizeof(ClockEventDb));
+
+    db->count       = count;
+    db->stringsSize = _read32(bytes + 12);
+    db->events      = bytes + CLOCK_EVENT_DB_HEADER_SIZE;
+    db->order       = db->events + db->count * CLOCK_EVENT_DB_EVENT_SIZE;
+    db->strings     = (const char *)(db->order + db->count * CLOCK_EVENT_DB_ORDER_SIZE);
+
+    const size_t expectedSize = (size_t)((const unsigned char *)db->strings - bytes) + db->stringsSize;
+    if(size != expectedSize)
+        BadDb(EINVAL, "the size is %zu bytes, but it should be %zu", size, expectedSize);
+
+    //
+    // Every name is a string then, as long as its offset is in the strings
+    //
+    if(db->stringsSize > 0 && db->strings[db->stringsSize - 1] != '\0')
+        BadDb(EINVAL, "the strings should end with '\\0'");
+
+    return 0;
+}
+
+//
+// @brief memory-maps a database file read only and loads it
+// @param db
+// @param path
+// @returns 0 on success
+// EINVAL - if _db_ is NULL
+//          if _path_ is NULL
+//          if the file is not a valid database
+// an error of open(), fstat() or mmap() otherwise
+//
+int clock_event_db_map(ClockEventDb *db, const char *path)
+{
+    NullCheck(db);
+    NullCheck(path);
+
+    struct stat st;
+    int error = 0;
+    void *mapping = MAP_FAILED;
+
+    int fd = open(path, O_RDONLY);
+    if(fd == -1) {
+        error = errno;
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(error, "%d", "open('%s') failed: %s", path, strerror(error));
+#else
+        return error;
+#endif
+    }
+
+    if(fstat(fd, &st) == -1) {
+        error = errno;
+    } else if(st.st_size == 0) {
+        error = EINVAL;
+    } else {
+        mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if(mapping == MAP_FAILED) error = errno;
+    }
+
+    //
+    // The mapping keeps the file, so the descriptor is not needed anymore
+    //
+    close(fd);
+
+    if(error) {
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(error, "%d", "mapping '%s' failed: %s", path, strerror(error));
+#else
+        return error;
+#endif
+    }
+
+    error = clock_event_db_load(db, (const unsigned char *)mapping, (size_t)st.st_size);
+    if(error) {
+        munmap(mapping, (size_t)st.st_size);
+#ifdef PARAM_CHECKS
+        ContinueErrorEx(error, "%d", "'%s' is not an event database", path);
+#else
+        return error;
+#endif
+    }
+
+    db->mapping     = mapping;
+    db->mappingSize = (size_t)st.st_size;
+
+    return 0;
+}
+
+//
+// @brief unmaps a database which was loaded with clock_event_db_map()
+// @returns 0 on success
+// EINVAL - if _db_ is NULL
+//          if _db_ was not loaded with clock_event_db_map()
+//
+int clock_event_db_unmap(ClockEventDb *db)
+{
+    NullCheck(db);
+
+    if(db->mapping == NULL) {
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(EINVAL, "%d", "the event database is not mapped");
+#else
+        return EINVAL;
+#endif
+    }
+
+    munmap(db->mapping, db->mappingSize);
+    memset(db, 0, sizeof(ClockEventDb));
+
+    return 0;
+}
+
+//
+// @brief sets the events of a database to a list. _events_ get the rules
+//        of the dates and the names of the database, and _order_ gets its
+//        order. Call clock_event_initList() then
+// @param db
+// @param list
+// @param events an array of db->count events
+// @param order an array of db->count indexes
+// @returns 0 on success
+// EINVAL - if _db_ is NULL
+//          if _list_ is NULL
+//          if _events_ or _order_ is NULL
+// ERANGE - if an index of the order or a name is out of the database
+//          if a name is longer than CLOCK_EVENT_DB_MAX_NAME
+//          if a field of the rule of a date is out of range
+//          if the order is not a permutation of the events
+//
+int clock_event_db_setList(const ClockEventDb *db, ClockEventList *list, ClockEvent *events, ClockEventIndex *order)
+{
+    NullCheck(db);
+    NullCheck(list);
+    NullCheck(events);
+    NullCheck(order);
+
+    const unsigned char *record = db->events;
+    for(size_t i = 0; i < db->count; ++i, record += CLOCK_EVENT_DB_EVENT_SIZE) {
+        const uint32_t name = _read32(record + 8);
+
+        if(name >= db->stringsSize)
+            BadDb(ERANGE, "the name of event %zu is out of the strings", i);
+
+        const size_t nameSize = db->stringsSize - name < CLOCK_EVENT_DB_MAX_NAME + 1
+                              ? db->stringsSize - name
+                              : CLOCK_EVENT_DB_MAX_NAME + 1;
+        if(memchr(db->strings + name, '\0', nameSize) == NULL)
+            BadDb(ERANGE, "the name of event %zu is longer than %u", i, (unsigned int)CLOCK_EVENT_DB_MAX_NAME);
+
+        //
+        // ClockEvent.yearStarted is constant, so the event is initialized whole
+        //
+        const ClockEvent event = {
+            (int)(int32_t)_read32(record),
+            CLOCK_EVENT_YEAR_NOT_CALCULATED,
+            (uint16_t)_read16(record + 4),
+            record[6],
+            db->strings + name
+        };
+
+        Call( _checkRule(&event, i) );
+
+        memcpy(events + i, &event, sizeof(ClockEvent));
+    }
+
+    Call( clock_event_setList(list, events, order, db->count) );
+
+    //
+    // The order should be a permutation of the events. The events, which are
+    // not calculated yet, are marked as seen with a calculated year of 0 meanwhile
+    //
+    int    error = 0;
+    size_t i;
+
+    const unsigned char *index = db->order;
+    for(i = 0; i < db->count && error == 0; ++i, index += CLOCK_EVENT_DB_ORDER_SIZE) {
+        order[i] = _read32(index);
+
+        if(order[i] >= db->count) {
+            error = ERANGE;
+        } else if(events[order[i]].yearCalculated == 0) {
+            error = EEXIST;
+        } else {
+            events[order[i]].yearCalculated = 0;
+        }
+    }
+
+    for(size_t e = 0; e < db->count; ++e) {
+        events[e].yearCalculated = CLOCK_EVENT_YEAR_NOT_CALCULATED;
+    }
+
+    if(error == ERANGE)
+        BadDb(ERANGE, "order[%zu] = %zu is out of the events", i - 1, order[i - 1]);
+    if(error == EEXIST)
+        BadDb(ERANGE, "order[%zu] = %zu is in the order twice", i - 1, order[i - 1]);
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,136 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock event database. A database is a single binary file
+//        which tools/event_db compiles from a text source. It is
+//        memory-mapped. Loading it checks the header only. Setting it to a
+//        list checks every event and copies its rule into a ClockEvent, but
+//        the names of the events point straight into the mapping. There
+//        are no files on AVR, where the events are ClockEvents instead.
+//
+//        All the numbers of a database are little-endian and unaligned:
+//
+//        offset  size
+//        0       4     magic "BCED"
+//        4       1     version, CLOCK_EVENT_DB_VERSION
+//        5       3     reserved, 0
+//        8       4     the number of events
+//        12      4     the number of string bytes
+//        16            events, 12 bytes each:
+//                        4  the year the event started in, signed
+//                        2  blob_1 of ClockEvent, the rule of the date only
+//                        1  blob_2 of ClockEvent, the rule of the date only
+//                        1  reserved, 0
+//                        4  the offset of the name in the strings
+//                      order, 4 bytes each: the indexes of the events sorted
+//                      by their dates in the year the database was compiled
+//                      for. The dates of other years are nearly the same, so
+//                      the order only needs a few moves to be sorted again
+//                      strings, the names of the events, each ends with '\0'.
+//                      Equal names are stored once
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_EVENT_DB_H
+#define BINARY_CLOCK_LIB_CLOCK_EVENT_DB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock_event.h"
+
+#define CLOCK_EVENT_DB_MAGIC        "BCED"
+#define CLOCK_EVENT_DB_VERSION      1U
+
+#define CLOCK_EVENT_DB_HEADER_SIZE  16U
+#define CLOCK_EVENT_DB_EVENT_SIZE   12U
+#define CLOCK_EVENT_DB_ORDER_SIZE   4U
+
+//
+// The longest name of an event, see ClockEvent
+//
+#define CLOCK_EVENT_DB_MAX_NAME ( EVENT_STRING_BUFFER_SIZE - 4 - DATE_TIME_DATE_STR_SIZE )
+
+#ifndef __AVR__
+
+typedef struct {
+    const unsigned char *events;        // point into the database
+    const unsigned char *order;
+    const char          *strings;
+    size_t               count;         // the number of events
+    size_t               stringsSize;
+    void                *mapping;       // set by clock_event_db_map()
+    size_t               mappingSize;
+} ClockEventDb;
+
+//
+// @brief loads a database. Only the header is read, the events are
+//        checked when they are set to a list. _bytes_ are used in place,
+//        so they should outlive the database and the lists set from it
+// @param db
+// @param bytes the database
+// @param size the size of _bytes_
+// @returns 0 on success
+// EINVAL - if _db_ is NULL
+//          if _bytes_ is NULL
+//          if _bytes_ is not a valid database of CLOCK_EVENT_DB_VERSION
+//
+int clock_event_db_load(ClockEventDb *db, const unsigned char *bytes, size_t size);
+
+//
+// @brief memory-maps a database file read only and loads it
+// @param db
+// @param path
+// @returns 0 on success
+// EINVAL - if _db_ is NULL
+//          if _path_ is NULL
+//          if the file is not a valid database
+// an error of open(), fstat() or mmap() otherwise
+//
+int clock_event_db_map(ClockEventDb *db, const char *path);
+
+//
+// @brief unmaps a database which was loaded with clock_event_db_map()
+// @returns 0 on success
+// EINVAL - if _db_ is NULL
+//          if _db_ was not loaded with clock_event_db_map()
+//
+int clock_event_db_unmap(ClockEventDb *db);
+
+//
+// @brief sets the events of a database to a list. _events_ get the rules
+//        of the dates and the names of the database, and _order_ gets its
+//        order. Call clock_event_initList() then
+// @param db
+// @param list
+// @param events an array of db->count events
+// @param order an array of db->count indexes
+// @returns 0 on success
+// EINVAL - if _db_ is NULL
+//          if _list_ is NULL
+//          if _events_ or _order_ is NULL
+// ERANGE - if an index of the order or a name is out of the database
+//          if a name is longer than CLOCK_EVENT_DB_MAX_NAME
+//          if a field of the rule of a date is out of range
+//          if the order is not a permutation of the events
+//
+int clock_event_db_setList(const ClockEventDb *db, ClockEventList *list, ClockEvent *events, ClockEventIndex *order);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
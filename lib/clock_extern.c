@@ -23,4 +23,6 @@
 int (* clock_extern_setPixel)(int x, int y, Bool turnOn) = NULL;
 int (* clock_extern_uptimeMillis)(unsigned long *millis) = NULL;
 int (* clock_extern_clearScreen)(void) = NULL;
+int (* clock_extern_drawFrame)(const unsigned char rows[CLOCK_PATTERN_SIZE]) = NULL;
+int (* clock_extern_drawPanel)(const ClockPanel *panel) = NULL;
 int (* clock_extern_initDateTime)(DateTime *dt) = NULL;
@@ -26,6 +26,8 @@ extern "C" {
 #endif
 
 #include "date_time.h"
+#include "clock.h"
+#include "clock_panel.h"
 
 //
 // @note required
@@ -61,15 +63,45 @@ extern int (* clock_extern_uptimeMillis)(unsigned long *millis);
 //
 extern int (* clock_extern_clearScreen)(void);
 
+//
+// @note optional
+// @brief The implementation may set this pointer to a function which pushes
+//        the whole frame to the screen at once. If it is not NULL,
+//        clock_drawPattern(), clock_displayBinaryNumber(), clock_displayTime(),
+//        clock_displayDate() and clock_clearScreen() build the frame in memory
+//        and call this function once instead of calling clock_extern_setPixel()
+//        for every pixel.
+//
+// @param rows the frame. One byte per row, rows[0] is the top row, the most
+//        significant bit of a row is x = 0 (the same to ClockAlphabet patterns)
+//
+// @returns 0 on ok
+//
+extern int (* clock_extern_drawFrame)(const unsigned char rows[CLOCK_PATTERN_SIZE]);
+
+//
+// @note optional
+// @brief The implementation may set this pointer to a function which pushes
+//        a whole panel of modules (see clock_panel.h) to the screen at once.
+//        If it is NULL, clock_panel_draw() calls clock_extern_setPixel() for
+//        every pixel of the panel.
+//
+// @param panel the panel to draw. Its rows are packed into words, use
+//        clock_panel_getModule() to get the frame of every module
+//
+// @returns 0 on ok
+//
+extern int (* clock_extern_drawPanel)(const ClockPanel *panel);
+
 //
 // @note optional
 // @brief This pointer to a function is stubbed to NULL by default.
 //        If it is not NULL, then it will be called from
-//        clock_init(ClockState *) and ClockState->DateTime will be
-//        initialized by this funciton. I.e. an implementation may
-//        initialize the date and time to current date and time.
+//        clock_init(ClockState *) and ClockState->time will be
+//        set to the date and time which this funciton gives. I.e. an
+//        implementation may give the current date and time.
 //
-// @param dt &(clockState->dateTime) will be passed from clock_init(ClockState *)
+// @param dt January 1 of year 0 which the function should set
 //
 // @returns 0 on ok
 //
@@ -0,0 +1,283 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock font atlas
+//
+
+#ifdef PARAM_CHECKS
+#include <logger.h>
+#endif
+
+#include <errno.h>
+#include <string.h>
+
+#include "clock_font.h"
+
+//
+// @brief reports a malformed atlas
+//
+#ifdef PARAM_CHECKS
+#define BadAtlas(format, ...) OriginateErrorEx(EINVAL, "%d", "malformed font atlas: " format, ##__VA_ARGS__)
+#else
+#define BadAtlas(format, ...) return EINVAL
+#endif
+
+//
+// @brief read little-endian numbers of an atlas, which may be in ROM
+//
+static uint32_t _read16(const unsigned char *p)
+{
+    return (uint32_t)romReadByte(p) | (uint32_t)romReadByte(p + 1) << 8;
+}
+
+static uint32_t _read24(const unsigned char *p)
+{
+    return _read16(p) | (uint32_t)romReadByte(p + 2) << 16;
+}
+
+static uint32_t _read32(const unsigned char *p)
+{
+    return _read16(p) | _read16(p + 2) << 16;
+}
+
+//
+// @brief loads a font from an atlas. The atlas is validated once and then
+//        used in place, so it should outlive the font
+// @param font
+// @param atlas the atlas, which may be a ROM_DATA table
+// @param size the size of _atlas_ in bytes
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _atlas_ is NULL
+//          if _atlas_ is not a valid atlas of CLOCK_FONT_VERSION
+//
+int clock_font_load(ClockFont *font, const unsigned char *atlas, size_t size)
+{
+    NullCheck(font);
+    NullCheck(atlas);
+
+    if(size < CLOCK_FONT_HEADER_SIZE)
+        BadAtlas("%zu bytes is too short for the header", size);
+
+    for(unsigned int i = 0; i < sizeof(CLOCK_FONT_MAGIC) - 1; ++i) {
+        if(romReadByte(atlas + i) != (unsigned char)CLOCK_FONT_MAGIC[i])
+            BadAtlas("bad magic");
+    }
+
+    const unsigned int version = romReadByte(atlas + 4);
+    if(version != CLOCK_FONT_VERSION)
+        BadAtlas("version %u is not supported", version);
+
+    memset(font, 0, sizeof(ClockFont));
+
+    font->height       = romReadByte(atlas + 5);
+    font->glyphCount   = _read16(atlas + 6);
+    font->rangeCount   = _read16(atlas + 8);
+    font->defaultGlyph = _read16(atlas + 10);
+    font->columnsSize  = _read32(atlas + 12);
+
+    if(font->height == 0 || font->height > CLOCK_SCREEN_HEIGHT)
+        BadAtlas("height[%u] should be in range [1, %u]", font->height, CLOCK_SCREEN_HEIGHT);
+    if(font->defaultGlyph >= font->glyphCount)
+        BadAtlas("default glyph[%u] should be < %u", font->defaultGlyph, font->glyphCount);
+
+    font->ranges  = atlas + CLOCK_FONT_HEADER_SIZE;
+    font->glyphs  = font->ranges + (size_t)font->rangeCount * CLOCK_FONT_RANGE_SIZE;
+    font->columns = font->glyphs + (size_t)font->glyphCount * CLOCK_FONT_GLYPH_SIZE;
+
+    const size_t expectedSize = (size_t)(font->columns - atlas) + font->columnsSize;
+    if(size != expectedSize)
+        BadAtlas("the size is %zu bytes, but it should be %zu", size, expectedSize);
+
+    //
+    // The ranges should be sorted and should not overlap for the binary search
+    //
+    uint32_t nextCodepoint = 0;
+    for(unsigned int i = 0; i < font->rangeCount; ++i) {
+        const unsigned char *range = font->ranges + (size_t)i * CLOCK_FONT_RANGE_SIZE;
+        const uint32_t first = _read32(range);
+        const uint32_t count = _read16(range + 4);
+        const uint32_t glyph = _read16(range + 6);
+
+        if(count == 0 || first < nextCodepoint || glyph + count > font->glyphCount)
+            BadAtlas("range %u is out of order or out of glyphs", i);
+
+        nextCodepoint = first + count;
+    }
+
+    for(unsigned int i = 0; i < font->glyphCount; ++i) {
+        const unsigned char *glyph = font->glyphs + (size_t)i * CLOCK_FONT_GLYPH_SIZE;
+        const uint32_t offset = _read24(glyph);
+        const uint32_t width  = romReadByte(glyph + 3);
+
+        if(width > CLOCK_SCREEN_WIDTH || offset + width > font->columnsSize)
+            BadAtlas("glyph %u is out of columns", i);
+    }
+
+    return 0;
+}
+
+//
+// @brief finds the glyph of a codepoint
+// @param font
+// @param codepoint
+// @param glyph the glyph will be written here or font->defaultGlyph if the
+//        font has no glyph for _codepoint_
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _glyph_ is NULL
+//
+int clock_font_findGlyph(const ClockFont *font, uint32_t codepoint, unsigned int *glyph)
+{
+    NullCheck(font);
+    NullCheck(glyph);
+
+    unsigned int low  = 0;
+    unsigned int high = font->rangeCount;
+
+    //
+    // Find the last range which starts at or before _codepoint_
+    //
+    while(low < high) {
+        const unsigned int middle = low + (high - low) / 2;
+
+        if(_read32(font->ranges + (size_t)middle * CLOCK_FONT_RANGE_SIZE) <= codepoint) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    *glyph = font->defaultGlyph;
+
+    if(low > 0) {
+        const unsigned char *range = font->ranges + (size_t)(low - 1) * CLOCK_FONT_RANGE_SIZE;
+        const uint32_t index = codepoint - _read32(range);
+
+        if(index < _read16(range + 4)) {
+            *glyph = (unsigned int)(_read16(range + 6) + index);
+        }
+    }
+
+    return 0;
+}
+
+//
+// @brief gets the columns of a glyph
+// @param font
+// @param glyph [ glyph < font->glyphCount ]
+// @param columns the first column of the glyph will be written here
+// @param width the number of columns will be written here
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _columns_ is NULL
+//          if _width_ is NULL
+// ERANGE - if _glyph_ is out of range
+//
+int clock_font_getGlyph(const ClockFont *font, unsigned int glyph, const unsigned char **columns, unsigned int *width)
+{
+    NullCheck(font);
+    NullCheck(columns);
+    NullCheck(width);
+
+    if(glyph >= font->glyphCount) {
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(ERANGE, "%d", "glyph[%u] should be < %u", glyph, font->glyphCount);
+#else
+        return ERANGE;
+#endif
+    }
+
+    const unsigned char *entry = font->glyphs + (size_t)glyph * CLOCK_FONT_GLYPH_SIZE;
+
+    *columns = font->columns + _read24(entry);
+    *width   = romReadByte(entry + 3);
+
+    return 0;
+}
+
+//
+// @brief gets a glyph as a frame. The glyph takes the leftmost columns of
+//        the frame and the rest of them are blank
+// @warning _font_ and _glyph_ are not checked
+//
+ClockFrame clock_font_getGlyphFrame(const ClockFont *font, unsigned int glyph)
+{
+    const unsigned char *entry   = font->glyphs + (size_t)glyph * CLOCK_FONT_GLYPH_SIZE;
+    const unsigned char *columns = font->columns + _read24(entry);
+    const unsigned int   width   = romReadByte(entry + 3);
+
+    unsigned char pattern[CLOCK_PATTERN_SIZE] = { 0 };
+    for(unsigned int x = 0; x < width; ++x) {
+        pattern[x] = romReadByte(columns + x);
+    }
+
+    //
+    // The columns are the rows of the transposed glyph
+    //
+    return clock_frame_transpose(clock_frame_fromPattern(pattern));
+}
+
+//
+// @brief decodes the next codepoint of a UTF-8 string. A stray or a truncated
+//        sequence decodes to CLOCK_FONT_REPLACEMENT and only its first byte
+//        is skipped. An overlong sequence or a surrogate decodes to
+//        CLOCK_FONT_REPLACEMENT as a whole
+// @param text the string. It is advanced past the codepoint, unless the
+//        end of the string is reached
+// @returns the codepoint or 0 at the end of the string
+// @warning _text_ is not checked
+//
+uint32_t clock_font_decodeUtf8(const char **text)
+{
+    const unsigned char *p = (const unsigned char *)*text;
+
+    if(*p == '\0') return 0;
+
+    unsigned int length;
+    uint32_t     codepoint;
+    uint32_t     minimum;
+
+    if(*p < 0x80) {
+        *text += 1;
+        return *p;
+    } else if((*p & 0xe0) == 0xc0) {
+        length = 2; codepoint = *p & 0x1f; minimum = 0x80;
+    } else if((*p & 0xf0) == 0xe0) {
+        length = 3; codepoint = *p & 0x0f; minimum = 0x800;
+    } else if((*p & 0xf8) == 0xf0) {
+        length = 4; codepoint = *p & 0x07; minimum = 0x10000;
+    } else {
+        *text += 1;
+        return CLOCK_FONT_REPLACEMENT;
+    }
+
+    for(unsigned int i = 1; i < length; ++i) {
+        //
+        // The terminating 0 is not a continuation byte, so it stops here too
+        //
+        if((p[i] & 0xc0) != 0x80) {
+            *text += 1;
+            return CLOCK_FONT_REPLACEMENT;
+        }
+        codepoint = codepoint << 6 | (p[i] & 0x3f);
+    }
+
+    *text += length;
+
+    if(codepoint < minimum || codepoint > 0x10ffff || (codepoint >= 0xd800 && codepoint <= 0xdfff))
+        return CLOCK_FONT_REPLACEMENT;
+
+    return codepoint;
+}
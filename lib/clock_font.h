@@ -0,0 +1,181 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock font atlas. An atlas is a single binary blob which
+//        tools/bdf_atlas compiles from a BDF bitmap font. It is used in
+//        place, either memory-mapped from a file or linked in as a ROM_DATA
+//        table, so a loaded font takes no allocations at all.
+//
+//        All the numbers of an atlas are little-endian and unaligned:
+//
+//        offset  size
+//        0       4     magic "BCFA"
+//        4       1     version, CLOCK_FONT_VERSION
+//        5       1     height of the glyphs [ 1 <= height <= CLOCK_SCREEN_HEIGHT ]
+//        6       2     the number of glyphs
+//        8       2     the number of codepoint ranges
+//        10      2     the glyph which is shown for a codepoint missing in the font
+//        12      4     the number of column bytes
+//        16            ranges, 8 bytes each, sorted by codepoint:
+//                        4  the first codepoint of the range
+//                        2  the number of codepoints in the range
+//                        2  the glyph of the first codepoint
+//                      glyphs, 4 bytes each:
+//                        3  the offset of the first column of the glyph
+//                        1  width [ width <= CLOCK_SCREEN_WIDTH ]
+//                      columns, 1 byte each. Bit (7 - y) is row y, the
+//                      same as in ClockText columns
+//
+//        Consecutive codepoints share a range, so a codepoint is found with
+//        a binary search over the ranges and a single subtraction.
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_FONT_H
+#define BINARY_CLOCK_LIB_CLOCK_FONT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CLOCK_FONT_MAGIC        "BCFA"
+#define CLOCK_FONT_VERSION      1U
+
+#define CLOCK_FONT_HEADER_SIZE  16U
+#define CLOCK_FONT_RANGE_SIZE   8U
+#define CLOCK_FONT_GLYPH_SIZE   4U
+
+//
+// The codepoint which a malformed UTF-8 sequence decodes to
+//
+#define CLOCK_FONT_REPLACEMENT  0xfffdUL
+
+typedef struct {
+    const unsigned char *ranges;        // point into the atlas
+    const unsigned char *glyphs;
+    const unsigned char *columns;
+    unsigned int         height;
+    unsigned int         glyphCount;
+    unsigned int         rangeCount;
+    unsigned int         defaultGlyph;
+    uint32_t             columnsSize;
+    void                *mapping;       // set by clock_font_map()
+    size_t               mappingSize;
+} ClockFont;
+
+//
+// clock.h is included after ClockFont, because the headers which it
+// includes use ClockFont too
+//
+#include "clock.h"
+
+//
+// @brief loads a font from an atlas. The atlas is validated once and then
+//        used in place, so it should outlive the font
+// @param font
+// @param atlas the atlas, which may be a ROM_DATA table
+// @param size the size of _atlas_ in bytes
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _atlas_ is NULL
+//          if _atlas_ is not a valid atlas of CLOCK_FONT_VERSION
+//
+int clock_font_load(ClockFont *font, const unsigned char *atlas, size_t size);
+
+#ifndef __AVR__
+//
+// @brief memory-maps an atlas file and loads a font from it
+// @param font
+// @param path
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _path_ is NULL
+//          if the file is not a valid atlas
+// an error of open(), fstat() or mmap() otherwise
+//
+int clock_font_map(ClockFont *font, const char *path);
+
+//
+// @brief unmaps a font which was loaded with clock_font_map()
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _font_ was not loaded with clock_font_map()
+//
+int clock_font_unmap(ClockFont *font);
+#endif
+
+//
+// @brief finds the glyph of a codepoint
+// @param font
+// @param codepoint
+// @param glyph the glyph will be written here or font->defaultGlyph if the
+//        font has no glyph for _codepoint_
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _glyph_ is NULL
+//
+int clock_font_findGlyph(const ClockFont *font, uint32_t codepoint, unsigned int *glyph);
+
+//
+// @brief gets the columns of a glyph
+// @param font
+// @param glyph [ glyph < font->glyphCount ]
+// @param columns the first column of the glyph will be written here. It
+//        points into the atlas, so it has to be read with romReadByte()
+// @param width the number of columns will be written here
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _columns_ is NULL
+//          if _width_ is NULL
+// ERANGE - if _glyph_ is out of range
+//
+int clock_font_getGlyph(const ClockFont *font, unsigned int glyph, const unsigned char **columns, unsigned int *width);
+
+//
+// @brief gets a glyph as a frame. The glyph takes the leftmost columns of
+//        the frame and the rest of them are blank
+// @warning _font_ and _glyph_ are not checked
+//
+ClockFrame clock_font_getGlyphFrame(const ClockFont *font, unsigned int glyph);
+
+//
+// @brief decodes the next codepoint of a UTF-8 string. A stray or a truncated
+//        sequence decodes to CLOCK_FONT_REPLACEMENT and only its first byte
+//        is skipped. An overlong sequence or a surrogate decodes to
+//        CLOCK_FONT_REPLACEMENT as a whole
+// @param text the string. It is advanced past the codepoint, unless the
+//        end of the string is reached
+// @returns the codepoint or 0 at the end of the string
+// @warning _text_ is not checked
+//
+uint32_t clock_font_decodeUtf8(const char **text);
+
+//
+// @brief sets the font which clock_slideText() and the text of the clock
+//        states use
+// @param font a loaded font or NULL to use the built-in alphabet. The font
+//        should outlive the calls to clock_slideText()
+//
+void clock_setFont(const ClockFont *font);
+
+//
+// @brief gets the font which clock_slideText() uses
+// @returns the font or NULL if the built-in alphabet is used
+//
+const ClockFont *clock_getFont(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
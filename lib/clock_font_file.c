@@ -0,0 +1,126 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock font atlas files. An atlas file is memory-mapped, so
+//        its pages are shared and loaded on demand. There are no files on
+//        AVR, where an atlas is a ROM_DATA table instead.
+//
+
+#ifndef __AVR__
+
+#ifdef PARAM_CHECKS
+#include <logger.h>
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "clock_font.h"
+
+//
+// @brief memory-maps an atlas file and loads a font from it
+// @param font
+// @param path
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _path_ is NULL
+//          if the file is not a valid atlas
+// an error of open(), fstat() or mmap() otherwise
+//
+int clock_font_map(ClockFont *font, const char *path)
+{
+    NullCheck(font);
+    NullCheck(path);
+
+    struct stat st;
+    int error = 0;
+    void *mapping = MAP_FAILED;
+
+    int fd = open(path, O_RDONLY);
+    if(fd == -1) {
+        error = errno;
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(error, "%d", "open('%s') failed: %s", path, strerror(error));
+#else
+        return error;
+#endif
+    }
+
+    if(fstat(fd, &st) == -1) {
+        error = errno;
+    } else if(st.st_size == 0) {
+        error = EINVAL;
+    } else {
+        mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if(mapping == MAP_FAILED) error = errno;
+    }
+
+    //
+    // The mapping keeps the file, so the descriptor is not needed anymore
+    //
+    close(fd);
+
+    if(error) {
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(error, "%d", "mapping '%s' failed: %s", path, strerror(error));
+#else
+        return error;
+#endif
+    }
+
+    error = clock_font_load(font, (const unsigned char *)mapping, (size_t)st.st_size);
+    if(error) {
+        munmap(mapping, (size_t)st.st_size);
+#ifdef PARAM_CHECKS
+        ContinueErrorEx(error, "%d", "'%s' is not a font atlas", path);
+#else
+        return error;
+#endif
+    }
+
+    font->mapping     = mapping;
+    font->mappingSize = (size_t)st.st_size;
+
+    return 0;
+}
+
+//
+// @brief unmaps a font which was loaded with clock_font_map()
+// @returns 0 on success
+// EINVAL - if _font_ is NULL
+//          if _font_ was not loaded with clock_font_map()
+//
+int clock_font_unmap(ClockFont *font)
+{
+    NullCheck(font);
+
+    if(font->mapping == NULL) {
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(EINVAL, "%d", "the font is not mapped");
+#else
+        return EINVAL;
+#endif
+    }
+
+    munmap(font->mapping, font->mappingSize);
+    memset(font, 0, sizeof(ClockFont));
+
+    return 0;
+}
+
+#endif
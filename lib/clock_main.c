@@ -35,15 +35,16 @@
 //
 
 #ifdef PARAM_CHECKS
-#include <errno.h>
 #include <logger.h>
 #endif
 
+#include <errno.h>
 #include <string.h>
 
 #include "clock_event.h"
 #include "clock_extern.h"
 #include "clock_main.h"
+#include "clock_messages.h"
 #include "clock_time.h"
 
 //
@@ -55,6 +56,22 @@
 #define CLOCK_ANIMATION_TEXT_STEP_TIME                   70U
 #define CLOCK_ANIMATION_BLINK_BINARY_NUMBER_STEP_TIME   200U
 
+//
+// The date order of ClockEvents and their dates of the recently used years,
+// see ClockEventList and ClockEventCalendar
+//
+static ClockEventIndex    ClockEventsOrder[CLOCK_EVENTS_SIZE];
+static ClockEventCalendar ClockEventsCalendar;
+static ClockEventDate     ClockEventsDates[CLOCK_EVENT_CALENDAR_YEARS * CLOCK_EVENTS_SIZE];
+
+//
+// The day index of ClockEvents. It takes CLOCK_EVENT_DAY_INDEX_SIZE indexes,
+// which is more RAM than an AVR has to spare, so it is only kept elsewhere
+//
+#ifndef __AVR__
+static ClockEventDayIndex ClockEventsDayIndex;
+#endif
+
 //
 // @brief Updates step time such that the function will be finished immediately
 // if clockState->stepMillis hasn't reached _stepAnimationMillis_ yet. Otherwise
@@ -74,6 +91,21 @@
 #define blinkBinaryNumber(dateTimeValue, zeroValue) { \
     dateTimeValue = (dateTimeValue == zeroValue ? (zeroValue) + (CLOCK_MAX_BINARY_NUMBER) : zeroValue); }
 
+//
+// @brief Clears the screen with a transition from the current frame
+//        to the first frame of the next state
+// @param clockState a pointer to ClockState
+//
+#define beginTransition(clockState) { \
+    if(clockState->panel != NULL || clockState->transition.type == CLOCK_TRANSITION_NONE) { \
+        clock_clearScreen(); \
+    } else { \
+        Call(clock_beginTransition(clockState->transition.type)); \
+        clockState->transition.millis   = 0; \
+        clockState->transition.isActive = TRUE; \
+    } \
+}
+
 //
 // @brief Sets the clock state
 // @param clockState a pointer to ClockState
@@ -81,12 +113,13 @@
 // @param nextStepMillis if the next step has animation step time, this should be set to that value, so
 //        that the first frame will be shown immediately
 // @param doClearScreen if true the clock screen will be first cleared
+//        (see beginTransition())
 //
 #define setClockState(clockState, nextState, nextStepMillis, doClearScreen) { \
     clockState->step  = 0; \
     clockState->state = nextState; \
     clockState->stepMillis = nextStepMillis; \
-    if(doClearScreen) { clock_clearScreen(); } \
+    if(doClearScreen) { beginTransition(clockState); } \
 }
 
 //
@@ -119,31 +152,20 @@
     } \
 }
 
-//
-// This text will be shown at clock_state_hello
-//
-static const char StateHelloText[] = "BinaryClock by sealemar v."
-                                     TOSTRING(VERSION_MAJOR) "."
-                                     TOSTRING(VERSION_MINOR) "."
-                                     TOSTRING(VERSION_FIX)
-                                     " \001 ";
-
-static const char NoEventsStr[] = " No events \002 ";
-
 //
 // @brief a callback function for slideText()
 //
 static int showEventsSlideTextCompletesCallback(ClockState *clockState)
 {
-    if( (size_t)clockState->events.index == clockState->events.size - 1) {
+    if( (size_t)clockState->events.index == clockState->events.list.size - 1) {
         clockState->events.index = 0;
     } else {
         ++(clockState->events.index);
     }
 
     int index;
-    Call( clock_event_findClosestFromList(clockState->events.ptr, clockState->events.size,
-                                            clockState->dateTime.month, clockState->dateTime.day,
+    Call( clock_event_findClosestFromList(&(clockState->events.list),
+                                            clockState->time.dateTime.month, clockState->time.dateTime.day,
                                             &index ) );
 
     if(clockState->events.index == index) {
@@ -158,7 +180,9 @@ static int showEventsSlideTextCompletesCallback(ClockState *clockState)
 //
 // @brief A helper function to slide a text
 // @param clockState
-// @param text a text to slide
+// @param text a text to slide or NULL if _packed_ is given
+// @param nextText an optional plain text which slides right after _text_ or NULL
+// @param packed a packed text to slide (see clock_packed.h) or NULL if _text_ is given
 // @param nextState which state should be the next after the text sliding is finished
 // @param nextStepMillis if the next step has animation step time, this should be set to that value, so
 //        that the first frame will be shown immediately
@@ -171,18 +195,58 @@ static int showEventsSlideTextCompletesCallback(ClockState *clockState)
 static int slideText(
         ClockState *clockState,
         const char *text,
+        const char *nextText,
+        const unsigned char *packed,
         unsigned int nextState,
         unsigned int nextStepMillis,
         int (* callback)(ClockState *clockState))
 {
     updateStepTime(clockState, CLOCK_ANIMATION_TEXT_STEP_TIME);
 
-    unsigned char pattern[CLOCK_PATTERN_SIZE];
+    //
+    // The text is compiled column by column as it slides, so that it takes
+    // no memory for a strip and a packed text is never unpacked. Narrow
+    // glyphs take fewer columns, so the text slides through faster.
+    // The frames of the constant messages are generated at build time, so
+    // they are not compiled at all, unless a font is set with clock_setFont().
+    // A panel slides a whole strip, so it needs _textStrip_.
+    //
+    if(clockState->step == 0) {
+        const ClockFont *font = clock_getFont();
+
+        clockState->cachedText = NULL;
+        if(clockState->panel == NULL && font == NULL && packed != NULL) {
+            Call(clock_cache_find(ClockMessages, ClockMessagesCount, packed, &(clockState->cachedText)));
+        }
+
+        if(clockState->cachedText == NULL) {
+            Call(clock_text_openStream(&(clockState->textStream), text, packed, font, CLOCK_TEXT_DEFAULT_SPACING));
+            if(nextText != NULL) {
+                Call(clock_text_continueStream(&(clockState->textStream), nextText));
+            }
+        }
+
+        if(clockState->panel != NULL) {
+            NullCheck(clockState->textStrip);
+            Call(clock_text_prepareStream(clockState->textStrip, &(clockState->textStream)));
+        }
+    }
+
     Bool isLastStep;
 
-    Call(clock_slideText(text, clockState->step, &isLastStep, pattern));
+    if(clockState->panel != NULL) {
+        Call(clock_panel_slideText(clockState->panel, clockState->textStrip, clockState->step, &isLastStep));
+        Call(clock_panel_draw(clockState->panel));
+    } else {
+        ClockFrame frame;
 
-    Call(clock_drawPattern(pattern));
+        if(clockState->cachedText != NULL) {
+            Call(clock_cache_getFrame(clockState->cachedText, clockState->step, &isLastStep, &frame));
+        } else {
+            Call(clock_text_streamWindow(&(clockState->textStream), &isLastStep, &frame));
+        }
+        Call(clock_drawFrame(frame));
+    }
 
     if(!isLastStep) {
         ++(clockState->step);
@@ -202,7 +266,7 @@ static int clock_state_hello(ClockState *clockState)
     checkButton(clockState, CLOCK_BUTTON_SET,
                 CLOCK_STATE_SHOW_TIME, 0, TRUE);
 
-    Call(slideText(clockState, StateHelloText, CLOCK_STATE_SHOW_TIME, 0, NULL));
+    Call(slideText(clockState, NULL, NULL, ClockMessageHello, CLOCK_STATE_SHOW_TIME, 0, NULL));
 
     return 0;
 }
@@ -224,15 +288,21 @@ static int clock_state_showTime(ClockState *clockState)
     //
     // Show time
     //
-    const DateTime *dt    = &(clockState->dateTime);
-    const DateTime *oldDt = &(clockState->oldDateTime);
-
-    if(clockState->step == 0
-    || dt->second != oldDt->second
-    || dt->minute != oldDt->minute
-    || dt->hour   != oldDt->hour) {
+    // The whole face is drawn once, then only the bars which have
+    // changed since the last update are redrawn. A panel is redrawn
+    // whenever the face changes
+    //
+    if(clockState->panel != NULL) {
+        if(clockState->step == 0 || (clockState->changed & DATE_TIME_TIME_CHANGED)) {
+            clockState->step = 1;
+            Call(clock_panel_putTime(clockState->panel, &(clockState->time.dateTime)));
+            Call(clock_panel_draw(clockState->panel));
+        }
+    } else if(clockState->step == 0) {
         clockState->step = 1;
-        Call(clock_displayTime(&(clockState->dateTime)));
+        Call(clock_displayTime(&(clockState->time.dateTime)));
+    } else {
+        Call(clock_updateTime(&(clockState->time.dateTime), clockState->changed));
     }
     return 0;
 }
@@ -254,15 +324,21 @@ static int clock_state_showDate(ClockState *clockState)
     //
     // Show date
     //
-    const DateTime *dt    = &(clockState->dateTime);
-    const DateTime *oldDt = &(clockState->oldDateTime);
-
-    if(clockState->step == 0
-    || dt->day   != oldDt->day
-    || dt->month != oldDt->month
-    || dt->year  != oldDt->year) {
+    // The whole face is drawn once, then only the bars which have
+    // changed since the last update are redrawn. A panel is redrawn
+    // whenever the face changes
+    //
+    if(clockState->panel != NULL) {
+        if(clockState->step == 0 || (clockState->changed & DATE_TIME_DATE_CHANGED)) {
+            clockState->step = 1;
+            Call(clock_panel_putDate(clockState->panel, &(clockState->time.dateTime)));
+            Call(clock_panel_draw(clockState->panel));
+        }
+    } else if(clockState->step == 0) {
         clockState->step = 1;
-        Call(clock_displayDate(&(clockState->dateTime)));
+        Call(clock_displayDate(&(clockState->time.dateTime)));
+    } else {
+        Call(clock_updateDate(&(clockState->time.dateTime), clockState->changed));
     }
     return 0;
 }
@@ -283,10 +359,10 @@ static int clock_state_showTimeBigEndian(ClockState *clockState)
     //
     if(clockState->step == 0) {
         clockState->text[0] = ' ';
-        Call(date_time_timeToStr( &(clockState->dateTime), clockState->text + 1 ));
+        Call(date_time_timeToStr( &(clockState->time.dateTime), clockState->text + 1 ));
     }
 
-    Call(slideText(clockState, clockState->text, CLOCK_STATE_SHOW_TIME, 0, NULL));
+    Call(slideText(clockState, clockState->text, NULL, NULL, CLOCK_STATE_SHOW_TIME, 0, NULL));
 
     return 0;
 }
@@ -307,10 +383,10 @@ static int clock_state_showDateBigEndian(ClockState *clockState)
     //
     if(clockState->step == 0) {
         clockState->text[0] = ' ';
-        Call(date_time_dateToStr( &(clockState->dateTime), clockState->text + 1 ));
+        Call(date_time_dateToStr( &(clockState->time.dateTime), clockState->text + 1 ));
     }
 
-    Call(slideText(clockState, clockState->text, CLOCK_STATE_SHOW_DATE, 0, NULL));
+    Call(slideText(clockState, clockState->text, NULL, NULL, CLOCK_STATE_SHOW_DATE, 0, NULL));
 
     return 0;
 }
@@ -328,25 +404,31 @@ static int clock_state_setTime(ClockState *clockState)
         }
     }
 
-    DateTime *dt = &(clockState->dateTime);
+    //
+    // The fields are changed on a copy, so that setting the clock finds which of them changed
+    //
+    DateTime dt;
+    memcpy(&dt, &(clockState->time.dateTime), sizeof(dt));
+    Bool wasChanged = FALSE;
 
     //
     // Decrease selected time
     //
     if(clock_button_wasClicked(clockState->buttons, CLOCK_BUTTON_LEFT)) {
         if(clockState->step == 0 || clockState->step == 1) {
-            --(dt->hour);
-            if(dt->hour < 0) {
-                dt->hour = HOURS_COUNT - 1;
+            --(dt.hour);
+            if(dt.hour < 0) {
+                dt.hour = HOURS_COUNT - 1;
             }
         } else if(clockState->step == 2 || clockState->step == 3) {
-            --(dt->minute);
-            if(dt->minute < 0) {
-                dt->minute = 59;
+            --(dt.minute);
+            if(dt.minute < 0) {
+                dt.minute = 59;
             }
         } else if(clockState->step == 4 || clockState->step == 5) {
-            dt->second = 0;
+            dt.second = 0;
         }
+        wasChanged = TRUE;
     }
 
     //
@@ -354,18 +436,29 @@ static int clock_state_setTime(ClockState *clockState)
     //
     else if(clock_button_wasClicked(clockState->buttons, CLOCK_BUTTON_RIGHT)) {
         if(clockState->step == 0 || clockState->step == 1) {
-            ++(dt->hour);
-            if(dt->hour >= HOURS_COUNT) {
-                dt->hour = 0;
+            ++(dt.hour);
+            if(dt.hour >= HOURS_COUNT) {
+                dt.hour = 0;
             }
         } else if(clockState->step == 2 || clockState->step == 3) {
-            ++(dt->minute);
-            if(dt->minute >= 60) {
-                dt->hour = 60;
+            ++(dt.minute);
+            if(dt.minute >= 60) {
+                dt.minute = 0;
             }
         } else if(clockState->step == 4 || clockState->step == 5) {
-            dt->second = 30;
+            dt.second = 30;
         }
+        wasChanged = TRUE;
+    }
+
+    //
+    // The clock goes on from the new time
+    //
+    if(wasChanged) {
+        unsigned int changed;
+
+        Call(date_time_clock_set(&(clockState->time), &dt, &changed));
+        clockState->changed |= changed;
     }
 
     //
@@ -377,7 +470,7 @@ static int clock_state_setTime(ClockState *clockState)
     // step 2,3 - blink minutes
     // step 4,5 - blink seconds
     DateTime tempDt;
-    memcpy(&tempDt, dt, sizeof(tempDt));
+    memcpy(&tempDt, &(clockState->time.dateTime), sizeof(tempDt));
     switch(clockState->step) {
         case 0: blinkBinaryNumber(tempDt.hour, 0); clockState->step = 1; break;
         case 1: clockState->step = 0; break;
@@ -411,7 +504,11 @@ static int clock_state_setDate(ClockState *clockState)
         }
     }
 
-    DateTime *dt = &(clockState->dateTime);
+    //
+    // The fields are changed on a copy, so that setting the clock finds which of them changed
+    //
+    DateTime dt;
+    memcpy(&dt, &(clockState->time.dateTime), sizeof(dt));
     Bool wasChanged = FALSE;
 
     //
@@ -419,24 +516,24 @@ static int clock_state_setDate(ClockState *clockState)
     //
     if(clock_button_wasClicked(clockState->buttons, CLOCK_BUTTON_LEFT)) {
         if(clockState->step == 0 || clockState->step == 1) {
-            --(dt->month);
-            if(dt->month < JANUARY) {
-                dt->month = DECEMBER;
+            --(dt.month);
+            if(dt.month < JANUARY) {
+                dt.month = DECEMBER;
             }
-            adjustDays(clockState->dateTime);
+            adjustDays(dt);
         } else if(clockState->step == 2 || clockState->step == 3) {
-            --(dt->day);
-            if(dt->day < 1) {
+            --(dt.day);
+            if(dt.day < 1) {
                 int d;
-                Call(date_time_daysInMonth(dt->year, dt->month, &d));
-                dt->day = d;
+                Call(date_time_daysInMonth(dt.year, dt.month, &d));
+                dt.day = d;
             }
         } else if(clockState->step == 4 || clockState->step == 5) {
-            --(dt->year);
-            if(dt->year < MIN_YEAR) {
-                dt->year = MAX_YEAR;
+            --(dt.year);
+            if(dt.year < MIN_YEAR) {
+                dt.year = MAX_YEAR;
             }
-            adjustDays(clockState->dateTime);
+            adjustDays(dt);
         }
         wasChanged = TRUE;
     }
@@ -446,24 +543,24 @@ static int clock_state_setDate(ClockState *clockState)
     //
     else if(clock_button_wasClicked(clockState->buttons, CLOCK_BUTTON_RIGHT)) {
         if(clockState->step == 0 || clockState->step == 1) {
-            ++(dt->month);
-            if(dt->month > DECEMBER) {
-                dt->month = JANUARY;
+            ++(dt.month);
+            if(dt.month > DECEMBER) {
+                dt.month = JANUARY;
             }
-            adjustDays(clockState->dateTime);
+            adjustDays(dt);
         } else if(clockState->step == 2 || clockState->step == 3) {
-            ++(dt->day);
+            ++(dt.day);
             int d;
-            Call(date_time_daysInMonth(dt->year, dt->month, &d));
-            if(dt->day > d) {
-                dt->day = 1;
+            Call(date_time_daysInMonth(dt.year, dt.month, &d));
+            if(dt.day > d) {
+                dt.day = 1;
             }
         } else if(clockState->step == 4 || clockState->step == 5) {
-            ++(dt->year);
-            if(dt->year > MAX_YEAR) {
-                dt->year = MIN_YEAR;
+            ++(dt.year);
+            if(dt.year > MAX_YEAR) {
+                dt.year = MIN_YEAR;
             }
-            adjustDays(clockState->dateTime);
+            adjustDays(dt);
         }
         wasChanged = TRUE;
     }
@@ -472,10 +569,15 @@ static int clock_state_setDate(ClockState *clockState)
     // Update events
     //
     if(wasChanged) {
-        if(clockState->dateTime.year != clockState->oldDateTime.year) {
-            Call( clock_event_initList(clockState->events.ptr, clockState->events.size, clockState->dateTime.year) );
+        unsigned int changed;
+
+        Call(date_time_clock_set(&(clockState->time), &dt, &changed));
+        clockState->changed |= changed;
+
+        if(changed & DATE_TIME_YEAR_CHANGED) {
+            Call( clock_event_initList(&(clockState->events.list), clockState->time.dateTime.year) );
         }
-        Call( clock_event_updateList(clockState->events.ptr, clockState->events.size, &(clockState->dateTime) ) );
+        Call( clock_event_updateList(&(clockState->events.list), &(clockState->time.dateTime) ) );
     }
 
     //
@@ -487,7 +589,7 @@ static int clock_state_setDate(ClockState *clockState)
     // step 2,3 - blink days
     // step 4,5 - blink years
     DateTime tempDt;
-    memcpy(&tempDt, dt, sizeof(tempDt));
+    memcpy(&tempDt, &(clockState->time.dateTime), sizeof(tempDt));
     switch(clockState->step) {
         case 0: tempDt.month = -1; clockState->step = 1; break;
         case 1: clockState->step = 0; break;
@@ -510,11 +612,11 @@ static int clock_state_setDate(ClockState *clockState)
 
 static int clock_state_showEvents(ClockState *clockState)
 {
-    NullCheck(clockState->events.ptr);
+    NullCheck(clockState->events.list.events);
 
 #ifdef PARAM_CHECKS
-    if(clockState->events.size == 0) {
-        OriginateErrorEx(EINVAL, "%d", "clockState->events.size is zero");
+    if(clockState->events.list.size == 0) {
+        OriginateErrorEx(EINVAL, "%d", "clockState->events.list.size is zero");
     }
 #endif
 
@@ -522,8 +624,8 @@ static int clock_state_showEvents(ClockState *clockState)
     // Look up the next closest event
     //
     if(clockState->events.index == CLOCK_EVENT_INDEX_LOOKUP) {
-        Call( clock_event_findClosestFromList(clockState->events.ptr, clockState->events.size,
-                                              clockState->dateTime.month, clockState->dateTime.day,
+        Call( clock_event_findClosestFromList(&(clockState->events.list),
+                                              clockState->time.dateTime.month, clockState->time.dateTime.day,
                                               &(clockState->events.index) ) );
     }
 
@@ -547,7 +649,7 @@ static int clock_state_showEvents(ClockState *clockState)
     //
     if(clock_button_wasClicked(clockState->buttons, CLOCK_BUTTON_LEFT)) {
         if(clockState->events.index == 0) {
-            clockState->events.index = clockState->events.size - 1;
+            clockState->events.index = clockState->events.list.size - 1;
         } else {
             --(clockState->events.index);
         }
@@ -559,7 +661,7 @@ static int clock_state_showEvents(ClockState *clockState)
     // Next event
     //
     if(clock_button_wasClicked(clockState->buttons, CLOCK_BUTTON_RIGHT)) {
-        if( (size_t)clockState->events.index == clockState->events.size - 1) {
+        if( (size_t)clockState->events.index == clockState->events.list.size - 1) {
             clockState->events.index = 0;
         } else {
             ++(clockState->events.index);
@@ -569,29 +671,39 @@ static int clock_state_showEvents(ClockState *clockState)
     }
 
     //
-    // Show event
+    // Show event. The message of no events slides straight from its packed table
+    //
+    if(clockState->events.list.size == 0) {
+        Call(slideText(clockState, NULL, NULL, ClockMessageNoEvents, 0, 0, showEventsSlideTextCompletesCallback));
+        return 0;
+    }
+
     //
+    // Only the date is printed. The name follows it straight from the list,
+    // so that it is never copied to RAM
+    //
+    const ClockEvent *event = &clock_event_listAt(&(clockState->events.list), clockState->events.index);
+
     if(clockState->step == 0) {
-        if(clockState->events.size == 0) {
-            strcpy(clockState->text, NoEventsStr);
-        } else {
-            clockState->text[0] = ' ';
-            Call( clock_event_toStr( &(clockState->events.ptr[clockState->events.index]), clockState->text + 1) );
-        }
+        const DateTime dt = date_time_initDate(event->yearCalculated, clock_event_getMonth(*event), clock_event_getDayOfMonth(*event));
+
+        clockState->text[0] = ' ';
+        Call( date_time_dateToStr(&dt, clockState->text + 1) );
+        strcat(clockState->text, " - ");
     }
 
-    Call(slideText(clockState, clockState->text, 0, 0, showEventsSlideTextCompletesCallback));
+    Call(slideText(clockState, clockState->text, event->name, NULL, 0, 0, showEventsSlideTextCompletesCallback));
 
     return 0;
 }
 
 static int clock_state_showEventYearInfo(ClockState *clockState)
 {
-    NullCheck(clockState->events.ptr);
+    NullCheck(clockState->events.list.events);
 
 #ifdef PARAM_CHECKS
-    if(clockState->events.size == 0) {
-        OriginateErrorEx(EINVAL, "%d", "clockState->events.size is zero");
+    if(clockState->events.list.size == 0) {
+        OriginateErrorEx(EINVAL, "%d", "clockState->events.list.size is zero");
     }
 #endif
 
@@ -599,8 +711,8 @@ static int clock_state_showEventYearInfo(ClockState *clockState)
     // Look up the next closest event
     //
     if(clockState->events.index == CLOCK_EVENT_INDEX_LOOKUP) {
-        Call( clock_event_findClosestFromList(clockState->events.ptr, clockState->events.size,
-                                              clockState->dateTime.month, clockState->dateTime.day,
+        Call( clock_event_findClosestFromList(&(clockState->events.list),
+                                              clockState->time.dateTime.month, clockState->time.dateTime.day,
                                               &(clockState->events.index) ) );
     }
 
@@ -613,16 +725,17 @@ static int clock_state_showEventYearInfo(ClockState *clockState)
     //
     // Show event year information
     //
+    if(clockState->events.list.size == 0) {
+        Call(slideText(clockState, NULL, NULL, ClockMessageNoEvents, CLOCK_STATE_SHOW_EVENTS, CLOCK_ANIMATION_TEXT_STEP_TIME, NULL));
+        return 0;
+    }
+
     if(clockState->step == 0) {
-        if(clockState->events.size == 0) {
-            strcpy(clockState->text, NoEventsStr);
-        } else {
-            clockState->text[0] = ' ';
-            Call( clock_event_yearInfoToStr( &(clockState->events.ptr[clockState->events.index]), clockState->text + 1) );
-        }
+        clockState->text[0] = ' ';
+        Call( clock_event_yearInfoToStr( &clock_event_listAt(&(clockState->events.list), clockState->events.index), clockState->text + 1) );
     }
 
-    Call(slideText(clockState, clockState->text, CLOCK_STATE_SHOW_EVENTS, CLOCK_ANIMATION_TEXT_STEP_TIME, NULL));
+    Call(slideText(clockState, clockState->text, NULL, NULL, CLOCK_STATE_SHOW_EVENTS, CLOCK_ANIMATION_TEXT_STEP_TIME, NULL));
 
     return 0;
 }
@@ -656,30 +769,165 @@ int clock_init(ClockState *clockState)
     memset(clockState, 0, sizeof(ClockState));
 
     //
-    // Init clockState->dateTime
+    // Init clockState->time
     //
+    DateTime dt = date_time_initDate(0, JANUARY, 1);
+
     if(clock_extern_initDateTime != NULL) {
-        Call( clock_extern_initDateTime( &(clockState->dateTime) ) );
-        memcpy( &(clockState->oldDateTime), &(clockState->dateTime), sizeof(DateTime) );
-    } else {
-        clockState->dateTime.day    = 1;
-        clockState->oldDateTime.day = 1;
+        Call( clock_extern_initDateTime(&dt) );
     }
 
+    Call( date_time_clock_set(&(clockState->time), &dt, NULL) );
+    clockState->changed = DATE_TIME_ALL_CHANGED;
+
     unsigned long millis;
     Call( clock_extern_uptimeMillis(&millis) );
     Call( clock_updateUptimeMillis(millis, &(clockState->lastUptime), &millis) );
 
-    clockState->events.ptr   = ClockEvents;
-    clockState->events.size  = CLOCK_EVENTS_SIZE;
+    clockState->transition.type = CLOCK_TRANSITION_DISSOLVE;
+
+    ClockEventList events;
+    Call( clock_event_setList(&events, ClockEvents, ClockEventsOrder, CLOCK_EVENTS_SIZE) );
+    Call( clock_event_setCalendar(&events, &ClockEventsCalendar, ClockEventsDates) );
+    Call( clock_setEvents(clockState, &events) );
+
+    return 0;
+}
+
+//
+// @brief sets the events which the clock shows, i.e. the events of a database
+//        set to a list with clock_event_db_setList(). The list is initialized
+//        for the current date of the clock
+// @param clockState a structure which holds the entire state of the clock
+// @param list a list bound with clock_event_setList(). Its arrays should
+//        outlive the clock or the next clock_setEvents()
+// @returns 0 on success
+// EINVAL - if clockState is NULL
+//          if list is NULL
+//
+// @note clock_init() sets ClockEvents. Use clock_publishEvents() after clock_update()
+//       was called
+//
+int clock_setEvents(ClockState *clockState, const ClockEventList *list)
+{
+    NullCheck(clockState);
+    NullCheck(list);
+
+    clockState->events.list  = *list;
     clockState->events.index = CLOCK_EVENT_INDEX_LOOKUP;
 
-    Call( clock_event_initList(clockState->events.ptr, clockState->events.size, clockState->dateTime.year) );
-    Call( clock_event_updateList(clockState->events.ptr, clockState->events.size, &(clockState->dateTime) ) );
+    Call( clock_event_initList(&(clockState->events.list), clockState->time.dateTime.year) );
+#ifndef __AVR__
+    Call( clock_event_setDayIndex(&(clockState->events.list), &ClockEventsDayIndex) );
+#endif
+    Call( clock_event_updateList(&(clockState->events.list), &(clockState->time.dateTime) ) );
+
+    return 0;
+}
+
+#ifndef __AVR__
+//
+// @brief publishes a list of events which replaces the shown one while the
+//        clock runs. The list is built off to the side: it is initialized and
+//        sorted for the current date of the clock here, so that clock_update()
+//        only swaps it in. It does that once no event text is being slid and
+//        retires the shown list then
+// @param clockState a structure which holds the entire state of the clock
+// @param list a list bound with clock_event_setList(), which the clock doesn't
+//        show. Set its calendar and day index before, if any. Its arrays
+//        should outlive the clock or the next swap
+// @returns 0 on success
+// EINVAL - if clockState is NULL
+//          if list is NULL
+// EBUSY  - if the last published list is not swapped in yet
+//          if the last retired list is not reclaimed yet
+//
+// @note publish the list in clockState->events.next again if the swap is
+//       CLOCK_EVENTS_SWAP_STALE
+//
+int clock_publishEvents(ClockState *clockState, ClockEventList *list)
+{
+    NullCheck(clockState);
+    NullCheck(list);
+
+    if(clockState->events.swap != CLOCK_EVENTS_SWAP_NONE && clockState->events.swap != CLOCK_EVENTS_SWAP_STALE) {
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(EBUSY, "%d", "the events swap %u is not complete", clockState->events.swap);
+#else
+        return EBUSY;
+#endif
+    }
+
+    Call( clock_event_initList(list, clockState->time.dateTime.year) );
+    Call( clock_event_updateList(list, &(clockState->time.dateTime) ) );
+
+    clockState->events.next = *list;
+    clockState->events.swap = CLOCK_EVENTS_SWAP_PUBLISHED;
+
+    return 0;
+}
+
+//
+// @brief hands the list which the last swap retired back. No event text comes
+//        from it anymore, so that its arrays may be released
+// @param clockState a structure which holds the entire state of the clock
+// @param retired the retired list will be written here
+// @param isRetired will be set to FALSE if no list was retired since the last call
+// @returns 0 on success
+// EINVAL - if clockState is NULL
+//          if retired is NULL
+//          if isRetired is NULL
+//
+int clock_reclaimEvents(ClockState *clockState, ClockEventList *retired, Bool *isRetired)
+{
+    NullCheck(clockState);
+    NullCheck(retired);
+    NullCheck(isRetired);
+
+    *isRetired = clockState->events.swap == CLOCK_EVENTS_SWAP_RETIRED;
+    if(*isRetired) {
+        *retired = clockState->events.retired;
+        clockState->events.swap = CLOCK_EVENTS_SWAP_NONE;
+    }
 
     return 0;
 }
 
+//
+// @brief swaps the published list of events in, unless an event text is
+//        being slid. The name of an event slides straight from the shown
+//        list, so that it is not swapped then. Once the text is gone, only
+//        the position of the shown event is used, which the year information
+//        of the event and the next event need
+// @note the list is only brought to the date of the clock with its cursor.
+//       If it needs more, it is left for the publisher, so that no list is
+//       sorted on the way to the screen
+//
+static int swapEvents(ClockState *clockState)
+{
+    if(clockState->state == CLOCK_STATE_SHOW_EVENT_YEAR_INFO
+    || (clockState->state == CLOCK_STATE_SHOW_EVENTS && clockState->step != 0)) {
+        return 0;
+    }
+
+    ClockEventList *next = &(clockState->events.next);
+    const DateTime *dt   = &(clockState->time.dateTime);
+
+    if(next->year != dt->year || next->month > dt->month || (next->month == dt->month && next->day > dt->day)) {
+        clockState->events.swap = CLOCK_EVENTS_SWAP_STALE;
+        return 0;
+    }
+    Call( clock_event_updateList(next, dt) );
+
+    clockState->events.retired = clockState->events.list;
+    clockState->events.list    = *next;
+    clockState->events.index   = CLOCK_EVENT_INDEX_LOOKUP;
+    clockState->events.swap    = CLOCK_EVENTS_SWAP_RETIRED;
+
+    return 0;
+}
+#endif
+
 //
 // @brief Call this function from the main loop
 // @param clockState a structure which holds the entire state of the clock
@@ -695,23 +943,44 @@ int clock_update(ClockState *clockState)
     unsigned long millis;
     Call(clock_extern_uptimeMillis(&millis));
     Call(clock_updateUptimeMillis(millis, &(clockState->lastUptime), &millis));
-    Call(date_time_addMillis(&(clockState->dateTime), millis));
+    date_time_clock_add(&(clockState->time), millis);
+    Call(date_time_clock_refresh(&(clockState->time), &(clockState->changed)));
 
     clockState->stepMillis += millis;
 
+    //
+    // A transition runs at the text animation pace on top of whatever
+    // the state draws
+    //
+    if(clockState->transition.isActive) {
+        clockState->transition.millis += millis;
+
+        if(clockState->transition.millis >= CLOCK_ANIMATION_TEXT_STEP_TIME) {
+            Bool isDone;
+
+            clockState->transition.millis %= CLOCK_ANIMATION_TEXT_STEP_TIME;
+            Call(clock_stepTransition(&isDone));
+            clockState->transition.isActive = !isDone;
+        }
+    }
+
 #ifdef PARAM_CHECKS
     if(clockState->state >= countof(ClockStateFunctionMap)) {
         OriginateErrorEx(EINVAL, "%d", "clockState->state = %u is not implemented", clockState->state);
     }
 #endif
 
-    if(clockState->dateTime.day != clockState->oldDateTime.day) {
-        Call( clock_event_updateList(clockState->events.ptr, clockState->events.size, &(clockState->dateTime) ) );
+    if(clockState->changed & DATE_TIME_DATE_CHANGED) {
+        Call( clock_event_updateList(&(clockState->events.list), &(clockState->time.dateTime) ) );
     }
 
-    Call(ClockStateFunctionMap[clockState->state](clockState));
+#ifndef __AVR__
+    if(clockState->events.swap == CLOCK_EVENTS_SWAP_PUBLISHED) {
+        Call( swapEvents(clockState) );
+    }
+#endif
 
-    memcpy(&(clockState->oldDateTime), &(clockState->dateTime), sizeof(DateTime));
+    Call(ClockStateFunctionMap[clockState->state](clockState));
 
     return 0;
 }
@@ -50,6 +50,58 @@ extern "C" {
 //
 int clock_init(ClockState *clockState);
 
+//
+// @brief sets the events which the clock shows, i.e. the events of a database
+//        set to a list with clock_event_db_setList(). The list is initialized
+//        for the current date of the clock
+// @param clockState a structure which holds the entire state of the clock
+// @param list a list bound with clock_event_setList(). Its arrays should
+//        outlive the clock or the next clock_setEvents()
+// @returns 0 on success
+// EINVAL - if clockState is NULL
+//          if list is NULL
+//
+// @note clock_init() sets ClockEvents. Use clock_publishEvents() after clock_update()
+//       was called
+//
+int clock_setEvents(ClockState *clockState, const ClockEventList *list);
+
+#ifndef __AVR__
+//
+// @brief publishes a list of events which replaces the shown one while the
+//        clock runs. The list is built off to the side: it is initialized and
+//        sorted for the current date of the clock here, so that clock_update()
+//        only swaps it in. It does that once no event text is being slid and
+//        retires the shown list then
+// @param clockState a structure which holds the entire state of the clock
+// @param list a list bound with clock_event_setList(), which the clock doesn't
+//        show. Set its calendar and day index before, if any. Its arrays
+//        should outlive the clock or the next swap
+// @returns 0 on success
+// EINVAL - if clockState is NULL
+//          if list is NULL
+// EBUSY  - if the last published list is not swapped in yet
+//          if the last retired list is not reclaimed yet
+//
+// @note publish the list in clockState->events.next again if the swap is
+//       CLOCK_EVENTS_SWAP_STALE
+//
+int clock_publishEvents(ClockState *clockState, ClockEventList *list);
+
+//
+// @brief hands the list which the last swap retired back. No event text comes
+//        from it anymore, so that its arrays may be released
+// @param clockState a structure which holds the entire state of the clock
+// @param retired the retired list will be written here
+// @param isRetired will be set to FALSE if no list was retired since the last call
+// @returns 0 on success
+// EINVAL - if clockState is NULL
+//          if retired is NULL
+//          if isRetired is NULL
+//
+int clock_reclaimEvents(ClockState *clockState, ClockEventList *retired, Bool *isRetired);
+#endif
+
 //
 // @brief Call this function from the main loop
 // @param clockState a structure which holds the entire state of the clock
@@ -0,0 +1,112 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock constant messages and their sliding frames
+//
+// @warning generated by tools/gen_frames, do not edit. Run 'make frames'
+//          from the top directory instead
+//
+
+#include "clock_messages.h"
+
+//
+// CLOCK_MESSAGE_HELLO
+//
+const unsigned char ClockMessageHello[31] ROM_DATA = {
+    0xc2, 0xb4, 0x3b, 0x2c, 0xcf, 0x0f, 0xd9, 0xef, 0xf1, 0x1a, 0x24, 0xce,
+    0x83, 0xe6, 0xe5, 0x30, 0xbb, 0xdc, 0x0e, 0xcb, 0x41, 0x76, 0x57, 0xcc,
+    0x05, 0x73, 0xc5, 0x40, 0x01, 0x10, 0x00,
+};
+
+static const ClockFrame ClockMessageHelloFrames[169] ROM_DATA = {
+    0x00fb8989f19390e1ULL, 0x00f71212e22620c2ULL, 0x00ee2424c44c4084ULL, 0x00dd494989998008ULL,
+    0x00ba929213320010ULL, 0x0074242426650020ULL, 0x00e848484ccb0040ULL, 0x00d1919199960080ULL,
+    0x00a22222322c0000ULL, 0x0044454464580000ULL, 0x00898a89c8b10000ULL, 0x0013141390630000ULL,
+    0x0027282720c70000ULL, 0x004f514f418e0000ULL, 0x009ea29e821c0000ULL, 0x003d453d05390000ULL,
+    0x007a8a7a0b720000ULL, 0x00f414f416e50000ULL, 0x00e828e82ccb0000ULL, 0x00d050d059960000ULL,
+    0x00a0a0a0b22c0000ULL, 0x0040404165590000ULL, 0x01808182cab20000ULL, 0x0300030494640000ULL,
+    0x0700070828c80000ULL, 0x0e010f1151910000ULL, 0x1c021e22a2220000ULL, 0x38043d4545450100ULL,
+    0x70097a8a8a8a0201ULL, 0xe013f41414140403ULL, 0xc027e82828280807ULL, 0x804ed1505050110eULL,
+    0x009ca2a0a0a0221cULL, 0x0039444040404439ULL, 0x0073898181818973ULL, 0x00e71202020212e6ULL,
+    0x00ce2404040424ccULL, 0x009c490909084898ULL, 0x0039921212119030ULL, 0x0073242424232060ULL,
+    0x00e74848484740c0ULL, 0x00ce9191918e8080ULL, 0x009c2222221c0000ULL, 0x0038454545380000ULL,
+    0x00718a8a8a710000ULL, 0x00e3141414e30000ULL, 0x00c7282828c70000ULL, 0x008e5150508e0000ULL,
+    0x001ca2a0a01c0000ULL, 0x0039454141390101ULL, 0x00728a8382720202ULL, 0x00e4150605e40404ULL,
+    0x00c92a0c0ac90808ULL, 0x0092541814921010ULL, 0x0024a83028242020ULL, 0x0048506050484040ULL,
+    0x0090a0c0a0908080ULL, 0x0021418141210101ULL, 0x0043820283420202ULL, 0x0087040406850404ULL,
+    0x000f08080c0b0808ULL, 0x001e111119161010ULL, 0x003c2222322c2020ULL, 0x0078444565594040ULL,
+    0x01f0898acab28080ULL, 0x03e0131494640000ULL, 0x07c0272828c80000ULL, 0x0e814f5151910000ULL,
+    0x1c029ea2a2220000ULL, 0x38043c4444440000ULL, 0x7008788888880000ULL, 0xe010f01010100000ULL,
+    0xc021e02021200000ULL, 0x8043c04142410000ULL, 0x0087808384830000ULL, 0x000f000708070000ULL,
+    0x001e010e100f0000ULL, 0x003c021c201e0000ULL, 0x00780539413c0000ULL, 0x00f10a7382790000ULL,
+    0x00e314e704f30000ULL, 0x00c728cf08e70000ULL, 0x008e509f11ce0000ULL, 0x001ca03e229c0000ULL,
+    0x0038417c44380000ULL, 0x007182f988710000ULL, 0x00e304f310e30000ULL, 0x00c708e720c70000ULL,
+    0x008f11cf418e0000ULL, 0x001e229e821c0000ULL, 0x003d443c04380001ULL, 0x007b897909710103ULL,
+    0x00f712f212e20206ULL, 0x00ee24e424c4040cULL, 0x00dc49c949880818ULL, 0x00b9929392111030ULL,
+    0x0073242724232060ULL, 0x00e7484f484740c0ULL, 0x00ce909f918e8080ULL, 0x009c203e221c0000ULL,
+    0x0039417d45390000ULL, 0x007282fa8a730000ULL, 0x00e404f515e60000ULL, 0x00c808ea2acd0000ULL,
+    0x009111d5559a0000ULL, 0x002222aaaa340000ULL, 0x0044455454680000ULL, 0x00898aa9a8d10000ULL,
+    0x0013145350a30000ULL, 0x002728a7a0470000ULL, 0x004f514f418e0000ULL, 0x009ea29e821c0000ULL,
+    0x003d453d05390000ULL, 0x007a8a7a0b720000ULL, 0x00f414f416e50000ULL, 0x00e828e82ccb0000ULL,
+    0x00d050d059960000ULL, 0x00a0a0a0b22c0000ULL, 0x0040404064580000ULL, 0x00808080c8b00000ULL,
+    0x0000000090600000ULL, 0x0000000121c10000ULL, 0x0000010242820000ULL, 0x0001020484040000ULL,
+    0x0002050808080000ULL, 0x00040a1111110000ULL, 0x0008142222220000ULL, 0x0011294444440000ULL,
+    0x0023538888880000ULL, 0x0046a61010100000ULL, 0x008c4c2020210000ULL, 0x0018984040420100ULL,
+    0x0031318181850301ULL, 0x00626202020a0602ULL, 0x00c5c50404140c04ULL, 0x008b8b0808281808ULL,
+    0x0016161010503010ULL, 0x002c2d2121a16120ULL, 0x00595a434242c241ULL, 0x00b3b48685848483ULL,
+    0x0067680c0a090807ULL, 0x00ced1191513110eULL, 0x009ca2322a26221cULL, 0x00394564544c4438ULL,
+    0x00738bc8a8988870ULL, 0x00e61690503010e0ULL, 0x00cc2c20a06120c0ULL, 0x0098584040c24180ULL,
+    0x0031b18181858301ULL, 0x00626202020a0602ULL, 0x00c4c40404140c04ULL, 0x0088880808281808ULL,
+    0x0010101010503010ULL, 0x0020212121a16020ULL, 0x004142424242c140ULL, 0x0182848584858281ULL,
+    0x0304090a080a0403ULL, 0x0708131410140807ULL, 0x0f1026292029100fULL, 0x1e214c524052211eULL,
+    0x3c4299a581a5423cULL, 0x7884324a024a8478ULL, 0xf0086494049408f0ULL, 0xe010c828082810e0ULL,
+    0xc0209050105020c0ULL, 0x804020a020a04080ULL, 0x0080404040408000ULL, 0x0000808080800000ULL,
+    0x0000000000000000ULL,
+};
+
+//
+// CLOCK_MESSAGE_NO_EVENTS
+//
+const unsigned char ClockMessageNoEvents[13] ROM_DATA = {
+    0x20, 0xe7, 0x1b, 0x54, 0xb6, 0x97, 0xdd, 0xf4, 0x39, 0x48, 0x00, 0x02,
+    0x00,
+};
+
+static const ClockFrame ClockMessageNoEventsFrames[71] ROM_DATA = {
+    0x0000000000000000ULL, 0x0001010101010101ULL, 0x0002020202030302ULL, 0x0004040405060604ULL,
+    0x000809090a0c0c08ULL, 0x0011131315191911ULL, 0x002226262a323222ULL, 0x00444d4d55646444ULL,
+    0x00899a9aaac9c888ULL, 0x0013343454939010ULL, 0x00276868a8272020ULL, 0x004ed1d1514e4040ULL,
+    0x009ca2a2a29c8080ULL, 0x0038444444380000ULL, 0x0070888888700000ULL, 0x00e0101010e00000ULL,
+    0x00c0212121c00000ULL, 0x0081424342810000ULL, 0x0003848784030000ULL, 0x0007080f08070000ULL,
+    0x000e101f110e0000ULL, 0x001c203e221c0000ULL, 0x0038407d45390000ULL, 0x007081fa8a720000ULL,
+    0x00e102f414e40000ULL, 0x00c205e828c80000ULL, 0x00840ad151910000ULL, 0x000814a2a2220000ULL,
+    0x0010294545440000ULL, 0x0021528b8a890000ULL, 0x0043a41714130000ULL, 0x0087482f28270000ULL,
+    0x000e905f514e0000ULL, 0x001c20bea29c0000ULL, 0x0039417d45390000ULL, 0x007282fa8b720000ULL,
+    0x00e404f416e50000ULL, 0x00c808e82ccb0000ULL, 0x009111d159960000ULL, 0x002222a2b22c0000ULL,
+    0x0044444464590000ULL, 0x00888989c9b30101ULL, 0x0011121292670202ULL, 0x0023242424ce0404ULL,
+    0x00464948489c0808ULL, 0x008c929090381010ULL, 0x0019242021702020ULL, 0x0033484142e14040ULL,
+    0x0067908384c38080ULL, 0x00cf200708870000ULL, 0x009e410e100f0000ULL, 0x003c821c201e0000ULL,
+    0x00780438403c0000ULL, 0x00f0087080780000ULL, 0x00e010e000f00000ULL, 0x00c021c101e10000ULL,
+    0x0081428202c20100ULL, 0x0102850404850201ULL, 0x03040a09080a0403ULL, 0x0708141310140807ULL,
+    0x0f1029262029100fULL, 0x1e21524c4052211eULL, 0x3c42a59981a5423cULL, 0x78844a32024a8478ULL,
+    0xf0089464049408f0ULL, 0xe01028c8082810e0ULL, 0xc0205090105020c0ULL, 0x8040a02020a04080ULL,
+    0x0080404040408000ULL, 0x0000808080800000ULL, 0x0000000000000000ULL,
+};
+
+const ClockCacheEntry ClockMessages[] = {
+    { ClockMessageHello, ClockMessageHelloFrames, 169 },
+    { ClockMessageNoEvents, ClockMessageNoEventsFrames, 71 },
+};
+
+const size_t ClockMessagesCount = countof(ClockMessages);
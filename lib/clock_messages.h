@@ -0,0 +1,63 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock constant messages. Their sliding frames are rendered at
+//        build time by tools/gen_frames into lib/clock_messages.c, so showing
+//        them costs a table read per step.
+//
+//        After changing a message or the alphabet run 'make frames' from
+//        the top directory. ut_clock_cache fails while the table is stale.
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_MESSAGES_H
+#define BINARY_CLOCK_LIB_CLOCK_MESSAGES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock_cache.h"
+#include "clock_packed.h"
+
+//
+// This text will be shown at clock_state_hello
+//
+#define CLOCK_MESSAGE_HELLO "BinaryClock by sealemar v." \
+                            TOSTRING(VERSION_MAJOR) "." \
+                            TOSTRING(VERSION_MINOR) "." \
+                            TOSTRING(VERSION_FIX)       \
+                            " \001 "
+
+//
+// This text will be shown instead of events if there are none
+//
+#define CLOCK_MESSAGE_NO_EVENTS " No events \002 "
+
+//
+// The messages above, packed (see clock_packed.h) into ROM_DATA tables
+//
+extern const unsigned char ClockMessageHello[];
+extern const unsigned char ClockMessageNoEvents[];
+
+//
+// The cache entries of all the messages above
+//
+extern const ClockCacheEntry ClockMessages[];
+extern const size_t          ClockMessagesCount;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock packed text
+//
+
+#include <errno.h>
+
+#ifdef PARAM_CHECKS
+#include <logger.h>
+#endif
+
+#include <string.h>
+
+#include "clock.h"
+#include "clock_packed.h"
+
+#define CHARACTER_MASK ( (1U << CLOCK_PACKED_CHARACTER_BITS) - 1 )
+
+//
+// @brief packs a text
+// @param text a text of characters below 128
+// @param packed the result will be written here
+// @param size the size of _packed_ in bytes
+// @param packedSize the number of bytes written to _packed_ will be written here
+// @returns 0 on success
+// EINVAL - if _text_ is NULL
+//          if _packed_ is NULL
+//          if _packedSize_ is NULL
+//          if _text_ has a character above 127
+// ERANGE - if _packed_ is too short
+//
+int clock_packed_pack(const char *text, unsigned char *packed, size_t size, size_t *packedSize)
+{
+    NullCheck(text);
+    NullCheck(packed);
+    NullCheck(packedSize);
+
+    const size_t length = strlen(text);
+
+    if(clock_packed_size(length) > size) {
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(ERANGE, "%d", "%zu bytes is too short for '%s'", size, text);
+#else
+        return ERANGE;
+#endif
+    }
+
+    memset(packed, 0, clock_packed_size(length));
+
+    //
+    // Characters are packed least significant bit first. The terminating
+    // character is already there, it is all zeros
+    //
+    for(size_t i = 0, bit = 0; i < length; ++i, bit += CLOCK_PACKED_CHARACTER_BITS) {
+        const unsigned int ch = (unsigned char)text[i];
+
+#ifdef PARAM_CHECKS
+        if(ch > CHARACTER_MASK)
+            OriginateErrorEx(EINVAL, "%d", "character %zu of '%s' is above 127", i, text);
+#endif
+
+        const unsigned int bits = ch << (bit % 8);
+        packed[bit / 8]     |= (unsigned char)bits;
+        packed[bit / 8 + 1] |= (unsigned char)(bits >> 8);
+    }
+
+    *packedSize = clock_packed_size(length);
+
+    return 0;
+}
+
+//
+// @brief reads the next character of a packed text
+// @returns the character or 0 at the end of the text. The reader stays at
+//          the end once it is reached
+// @warning _reader_ is not checked
+//
+char clock_packed_next(ClockPackedReader *reader)
+{
+    const unsigned char *p = reader->packed + reader->bit / 8;
+
+    //
+    // A character spans two bytes at most. The second one is always there,
+    // because clock_packed_size() counts a spare byte
+    //
+    const unsigned int bits = (unsigned int)romReadByte(p) | (unsigned int)romReadByte(p + 1) << 8;
+    const char ch = (char)((bits >> (reader->bit % 8)) & CHARACTER_MASK);
+
+    if(ch != '\0') {
+        reader->bit += CLOCK_PACKED_CHARACTER_BITS;
+    }
+
+    return ch;
+}
@@ -0,0 +1,78 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock packed text. The alphabet has no glyphs above ASCII 127,
+//        so a constant text is kept as 7-bit characters packed one after
+//        another and terminated with a 0 character. It takes 7/8 of the
+//        memory of a C string and is read character by character, so it
+//        never has to be unpacked into RAM as a whole.
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_PACKED_H
+#define BINARY_CLOCK_LIB_CLOCK_PACKED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CLOCK_PACKED_CHARACTER_BITS 7U
+
+//
+// @brief gets the size in bytes of a packed text of _length_ characters.
+//        It includes the terminating character and a spare byte, so that
+//        a character is always read as two whole bytes
+//
+#define clock_packed_size(length) \
+    ( (size_t)(length) * CLOCK_PACKED_CHARACTER_BITS / 8 + 2 )
+
+typedef struct {
+    const unsigned char *packed;  // the packed text, may be a ROM_DATA table
+    size_t               bit;     // the first bit of the next character
+} ClockPackedReader;
+
+//
+// @brief packs a text
+// @param text a text of characters below 128
+// @param packed the result will be written here
+// @param size the size of _packed_ in bytes
+// @param packedSize the number of bytes written to _packed_ will be written here
+// @returns 0 on success
+// EINVAL - if _text_ is NULL
+//          if _packed_ is NULL
+//          if _packedSize_ is NULL
+//          if _text_ has a character above 127
+// ERANGE - if _packed_ is too short
+//
+int clock_packed_pack(const char *text, unsigned char *packed, size_t size, size_t *packedSize);
+
+//
+// @brief starts reading a packed text from the beginning
+// @warning _reader_ and _packed_ are not checked
+//
+#define clock_packed_begin(reader, packedText) \
+    { (reader)->packed = (packedText); (reader)->bit = 0; }
+
+//
+// @brief reads the next character of a packed text
+// @returns the character or 0 at the end of the text. The reader stays at
+//          the end once it is reached
+// @warning _reader_ is not checked
+//
+char clock_packed_next(ClockPackedReader *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
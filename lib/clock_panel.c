@@ -0,0 +1,364 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock panel
+//
+
+#ifdef PARAM_CHECKS
+#include <errno.h>
+
+#include <logger.h>
+#endif
+
+#include <string.h>
+
+#include "clock_extern.h"
+#include "clock_panel.h"
+#include "clock_state.h" // for MIN_YEAR
+
+#define WORD_FULL (~(ClockPanelWord)0)
+
+//
+// @brief a mask of the bits of word _w_ which are columns [ x, x + width )
+//
+static ClockPanelWord _columnsMask(unsigned int w, unsigned int x, unsigned int width)
+{
+    const unsigned int wordStart = w * CLOCK_PANEL_WORD_BITS;
+    const unsigned int first = x > wordStart ? x - wordStart : 0;
+    const unsigned int last  = x + width - wordStart < CLOCK_PANEL_WORD_BITS
+                                    ? x + width - wordStart
+                                    : CLOCK_PANEL_WORD_BITS;
+
+    //
+    // Bits [ first, last ) counting from the most significant one
+    //
+    ClockPanelWord mask = WORD_FULL >> first;
+    if(last < CLOCK_PANEL_WORD_BITS) {
+        mask &= ~(WORD_FULL >> last);
+    }
+
+    return mask;
+}
+
+//
+// @brief a mask of the bits of the last word of a row which are inside the panel
+//
+#define tailMask(panel) _columnsMask((panel)->stride - 1, 0, (panel)->width)
+
+//
+// @brief initializes the geometry of a panel and clears it
+//
+int clock_panel_init(ClockPanel *panel, unsigned int modulesWide, unsigned int modulesHigh)
+{
+    NullCheck(panel);
+
+#ifdef PARAM_CHECKS
+    if(modulesWide == 0 || modulesWide > CLOCK_PANEL_MAX_MODULES_WIDE)
+        OriginateErrorEx(ERANGE, "%d", "modulesWide[%u] should be 1 <= modulesWide <= %u",
+                                       modulesWide, CLOCK_PANEL_MAX_MODULES_WIDE);
+    if(modulesHigh == 0 || modulesHigh > CLOCK_PANEL_MAX_MODULES_HIGH)
+        OriginateErrorEx(ERANGE, "%d", "modulesHigh[%u] should be 1 <= modulesHigh <= %u",
+                                       modulesHigh, CLOCK_PANEL_MAX_MODULES_HIGH);
+#endif
+
+    panel->modulesWide = modulesWide;
+    panel->modulesHigh = modulesHigh;
+    panel->width       = modulesWide * CLOCK_SCREEN_WIDTH;
+    panel->height      = modulesHigh * CLOCK_SCREEN_HEIGHT;
+    panel->stride      = (panel->width + CLOCK_PANEL_WORD_BITS - 1) / CLOCK_PANEL_WORD_BITS;
+
+    Call(clock_panel_clear(panel));
+
+    return 0;
+}
+
+//
+// @brief switches all the pixels of a panel off
+//
+int clock_panel_clear(ClockPanel *panel)
+{
+    NullCheck(panel);
+
+    memset(panel->rows, 0, sizeof(panel->rows));
+
+    return 0;
+}
+
+//
+// @brief shifts the panel by _n_ pixels left. The released columns are blank
+//
+int clock_panel_shiftLeft(ClockPanel *panel, unsigned int n)
+{
+    NullCheck(panel);
+
+    const unsigned int words = n / CLOCK_PANEL_WORD_BITS;
+    const unsigned int bits  = n % CLOCK_PANEL_WORD_BITS;
+
+    for(unsigned int y = 0; y < panel->height; ++y) {
+        ClockPanelWord *row = panel->rows[y];
+
+        for(unsigned int i = 0; i < panel->stride; ++i) {
+            const unsigned int src = i + words;
+            const ClockPanelWord hi = src     < panel->stride ? row[src]     : 0;
+            const ClockPanelWord lo = src + 1 < panel->stride ? row[src + 1] : 0;
+
+            row[i] = bits ? (hi << bits) | (lo >> (CLOCK_PANEL_WORD_BITS - bits)) : hi;
+        }
+    }
+
+    return 0;
+}
+
+//
+// @brief shifts the panel by _n_ pixels right. The released columns are blank
+//
+int clock_panel_shiftRight(ClockPanel *panel, unsigned int n)
+{
+    NullCheck(panel);
+
+    const unsigned int words = n / CLOCK_PANEL_WORD_BITS;
+    const unsigned int bits  = n % CLOCK_PANEL_WORD_BITS;
+    const ClockPanelWord tail = tailMask(panel);
+
+    for(unsigned int y = 0; y < panel->height; ++y) {
+        ClockPanelWord *row = panel->rows[y];
+
+        for(unsigned int i = panel->stride; i-- > 0; ) {
+            const ClockPanelWord hi = i >= words     ? row[i - words]     : 0;
+            const ClockPanelWord lo = i >= words + 1 ? row[i - words - 1] : 0;
+
+            row[i] = bits ? (hi >> bits) | (lo << (CLOCK_PANEL_WORD_BITS - bits)) : hi;
+        }
+
+        //
+        // Don't let the pixels go beyond the right edge
+        //
+        row[panel->stride - 1] &= tail;
+    }
+
+    return 0;
+}
+
+//
+// @brief puts an 8x8 frame to the panel
+//
+int clock_panel_putFrame(ClockPanel *panel, ClockFrame frame, unsigned int x, unsigned int y)
+{
+    NullCheck(panel);
+
+#ifdef PARAM_CHECKS
+    if(x % CLOCK_SCREEN_WIDTH || x + CLOCK_SCREEN_WIDTH > panel->width)
+        OriginateErrorEx(ERANGE, "%d", "x[%u] should be a multiple of %d less than %u",
+                                       x, CLOCK_SCREEN_WIDTH, panel->width);
+    if(y + CLOCK_SCREEN_HEIGHT > panel->height)
+        OriginateErrorEx(ERANGE, "%d", "y[%u] should be <= %u", y, panel->height - CLOCK_SCREEN_HEIGHT);
+#endif
+
+    const unsigned int   w     = x / CLOCK_PANEL_WORD_BITS;
+    const unsigned int   shift = CLOCK_PANEL_WORD_BITS - CLOCK_SCREEN_WIDTH - (x % CLOCK_PANEL_WORD_BITS);
+    const ClockPanelWord mask  = ~((ClockPanelWord)0xff << shift);
+
+    for(unsigned int r = 0; r < CLOCK_SCREEN_HEIGHT; ++r) {
+        ClockPanelWord *word = &(panel->rows[y + r][w]);
+        *word = (*word & mask) | ((ClockPanelWord)clock_frame_getRow(frame, r) << shift);
+    }
+
+    return 0;
+}
+
+//
+// @brief gets the frame of module (_moduleX_, _moduleY_)
+//
+int clock_panel_getModule(const ClockPanel *panel, unsigned int moduleX, unsigned int moduleY, ClockFrame *frame)
+{
+    NullCheck(panel);
+    NullCheck(frame);
+
+#ifdef PARAM_CHECKS
+    if(moduleX >= panel->modulesWide || moduleY >= panel->modulesHigh)
+        OriginateErrorEx(ERANGE, "%d", "module (%u, %u) is out of %ux%u modules",
+                                       moduleX, moduleY, panel->modulesWide, panel->modulesHigh);
+#endif
+
+    const unsigned int x     = moduleX * CLOCK_SCREEN_WIDTH;
+    const unsigned int y     = moduleY * CLOCK_SCREEN_HEIGHT;
+    const unsigned int w     = x / CLOCK_PANEL_WORD_BITS;
+    const unsigned int shift = CLOCK_PANEL_WORD_BITS - CLOCK_SCREEN_WIDTH - (x % CLOCK_PANEL_WORD_BITS);
+
+    ClockFrame result = CLOCK_FRAME_BLANK;
+
+    for(int r = CLOCK_SCREEN_HEIGHT - 1; r >= 0; --r) {
+        result = (result << 8) | (unsigned char)(panel->rows[y + r][w] >> shift);
+    }
+
+    *frame = result;
+
+    return 0;
+}
+
+//
+// @brief puts a binary bar of _number_ over the whole height of the panel
+//
+int clock_panel_putBinaryNumber(ClockPanel *panel, unsigned long number, unsigned int x, unsigned int width)
+{
+    NullCheck(panel);
+
+#ifdef PARAM_CHECKS
+    if(width == 0 || x + width > panel->width)
+        OriginateErrorEx(ERANGE, "%d", "bar [%u, %u) doesn't fit %u columns", x, x + width, panel->width);
+#endif
+
+    const unsigned int firstWord = x / CLOCK_PANEL_WORD_BITS;
+    const unsigned int lastWord  = (x + width - 1) / CLOCK_PANEL_WORD_BITS;
+
+    for(unsigned int w = firstWord; w <= lastWord; ++w) {
+        const ClockPanelWord mask = _columnsMask(w, x, width);
+
+        for(unsigned int y = 0; y < panel->height; ++y) {
+            ClockPanelWord *word = &(panel->rows[y][w]);
+
+            if( (number >> (panel->height - y - 1)) & 1 ) {
+                *word |= mask;
+            } else {
+                *word &= ~mask;
+            }
+        }
+    }
+
+    return 0;
+}
+
+//
+// @brief puts three binary bars over the whole panel
+//
+static int _putBars(ClockPanel *panel, const int values[3])
+{
+    const unsigned int barWidth = (panel->width - 2) / 3;
+
+    Call(clock_panel_clear(panel));
+
+    for(unsigned int i = 0; i < 3; ++i) {
+        Call(clock_panel_putBinaryNumber(panel, values[i], i * (barWidth + 1), barWidth));
+    }
+
+    return 0;
+}
+
+//
+// @brief lays the time face out over the whole panel
+//
+int clock_panel_putTime(ClockPanel *panel, const DateTime *dt)
+{
+    NullCheck(panel);
+    NullCheck(dt);
+
+    const int values[] = { dt->hour, dt->minute, dt->second };
+
+    Call(_putBars(panel, values));
+
+    return 0;
+}
+
+//
+// @brief lays the date face out over the whole panel
+//
+int clock_panel_putDate(ClockPanel *panel, const DateTime *dt)
+{
+    NullCheck(panel);
+    NullCheck(dt);
+
+    const int values[] = { dt->month + 1, dt->day, dt->year - MIN_YEAR };
+
+    Call(_putBars(panel, values));
+
+    return 0;
+}
+
+//
+// @brief slides a prepared text across the whole width of the panel
+//
+int clock_panel_slideText(ClockPanel *panel, const ClockText *strip, size_t step, Bool *isLastStep)
+{
+    NullCheck(panel);
+    NullCheck(strip);
+    NullCheck(isLastStep);
+
+    //
+    // Column 0 of the strip starts at the leftmost column of the last module
+    //
+    const size_t offset   = panel->width - CLOCK_SCREEN_WIDTH;
+    const size_t lastStep = strip->size + offset - CLOCK_SCREEN_WIDTH;
+
+#ifdef PARAM_CHECKS
+    if(strip->size < CLOCK_SCREEN_WIDTH || step > lastStep)
+        OriginateErrorEx(EINVAL, "%d", "step[%zu] should be <= %zu for a strip of %zu columns",
+                                       step, lastStep, strip->size);
+#else
+    if(step > lastStep) {
+        *isLastStep = TRUE;
+        return 0;
+    }
+#endif
+
+    *isLastStep = step == lastStep;
+
+    Call(clock_panel_clear(panel));
+
+    const unsigned int y = (panel->height - CLOCK_SCREEN_HEIGHT) / 2;
+
+    for(unsigned int x = 0; x < panel->width; x += CLOCK_SCREEN_WIDTH) {
+        //
+        // The strip column which is shown at _x_ is (step + x - offset)
+        //
+        if(step + x + CLOCK_SCREEN_WIDTH <= offset || step + x >= strip->size + offset) continue;
+
+        const unsigned char *columns;
+        unsigned char partial[CLOCK_SCREEN_WIDTH];
+
+        if(step + x >= offset && step + x - offset + CLOCK_SCREEN_WIDTH <= strip->size) {
+            columns = strip->columns + (step + x - offset);
+        } else {
+            for(unsigned int i = 0; i < CLOCK_SCREEN_WIDTH; ++i) {
+                const size_t c = step + x + i;
+                partial[i] = c >= offset && c - offset < strip->size ? strip->columns[c - offset] : 0;
+            }
+            columns = partial;
+        }
+
+        Call(clock_panel_putFrame(panel, clock_frame_transpose(clock_frame_fromPattern(columns)), x, y));
+    }
+
+    return 0;
+}
+
+//
+// @brief sends the panel to the screen
+//
+int clock_panel_draw(const ClockPanel *panel)
+{
+    NullCheck(panel);
+
+    if(clock_extern_drawPanel != NULL) {
+        Call(clock_extern_drawPanel(panel));
+        return 0;
+    }
+
+    for(unsigned int y = 0; y < panel->height; ++y) {
+        for(unsigned int x = 0; x < panel->width; ++x) {
+            Call(clock_extern_setPixel(x, y, clock_panel_getPixel(panel, x, y)));
+        }
+    }
+
+    return 0;
+}
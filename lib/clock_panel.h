@@ -0,0 +1,181 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock panel. A panel is a chain of 8x8 modules laid out in
+//        a grid, i.e. 32x8 or 64x16. Its framebuffer is packed row by row
+//        into words, so that every operation costs the same per byte no
+//        matter how many modules there are.
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_PANEL_H
+#define BINARY_CLOCK_LIB_CLOCK_PANEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock.h"
+#include "clock_text.h"
+
+//
+// The maximum number of modules in a row and in a column of a panel.
+// May be overridden at build time.
+//
+#ifndef CLOCK_PANEL_MAX_MODULES_WIDE
+#define CLOCK_PANEL_MAX_MODULES_WIDE 8U
+#endif
+
+#ifndef CLOCK_PANEL_MAX_MODULES_HIGH
+#define CLOCK_PANEL_MAX_MODULES_HIGH 2U
+#endif
+
+//
+// A row of a panel is packed into words. Pixel x of a row is
+// bit (CLOCK_PANEL_WORD_BITS - (x % CLOCK_PANEL_WORD_BITS) - 1) of word
+// (x / CLOCK_PANEL_WORD_BITS), i.e. the leftmost pixel is the most
+// significant bit, the same as in ClockAlphabet rows
+//
+typedef uint32_t ClockPanelWord;
+
+#define CLOCK_PANEL_WORD_BITS    32U
+#define CLOCK_PANEL_WORD_MODULES ( CLOCK_PANEL_WORD_BITS / CLOCK_SCREEN_WIDTH )
+
+#define CLOCK_PANEL_MAX_WIDTH  ( CLOCK_PANEL_MAX_MODULES_WIDE * CLOCK_SCREEN_WIDTH )
+#define CLOCK_PANEL_MAX_HEIGHT ( CLOCK_PANEL_MAX_MODULES_HIGH * CLOCK_SCREEN_HEIGHT )
+#define CLOCK_PANEL_MAX_STRIDE ( (CLOCK_PANEL_MAX_WIDTH + CLOCK_PANEL_WORD_BITS - 1) / CLOCK_PANEL_WORD_BITS )
+
+typedef struct {
+    unsigned int   modulesWide;   // the number of modules in a row
+    unsigned int   modulesHigh;   // the number of modules in a column
+    unsigned int   width;         // in pixels
+    unsigned int   height;        // in pixels
+    unsigned int   stride;        // the number of words in a row
+    ClockPanelWord rows[CLOCK_PANEL_MAX_HEIGHT][CLOCK_PANEL_MAX_STRIDE];
+} ClockPanel;
+
+//
+// @brief gets pixel (x, y) of a panel (0 or 1)
+// @warning _x_ and _y_ are not checked for overflow
+//
+#define clock_panel_getPixel(panel, x, y) \
+    ( (int)(((panel)->rows[y][(x) / CLOCK_PANEL_WORD_BITS] \
+            >> (CLOCK_PANEL_WORD_BITS - ((x) % CLOCK_PANEL_WORD_BITS) - 1)) & 1) )
+
+//
+// @brief initializes the geometry of a panel and clears it
+// @param panel
+// @param modulesWide the number of modules in a row [ 1 <= modulesWide <= CLOCK_PANEL_MAX_MODULES_WIDE ]
+// @param modulesHigh the number of modules in a column [ 1 <= modulesHigh <= CLOCK_PANEL_MAX_MODULES_HIGH ]
+// @returns 0 on success
+// EINVAL - if _panel_ is NULL
+// ERANGE - if _modulesWide_ or _modulesHigh_ is out of range
+//
+int clock_panel_init(ClockPanel *panel, unsigned int modulesWide, unsigned int modulesHigh);
+
+//
+// @brief switches all the pixels of a panel off
+// @returns 0 on success
+// EINVAL - if _panel_ is NULL
+//
+int clock_panel_clear(ClockPanel *panel);
+
+//
+// @brief shifts the panel by _n_ pixels left or right. The released columns are blank
+// @returns 0 on success
+// EINVAL - if _panel_ is NULL
+//
+int clock_panel_shiftLeft(ClockPanel *panel, unsigned int n);
+int clock_panel_shiftRight(ClockPanel *panel, unsigned int n);
+
+//
+// @brief puts an 8x8 frame to the panel
+// @param panel
+// @param frame
+// @param x the left column of the frame. Should be a multiple of CLOCK_SCREEN_WIDTH
+// @param y the top row of the frame [ y <= panel->height - CLOCK_SCREEN_HEIGHT ]
+// @returns 0 on success
+// EINVAL - if _panel_ is NULL
+// ERANGE - if the frame doesn't fit the panel or _x_ is not aligned
+//
+int clock_panel_putFrame(ClockPanel *panel, ClockFrame frame, unsigned int x, unsigned int y);
+
+//
+// @brief gets the frame of module (_moduleX_, _moduleY_)
+// @param panel
+// @param moduleX [ moduleX < panel->modulesWide ]
+// @param moduleY [ moduleY < panel->modulesHigh ]
+// @param frame the result will be written here
+// @returns 0 on success
+// EINVAL - if _panel_ is NULL
+//          if _frame_ is NULL
+// ERANGE - if the module is out of the panel
+//
+int clock_panel_getModule(const ClockPanel *panel, unsigned int moduleX, unsigned int moduleY, ClockFrame *frame);
+
+//
+// @brief puts a binary bar of _number_ over the whole height of the panel.
+//        Bit y of _number_ lights row (panel->height - y - 1)
+// @param panel
+// @param number
+// @param x the left column of the bar
+// @param width the number of columns of the bar
+// @returns 0 on success
+// EINVAL - if _panel_ is NULL
+// ERANGE - if the bar doesn't fit the panel
+//
+int clock_panel_putBinaryNumber(ClockPanel *panel, unsigned long number, unsigned int x, unsigned int width);
+
+//
+// @brief lays the time face or the date face out over the whole panel. They are
+//        three binary bars (hour, minute, second or month, day, year) as wide as
+//        the panel allows with one blank column between them. On a single module
+//        the faces look exactly like clock_displayTime() and clock_displayDate()
+// @returns 0 on success
+// EINVAL - if _panel_ is NULL
+//          if _dt_ is NULL
+//
+int clock_panel_putTime(ClockPanel *panel, const DateTime *dt);
+int clock_panel_putDate(ClockPanel *panel, const DateTime *dt);
+
+//
+// @brief slides a prepared text across the whole width of the panel from right
+//        to left. The text enters at the right edge and leaves at the left one.
+//        It is vertically centered. On a single module the result is the same
+//        as clock_text_window()
+// @param panel
+// @param strip a strip prepared with clock_text_prepare() or clock_text_prepareProportional()
+// @param step indicates current iteration
+//        [ step <= strip->size + panel->width - 2 * CLOCK_SCREEN_WIDTH ]
+// @param isLastStep is an output variable which if set to non zero value indicates the last iteration
+// @returns 0 on success
+// EINVAL - if _panel_ is NULL
+//          if _strip_ is NULL
+//          if _isLastStep_ is NULL
+//          if _step_ is out of range
+//
+int clock_panel_slideText(ClockPanel *panel, const ClockText *strip, size_t step, Bool *isLastStep);
+
+//
+// @brief sends the panel to the screen with clock_extern_drawPanel() if it is
+//        set, or pixel by pixel with clock_extern_setPixel() otherwise
+// @returns 0 on success
+// EINVAL - if _panel_ is NULL
+//
+int clock_panel_draw(const ClockPanel *panel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock scan-out scheduler
+//
+
+#ifdef PARAM_CHECKS
+#include <errno.h>
+
+#include <logger.h>
+#endif
+
+#include <string.h>
+
+#include "clock_scan.h"
+
+#if CLOCK_SCAN_PLANES < 1 || CLOCK_SCAN_PLANES > 8
+#error CLOCK_SCAN_PLANES should be in range [1, 8]
+#endif
+
+//
+// @brief makes a gray frame, which lights the pixels of _frame_ at _level_
+// @param frame
+// @param level [ level <= CLOCK_SCAN_MAX_LEVEL ]
+// @param gray the result will be written here
+// @returns 0 on success
+// EINVAL - if _gray_ is NULL
+//          if _level_ is out of range
+//
+int clock_scan_grayFromFrame(ClockFrame frame, unsigned int level, ClockGrayFrame *gray)
+{
+    NullCheck(gray);
+
+#ifdef PARAM_CHECKS
+    if(level > CLOCK_SCAN_MAX_LEVEL)
+        OriginateErrorEx(EINVAL, "%d", "level[%u] should be <= %u", level, CLOCK_SCAN_MAX_LEVEL);
+#endif
+
+    for(unsigned int p = 0; p < CLOCK_SCAN_PLANES; ++p) {
+        gray->planes[p] = frame & clock_frame_fillMask(level >> p);
+    }
+
+    return 0;
+}
+
+//
+// @brief cross-fades two frames. A pixel gets (CLOCK_SCAN_MAX_LEVEL - step)
+//        if it is lit in _from_ plus _step_ if it is lit in _to_
+// @param from
+// @param to
+// @param step [ step <= CLOCK_SCAN_MAX_LEVEL ]
+// @param gray the result will be written here
+// @returns 0 on success
+// EINVAL - if _gray_ is NULL
+//          if _step_ is out of range
+//
+// @note the levels of both frames are added plane by plane with a ripple
+//       carry, all 64 pixels at once. The sum never exceeds
+//       CLOCK_SCAN_MAX_LEVEL, so the last carry is always 0
+//
+int clock_scan_crossFade(ClockFrame from, ClockFrame to, unsigned int step, ClockGrayFrame *gray)
+{
+    NullCheck(gray);
+
+#ifdef PARAM_CHECKS
+    if(step > CLOCK_SCAN_MAX_LEVEL)
+        OriginateErrorEx(EINVAL, "%d", "step[%u] should be <= %u", step, CLOCK_SCAN_MAX_LEVEL);
+#endif
+
+    const unsigned int fromLevel = CLOCK_SCAN_MAX_LEVEL - step;
+    ClockFrame carry = CLOCK_FRAME_BLANK;
+
+    for(unsigned int p = 0; p < CLOCK_SCAN_PLANES; ++p) {
+        const ClockFrame a = from & clock_frame_fillMask(fromLevel >> p);
+        const ClockFrame b = to   & clock_frame_fillMask(step >> p);
+
+        gray->planes[p] = a ^ b ^ carry;
+        carry = (a & b) | (carry & (a ^ b));
+    }
+
+    return 0;
+}
+
+//
+// @brief gets the level of pixel (x, y) of a gray frame
+// @returns the level [ 0 <= level <= CLOCK_SCAN_MAX_LEVEL ]
+// @warning _gray_, _x_ and _y_ are not checked
+//
+unsigned int clock_scan_getLevel(const ClockGrayFrame *gray, unsigned int x, unsigned int y)
+{
+    unsigned int level = 0;
+
+    for(unsigned int p = 0; p < CLOCK_SCAN_PLANES; ++p) {
+        level |= (unsigned int)clock_frame_getPixel(gray->planes[p], x, y) << p;
+    }
+
+    return level;
+}
+
+//
+// @brief initializes a scheduler with a blank frame
+// @param scan
+// @param baseMicros the dwell time of the least significant plane [ baseMicros > 0 ]
+// @returns 0 on success
+// EINVAL - if _scan_ is NULL
+//          if _baseMicros_ is 0
+//
+int clock_scan_init(ClockScan *scan, unsigned long baseMicros)
+{
+    NullCheck(scan);
+
+#ifdef PARAM_CHECKS
+    if(baseMicros == 0)
+        OriginateErrorEx(EINVAL, "%d", "baseMicros should be > 0");
+#endif
+
+    memset(scan, 0, sizeof(ClockScan));
+    scan->baseMicros = baseMicros;
+
+    return 0;
+}
+
+//
+// @brief sets the frame to scan. It is latched at the start of the next
+//        cycle, so that a cycle never mixes two frames
+// @returns 0 on success
+// EINVAL - if _scan_ is NULL
+//          if _gray_ is NULL
+//
+int clock_scan_setFrame(ClockScan *scan, const ClockGrayFrame *gray)
+{
+    NullCheck(scan);
+    NullCheck(gray);
+
+    scan->pending   = *gray;
+    scan->isPending = TRUE;
+
+    return 0;
+}
+
+//
+// @brief gets the next slot of the scan-out
+// @param scan
+// @param slot the result will be written here
+// @returns 0 on success
+// EINVAL - if _scan_ is NULL
+//          if _slot_ is NULL
+//
+int clock_scan_next(ClockScan *scan, ClockScanSlot *slot)
+{
+    NullCheck(scan);
+    NullCheck(slot);
+
+    if(scan->row == 0 && scan->plane == 0 && scan->isPending) {
+        scan->frame     = scan->pending;
+        scan->isPending = FALSE;
+    }
+
+    slot->row    = (unsigned char)scan->row;
+    slot->bits   = clock_frame_getRow(scan->frame.planes[scan->plane], scan->row);
+    slot->micros = scan->baseMicros << scan->plane;
+
+    if(++scan->plane == CLOCK_SCAN_PLANES) {
+        scan->plane = 0;
+        if(++scan->row == CLOCK_SCREEN_HEIGHT) {
+            scan->row = 0;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock scan-out scheduler. A gray frame keeps a brightness
+//        level per pixel as CLOCK_SCAN_PLANES bit planes. The scheduler
+//        turns it into a binary code modulation sequence: every row is shown
+//        once per plane and plane p is held twice as long as plane p - 1,
+//        so a pixel is lit for exactly level / CLOCK_SCAN_MAX_LEVEL of the
+//        time of its row. Every slot is a single byte fetch.
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_SCAN_H
+#define BINARY_CLOCK_LIB_CLOCK_SCAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock.h"
+
+//
+// The number of bit planes of a gray frame [ 1 <= CLOCK_SCAN_PLANES <= 8 ].
+// May be overridden at build time
+//
+#ifndef CLOCK_SCAN_PLANES
+#define CLOCK_SCAN_PLANES 2U
+#endif
+
+#define CLOCK_SCAN_LEVELS    ( 1U << CLOCK_SCAN_PLANES )
+#define CLOCK_SCAN_MAX_LEVEL ( CLOCK_SCAN_LEVELS - 1U )
+
+//
+// The number of slots in a full scan cycle
+//
+#define CLOCK_SCAN_CYCLE_SLOTS ( CLOCK_SCREEN_HEIGHT * CLOCK_SCAN_PLANES )
+
+//
+// Plane p holds bit p of the level of every pixel
+//
+typedef struct {
+    ClockFrame planes[CLOCK_SCAN_PLANES];
+} ClockGrayFrame;
+
+//
+// A single step of the scan-out. The backend should show _bits_ in row _row_
+// for _micros_ microseconds. Bit (7 - x) of _bits_ is pixel x
+//
+typedef struct {
+    unsigned char row;
+    unsigned char bits;
+    unsigned long micros;
+} ClockScanSlot;
+
+typedef struct {
+    ClockGrayFrame frame;       // the frame which is being scanned
+    ClockGrayFrame pending;     // the frame which is shown from the next cycle on
+    Bool           isPending;
+    unsigned long  baseMicros;  // the dwell time of plane 0
+    unsigned int   row;         // the next slot
+    unsigned int   plane;
+} ClockScan;
+
+//
+// @brief makes a gray frame, which lights the pixels of _frame_ at _level_
+// @param frame
+// @param level [ level <= CLOCK_SCAN_MAX_LEVEL ]
+// @param gray the result will be written here
+// @returns 0 on success
+// EINVAL - if _gray_ is NULL
+//          if _level_ is out of range
+//
+int clock_scan_grayFromFrame(ClockFrame frame, unsigned int level, ClockGrayFrame *gray);
+
+//
+// @brief cross-fades two frames. A pixel gets (CLOCK_SCAN_MAX_LEVEL - step)
+//        if it is lit in _from_ plus _step_ if it is lit in _to_. Step 0 is
+//        _from_ and step CLOCK_SCAN_MAX_LEVEL is _to_, both at full brightness
+// @param from
+// @param to
+// @param step [ step <= CLOCK_SCAN_MAX_LEVEL ]
+// @param gray the result will be written here
+// @returns 0 on success
+// EINVAL - if _gray_ is NULL
+//          if _step_ is out of range
+//
+int clock_scan_crossFade(ClockFrame from, ClockFrame to, unsigned int step, ClockGrayFrame *gray);
+
+//
+// @brief gets the level of pixel (x, y) of a gray frame
+// @returns the level [ 0 <= level <= CLOCK_SCAN_MAX_LEVEL ]
+// @warning _gray_, _x_ and _y_ are not checked
+//
+unsigned int clock_scan_getLevel(const ClockGrayFrame *gray, unsigned int x, unsigned int y);
+
+//
+// @brief initializes a scheduler with a blank frame
+// @param scan
+// @param baseMicros the dwell time of the least significant plane [ baseMicros > 0 ]
+// @returns 0 on success
+// EINVAL - if _scan_ is NULL
+//          if _baseMicros_ is 0
+//
+int clock_scan_init(ClockScan *scan, unsigned long baseMicros);
+
+//
+// @brief sets the frame to scan. It is latched at the start of the next
+//        cycle, so that a cycle never mixes two frames
+// @returns 0 on success
+// EINVAL - if _scan_ is NULL
+//          if _gray_ is NULL
+//
+int clock_scan_setFrame(ClockScan *scan, const ClockGrayFrame *gray);
+
+//
+// @brief gets the next slot of the scan-out
+// @param scan
+// @param slot the result will be written here
+// @returns 0 on success
+// EINVAL - if _scan_ is NULL
+//          if _slot_ is NULL
+//
+int clock_scan_next(ClockScan *scan, ClockScanSlot *slot);
+
+//
+// @brief gets the duration of a full scan cycle, which is
+//        CLOCK_SCREEN_HEIGHT * CLOCK_SCAN_MAX_LEVEL * baseMicros
+// @warning _scan_ is not checked
+//
+#define clock_scan_cycleMicros(scan) \
+    ( (unsigned long)CLOCK_SCREEN_HEIGHT * CLOCK_SCAN_MAX_LEVEL * (scan)->baseMicros )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
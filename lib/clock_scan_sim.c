@@ -0,0 +1,92 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock scan-out simulator
+//
+
+#ifdef PARAM_CHECKS
+#include <errno.h>
+
+#include <logger.h>
+#endif
+
+#include <string.h>
+
+#include "clock_scan_sim.h"
+
+//
+// @brief resets all the counters of a simulator
+// @returns 0 on success
+// EINVAL - if _sim_ is NULL
+//
+int clock_scan_sim_reset(ClockScanSimulator *sim)
+{
+    NullCheck(sim);
+
+    memset(sim, 0, sizeof(ClockScanSimulator));
+
+    return 0;
+}
+
+//
+// @brief shows a slot, i.e. accounts its dwell time to its row and to every
+//        lit pixel of the row
+// @returns 0 on success
+// EINVAL - if _sim_ is NULL
+//          if _slot_ is NULL
+// ERANGE - if _slot->row_ is out of the screen
+//
+int clock_scan_sim_show(ClockScanSimulator *sim, const ClockScanSlot *slot)
+{
+    NullCheck(sim);
+    NullCheck(slot);
+
+#ifdef PARAM_CHECKS
+    if(slot->row >= CLOCK_SCREEN_HEIGHT)
+        OriginateErrorEx(ERANGE, "%d", "row[%u] should be < %u", (unsigned int)slot->row, CLOCK_SCREEN_HEIGHT);
+#endif
+
+    for(unsigned int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+        if(slot->bits & (1U << (CLOCK_SCREEN_WIDTH - x - 1))) {
+            sim->onMicros[slot->row][x] += slot->micros;
+        }
+    }
+
+    sim->rowMicros[slot->row] += slot->micros;
+    sim->totalMicros          += slot->micros;
+    ++sim->slots;
+
+    return 0;
+}
+
+//
+// @brief runs _count_ slots of a scheduler through a simulator
+// @returns 0 on success
+// EINVAL - if _sim_ is NULL
+//          if _scan_ is NULL
+//
+int clock_scan_sim_run(ClockScanSimulator *sim, ClockScan *scan, unsigned long count)
+{
+    NullCheck(sim);
+    NullCheck(scan);
+
+    ClockScanSlot slot;
+
+    for(; count; --count) {
+        Call(clock_scan_next(scan, &slot));
+        Call(clock_scan_sim_show(sim, &slot));
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock scan-out simulator. It is a backend for ClockScan, which
+//        doesn't drive any LEDs, but accounts the time every pixel is lit.
+//        It lets the timing and the duty cycles of a scan-out be checked on
+//        a host.
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_SCAN_SIM_H
+#define BINARY_CLOCK_LIB_CLOCK_SCAN_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock_scan.h"
+
+typedef struct {
+    unsigned long onMicros[CLOCK_SCREEN_HEIGHT][CLOCK_SCREEN_WIDTH]; // the time every pixel was lit
+    unsigned long rowMicros[CLOCK_SCREEN_HEIGHT];                     // the time every row was selected
+    unsigned long totalMicros;                                        // the time of all the slots
+    unsigned long slots;                                              // the number of slots shown
+} ClockScanSimulator;
+
+//
+// @brief resets all the counters of a simulator
+// @returns 0 on success
+// EINVAL - if _sim_ is NULL
+//
+int clock_scan_sim_reset(ClockScanSimulator *sim);
+
+//
+// @brief shows a slot, i.e. accounts its dwell time to its row and to every
+//        lit pixel of the row
+// @returns 0 on success
+// EINVAL - if _sim_ is NULL
+//          if _slot_ is NULL
+// ERANGE - if _slot->row_ is out of the screen
+//
+int clock_scan_sim_show(ClockScanSimulator *sim, const ClockScanSlot *slot);
+
+//
+// @brief runs _count_ slots of a scheduler through a simulator
+// @returns 0 on success
+// EINVAL - if _sim_ is NULL
+//          if _scan_ is NULL
+//
+int clock_scan_sim_run(ClockScanSimulator *sim, ClockScan *scan, unsigned long count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
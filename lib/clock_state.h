@@ -27,6 +27,10 @@ extern "C" {
 #include "date_time.h"
 #include "clock_button.h"
 #include "clock.h"
+#include "clock_cache.h"
+#include "clock_panel.h"
+#include "clock_text.h"
+#include "clock_transition.h"
 
 #define CLOCK_STATE_HELLO                   0
 #define CLOCK_STATE_SHOW_TIME               1
@@ -48,13 +52,30 @@ extern "C" {
 
 #define CLOCK_BUTTON_COUNT      4U
 
-#define STATE_TEXT_SIZE       101U
+//
+// The longest text a state prints is the year information of an event. An
+// event name is not printed, it slides straight from the event list
+//
+#define STATE_TEXT_SIZE       ( 1U + EVENT_YEAR_INFO_STR_SIZE )
 
 #define MIN_YEAR  2000
 #define MAX_YEAR  ( MIN_YEAR + CLOCK_MAX_BINARY_NUMBER )
 
 #define CLOCK_EVENT_INDEX_LOOKUP (-1)
 
+//
+// The states of an event list swap. A published list replaces the shown
+// one in clock_update() once no event text is being slid. The replaced
+// list is retired then, until clock_reclaimEvents() hands it back. If the
+// published list needs more than moving its cursor forward to get to the
+// date of the clock, i.e. a year has changed, it is stale and not swapped
+// in. It should be published again then
+//
+#define CLOCK_EVENTS_SWAP_NONE      0
+#define CLOCK_EVENTS_SWAP_PUBLISHED 1
+#define CLOCK_EVENTS_SWAP_RETIRED   2
+#define CLOCK_EVENTS_SWAP_STALE     3
+
 #include "clock_event.h"
 
 typedef struct {
@@ -62,14 +83,33 @@ typedef struct {
     int           step;                    // current step of the _state_
     unsigned int  stepMillis;              // current step time (for animation)
     unsigned long lastUptime;              // in milliseconds
-    DateTime      dateTime;                // this gets updated in the beginning of clock_update()
-    DateTime      oldDateTime;             // this gets copied from _dateTime_ at the end of clock_update()
+    DateTimeClock time;                    // this gets advanced and refreshed in the beginning of clock_update()
+    unsigned int  changed;                 // DATE_TIME_*_CHANGED fields of _time.dateTime_ which were changed
+                                           // since the last clock_update()
     ClockButtons  buttons;                 // the state of the clock buttons
     char          text[STATE_TEXT_SIZE];   // a state may set this to some text
+    ClockTextStream textStream;            // the text which is being slid, compiled column by column
+    const ClockCacheEntry *cachedText;     // if not NULL, the frames of the text which is being slid are
+                                           // read from this entry instead of _textStream_
+    ClockPanel   *panel;                   // if not NULL, the text and the time and date faces are drawn
+                                           // over this panel of modules instead of one 8x8 screen.
+                                           // Set it after clock_init()
+    ClockText    *textStrip;               // the text which a panel slides, compiled at step 0 of slideText().
+                                           // Set it together with _panel_
+    struct {
+        unsigned int  type;      // one of CLOCK_TRANSITION_*, used when a state switch clears the screen
+        unsigned int  millis;    // time since the last step of the running transition
+        Bool          isActive;  // TRUE while a transition is running
+    } transition;                          // state switch transition information
     struct {
-        ClockEvent *ptr;         // the pointer to the head of the events array
-        size_t      size;        // the size of the events array
-        int         index;       // index of the currently shown event (default is CLOCK_EVENT_INDEX_LOOKUP, meaning look up the next closest event)
+        ClockEventList list;     // the events in the order of their dates
+        int            index;    // position in the order of _list_ of the currently shown event
+                                 // (default is CLOCK_EVENT_INDEX_LOOKUP, meaning look up the next closest event)
+#ifndef __AVR__
+        ClockEventList next;     // the list which clock_publishEvents() published, see _swap_
+        ClockEventList retired;  // the list which _next_ replaced, see _swap_
+        unsigned int   swap;     // one of CLOCK_EVENTS_SWAP_*
+#endif
     } events;                              // events information
 } ClockState;
 
@@ -0,0 +1,559 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock prepared text
+//
+
+#ifdef PARAM_CHECKS
+#include <logger.h>
+#endif
+
+#include <errno.h>
+#include <string.h>
+
+#include "clock_alphabet.h"
+#include "clock_text.h"
+
+//
+// @brief writes CLOCK_SCREEN_WIDTH columns of the glyph of _ch_ to _columns_
+// @returns the index of the glyph
+//
+static int _getGlyphColumns(unsigned char ch, unsigned char columns[CLOCK_SCREEN_WIDTH])
+{
+    int index = CLOCK_BLANK;
+    clock_alphabet_getIndexByCharacter(ch, &index);
+
+    //
+    // The rows of the transposed glyph are its columns
+    //
+    clock_frame_toPattern(clock_frame_transpose(clock_alphabet_getGlyph(index)), columns);
+
+    return index;
+}
+
+//
+// @returns TRUE if _ch_ is shown as a blank glyph
+//
+static Bool _isBlank(unsigned char ch)
+{
+    int index = CLOCK_BLANK;
+    clock_alphabet_getIndexByCharacter(ch, &index);
+
+    return index == CLOCK_BLANK;
+}
+
+//
+// @brief compiles _text_ into a strip of columns
+// @param strip the result will be written here
+// @param text a text to compile
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _text_ is NULL
+//          if _text_ is empty
+// ERANGE - if _text_ is longer than CLOCK_TEXT_MAX_LENGTH
+//
+int clock_text_prepare(ClockText *strip, const char *text)
+{
+    NullCheck(strip);
+    NullCheck(text);
+
+#ifdef PARAM_CHECKS
+    if(*text == '\0')
+        OriginateErrorEx(EINVAL, "%d", "text should not be empty");
+#endif
+
+    unsigned char *columns = strip->columns;
+
+    for(size_t i = 0; text[i] != '\0'; ++i, columns += CLOCK_SCREEN_WIDTH) {
+        if(i == CLOCK_TEXT_MAX_LENGTH) {
+#ifdef PARAM_CHECKS
+            OriginateErrorEx(ERANGE, "%d", "text '%s' is longer than %u characters", text, CLOCK_TEXT_MAX_LENGTH);
+#else
+            break;
+#endif
+        }
+
+        _getGlyphColumns(text[i], columns);
+    }
+
+    strip->size = columns - strip->columns;
+
+    return 0;
+}
+
+//
+// @brief appends _count_ columns to the strip. If _source_ is NULL,
+//        blank columns will be appended
+// @returns 0 on success
+// ERANGE - if the columns don't fit CLOCK_TEXT_MAX_COLUMNS
+//
+static int _appendColumns(ClockText *strip, const unsigned char *source, size_t count)
+{
+    if(strip->size + count > CLOCK_TEXT_MAX_COLUMNS) {
+#ifdef PARAM_CHECKS
+        OriginateErrorEx(ERANGE, "%d", "the strip is longer than %u columns", CLOCK_TEXT_MAX_COLUMNS);
+#else
+        return ERANGE;
+#endif
+    }
+
+    if(source) {
+        memcpy(strip->columns + strip->size, source, count);
+    } else {
+        memset(strip->columns + strip->size, 0, count);
+    }
+
+    strip->size += count;
+
+    return 0;
+}
+
+//
+// @brief compiles _text_ into a strip of columns where every glyph takes
+//        only the columns which its bitmap uses
+// @param strip the result will be written here
+// @param text a text to compile
+// @param spacing the number of blank columns between glyphs
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _text_ is NULL
+//          if _text_ is empty
+// ERANGE - if the strip doesn't fit CLOCK_TEXT_MAX_COLUMNS
+//
+int clock_text_prepareProportional(ClockText *strip, const char *text, unsigned int spacing)
+{
+    NullCheck(strip);
+    NullCheck(text);
+
+#ifdef PARAM_CHECKS
+    if(*text == '\0')
+        OriginateErrorEx(EINVAL, "%d", "text should not be empty");
+#endif
+
+    const char *begin = text;
+    const char *end   = text + strlen(text);
+
+    //
+    // The leading and the trailing blanks take the whole screen width
+    //
+    while(begin < end && _isBlank(*begin))  ++begin;
+    while(end > begin && _isBlank(end[-1])) --end;
+
+    strip->size = 0;
+    Call(_appendColumns(strip, NULL, (begin - text) * CLOCK_SCREEN_WIDTH));
+
+    for(const char *ch = begin; ch < end; ++ch) {
+        unsigned char columns[CLOCK_SCREEN_WIDTH];
+        unsigned int  left;
+        unsigned int  width;
+
+        if(ch != begin) {
+            Call(_appendColumns(strip, NULL, spacing));
+        }
+
+        Call(clock_alphabet_getGlyphExtent(_getGlyphColumns(*ch, columns), &left, &width));
+
+        if(width == 0) {
+            Call(_appendColumns(strip, NULL, CLOCK_TEXT_SPACE_WIDTH));
+        } else {
+            Call(_appendColumns(strip, columns + left, width));
+        }
+    }
+
+    Call(_appendColumns(strip, NULL, (text + strlen(text) - end) * CLOCK_SCREEN_WIDTH));
+
+    if(strip->size < CLOCK_SCREEN_WIDTH) {
+        Call(_appendColumns(strip, NULL, CLOCK_SCREEN_WIDTH - strip->size));
+    }
+
+    return 0;
+}
+
+//
+// @brief compiles a UTF-8 _text_ into a strip of columns with the glyphs of _font_.
+//        Every glyph takes its width from the font, which already includes the
+//        spacing after it
+// @param strip the result will be written here
+// @param font a loaded font
+// @param text a UTF-8 text to compile
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _font_ is NULL
+//          if _text_ is NULL
+//          if _text_ is empty
+// ERANGE - if the strip doesn't fit CLOCK_TEXT_MAX_COLUMNS
+//
+int clock_text_prepareFont(ClockText *strip, const ClockFont *font, const char *text)
+{
+    NullCheck(strip);
+    NullCheck(font);
+    NullCheck(text);
+
+#ifdef PARAM_CHECKS
+    if(*text == '\0')
+        OriginateErrorEx(EINVAL, "%d", "text should not be empty");
+#endif
+
+    strip->size = 0;
+
+    for(uint32_t codepoint; (codepoint = clock_font_decodeUtf8(&text)) != 0; ) {
+        unsigned int         glyph;
+        const unsigned char *columns;
+        unsigned int         width;
+
+        Call(clock_font_findGlyph(font, codepoint, &glyph));
+        Call(clock_font_getGlyph(font, glyph, &columns, &width));
+
+        //
+        // The columns may be in ROM, so they are read one by one and
+        // appended like the ones of the alphabet, which checks the size
+        //
+        unsigned char glyphColumns[CLOCK_SCREEN_WIDTH];
+        for(unsigned int x = 0; x < width; ++x) {
+            glyphColumns[x] = romReadByte(columns + x);
+        }
+        Call(_appendColumns(strip, glyphColumns, width));
+    }
+
+    if(strip->size < CLOCK_SCREEN_WIDTH) {
+        Call(_appendColumns(strip, NULL, CLOCK_SCREEN_WIDTH - strip->size));
+    }
+
+    return 0;
+}
+
+//
+// @brief starts compiling a text column by column
+// @param stream
+// @param text a plain text or NULL if _packed_ is given
+// @param packed a packed text or NULL if _text_ is given
+// @param font if not NULL, the text is UTF-8 shown with this font
+// @param spacing the number of blank columns between glyphs of the alphabet
+// @returns 0 on success
+// EINVAL - if _stream_ is NULL
+//          if both _text_ and _packed_ or none of them are given
+//          if the text is empty
+//
+int clock_text_openStream(ClockTextStream *stream, const char *text, const unsigned char *packed,
+                          const ClockFont *font, unsigned int spacing)
+{
+    NullCheck(stream);
+
+#ifdef PARAM_CHECKS
+    if((text == NULL) == (packed == NULL))
+        OriginateErrorEx(EINVAL, "%d", "either text or packed text should be given");
+#endif
+
+    memset(stream, 0, sizeof(ClockTextStream));
+    stream->text    = text;
+    stream->font    = font;
+    stream->spacing = spacing;
+
+    if(packed) {
+        clock_packed_begin(&(stream->reader), packed);
+    }
+
+#ifdef PARAM_CHECKS
+    ClockPackedReader reader = stream->reader;
+    if(text ? *text == '\0' : clock_packed_next(&reader) == '\0')
+        OriginateErrorEx(EINVAL, "%d", "text should not be empty");
+#endif
+
+    return 0;
+}
+
+//
+// @brief continues the plain text of a stream with another text, so that a
+//        text made of two parts is compiled without copying them together
+// @param stream a stream opened with a plain text, before its first column is read
+// @param text the text which follows [ *text != '\0' ]
+// @returns 0 on success
+// EINVAL - if _stream_ is NULL
+//          if _text_ is NULL
+//          if _text_ is empty
+//          if _stream_ is packed or already continued
+//
+int clock_text_continueStream(ClockTextStream *stream, const char *text)
+{
+    NullCheck(stream);
+    NullCheck(text);
+
+#ifdef PARAM_CHECKS
+    if(*text == '\0')
+        OriginateErrorEx(EINVAL, "%d", "text should not be empty");
+    if(stream->text == NULL || stream->nextText != NULL)
+        OriginateErrorEx(EINVAL, "%d", "only a plain text which is not continued yet may be continued");
+#endif
+
+    stream->nextText = text;
+
+    return 0;
+}
+
+//
+// @brief reads the next character or codepoint of a stream
+// @returns the character or 0 at the end of the text
+//
+static uint32_t _readCharacter(ClockTextStream *stream)
+{
+    if(stream->text == NULL) {
+        return (unsigned char)clock_packed_next(&(stream->reader));
+    }
+
+    for(;;) {
+        uint32_t ch;
+
+        if(stream->font) {
+            ch = clock_font_decodeUtf8(&(stream->text));
+        } else {
+            ch = (unsigned char)*(stream->text);
+            if(ch != '\0') ++(stream->text);
+        }
+
+        if(ch != 0 || stream->nextText == NULL) return ch;
+
+        stream->text     = stream->nextText;
+        stream->nextText = NULL;
+    }
+}
+
+//
+// @brief compiles the next character of a stream into _blankColumns_ and
+//        the columns of its glyph. Blanks are only counted until the next
+//        glyph, because the leading and the trailing ones are wider than
+//        the ones between words. See clock_text_prepareProportional()
+// @returns 0 on success
+//
+static int _readGlyph(ClockTextStream *stream)
+{
+    const uint32_t ch = _readCharacter(stream);
+
+    if(ch == 0) {
+        stream->isTextEnd    = TRUE;
+        stream->blankColumns = stream->blanks * CLOCK_SCREEN_WIDTH;
+        stream->blanks       = 0;
+        return 0;
+    }
+
+    if(stream->font) {
+        unsigned int glyph;
+
+        Call(clock_font_findGlyph(stream->font, ch, &glyph));
+        Call(clock_font_getGlyph(stream->font, glyph, &(stream->columns), &(stream->glyphColumns)));
+        return 0;
+    }
+
+    int index = CLOCK_BLANK;
+    clock_alphabet_getIndexByCharacter((unsigned char)ch, &index);
+
+    if(index == CLOCK_BLANK) {
+        ++(stream->blanks);
+        return 0;
+    }
+
+    unsigned int left;
+    clock_alphabet_getGlyphColumns(index, &(stream->columns), &left, &(stream->glyphColumns));
+
+    if(stream->hasGlyph) {
+        stream->blankColumns = stream->blanks * (stream->spacing + CLOCK_TEXT_SPACE_WIDTH) + stream->spacing;
+    } else {
+        stream->blankColumns = stream->blanks * CLOCK_SCREEN_WIDTH;
+    }
+
+    stream->blanks   = 0;
+    stream->hasGlyph = TRUE;
+
+    return 0;
+}
+
+//
+// @brief reads the next column of a stream
+// @param stream
+// @param column the column will be written here
+// @param isEnd is set to TRUE if there are no more columns
+// @returns 0 on success
+// EINVAL - if _stream_ is NULL
+//          if _column_ is NULL
+//          if _isEnd_ is NULL
+//
+int clock_text_readColumn(ClockTextStream *stream, unsigned char *column, Bool *isEnd)
+{
+    NullCheck(stream);
+    NullCheck(column);
+    NullCheck(isEnd);
+
+    for(;;) {
+        if(stream->blankColumns) {
+            --(stream->blankColumns);
+            *column = 0;
+            break;
+        }
+
+        if(stream->glyphColumns) {
+            --(stream->glyphColumns);
+            *column = romReadByte(stream->columns);
+            ++(stream->columns);
+            break;
+        }
+
+        if(stream->isTextEnd) {
+            //
+            // A text narrower than the screen is padded with blank columns
+            //
+            if(stream->size >= CLOCK_SCREEN_WIDTH) {
+                *isEnd = TRUE;
+                return 0;
+            }
+            stream->blankColumns = CLOCK_SCREEN_WIDTH - stream->size;
+            continue;
+        }
+
+        Call(_readGlyph(stream));
+    }
+
+    ++(stream->size);
+    *isEnd = FALSE;
+
+    return 0;
+}
+
+//
+// @brief makes a frame of a single column at the right edge of the screen
+//
+static ClockFrame _rightColumn(unsigned char column)
+{
+    ClockFrame frame = CLOCK_FRAME_BLANK;
+
+    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        frame |= (ClockFrame)((column >> (CLOCK_SCREEN_HEIGHT - 1 - y)) & 1) << (y * CLOCK_SCREEN_WIDTH);
+    }
+
+    return frame;
+}
+
+//
+// @brief gets the next window of a stream. The first call gets the window
+//        of step 0 and every next call moves it by one column
+// @param stream
+// @param isLastStep is an output variable which if set to non zero value indicates the last iteration
+// @param frame resulting frame will be written here
+// @returns 0 on success
+// EINVAL - if _stream_ is NULL
+//          if _isLastStep_ is NULL
+//          if _frame_ is NULL
+//          if the last window was already read
+//
+int clock_text_streamWindow(ClockTextStream *stream, Bool *isLastStep, ClockFrame *frame)
+{
+    NullCheck(stream);
+    NullCheck(isLastStep);
+    NullCheck(frame);
+
+    unsigned char column;
+    Bool          isEnd;
+
+    if(!stream->hasWindow) {
+        //
+        // A stream always has at least a screen of columns
+        //
+        for(unsigned int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+            Call(clock_text_readColumn(stream, &column, &isEnd));
+            stream->window = clock_frame_shiftLeft(stream->window, 1, 0) | _rightColumn(column);
+        }
+        stream->hasWindow = TRUE;
+    } else {
+        if(!stream->hasNext) {
+#ifdef PARAM_CHECKS
+            OriginateErrorEx(EINVAL, "%d", "the last window was already read");
+#else
+            *isLastStep = TRUE;
+            return 0;
+#endif
+        }
+        stream->window = clock_frame_shiftLeft(stream->window, 1, 0) | _rightColumn(stream->next);
+    }
+
+    Call(clock_text_readColumn(stream, &(stream->next), &isEnd));
+    stream->hasNext = !isEnd;
+
+    *isLastStep = isEnd;
+    *frame      = stream->window;
+
+    return 0;
+}
+
+//
+// @brief compiles the rest of a stream into a strip
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _stream_ is NULL
+// ERANGE - if the strip doesn't fit CLOCK_TEXT_MAX_COLUMNS
+//
+int clock_text_prepareStream(ClockText *strip, ClockTextStream *stream)
+{
+    NullCheck(strip);
+    NullCheck(stream);
+
+    strip->size = 0;
+
+    for(;;) {
+        unsigned char column;
+        Bool          isEnd;
+
+        Call(clock_text_readColumn(stream, &column, &isEnd));
+        if(isEnd) break;
+
+        Call(_appendColumns(strip, &column, 1));
+    }
+
+    return 0;
+}
+
+//
+// @brief extracts a window of the strip which starts at column _step_
+// @param strip a strip prepared with clock_text_prepare(), clock_text_prepareProportional()
+//        or clock_text_prepareFont()
+// @param step indicates current iteration [ step <= strip->size - CLOCK_SCREEN_WIDTH ]
+// @param isLastStep is an output variable which if set to non zero value indicates the last iteration
+// @param frame resulting frame will be written here
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _step_ > strip->size - CLOCK_SCREEN_WIDTH
+//          if _isLastStep_ is NULL
+//          if _frame_ is NULL
+//
+int clock_text_window(const ClockText *strip, size_t step, Bool *isLastStep, ClockFrame *frame)
+{
+    NullCheck(strip);
+    NullCheck(isLastStep);
+    NullCheck(frame);
+
+    size_t lastStep = strip->size - CLOCK_SCREEN_WIDTH;
+
+#ifdef PARAM_CHECKS
+    if(strip->size < CLOCK_SCREEN_WIDTH || step > lastStep)
+        OriginateErrorEx(EINVAL, "%d", "step[%zu] should be <= %zu for a strip of %zu columns",
+                                       step, lastStep, strip->size);
+#else
+    if(step > lastStep) {
+        *isLastStep = TRUE;
+        return 0;
+    }
+#endif
+
+    *isLastStep = step == lastStep;
+    *frame = clock_frame_transpose(clock_frame_fromPattern(strip->columns + step));
+
+    return 0;
+}
@@ -0,0 +1,227 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock prepared text. A text is compiled once into a strip
+//        of glyph columns, so that every step of sliding it is just
+//        a window extraction which costs the same for any text length.
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_TEXT_H
+#define BINARY_CLOCK_LIB_CLOCK_TEXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock.h"
+#include "clock_font.h"
+#include "clock_packed.h"
+
+//
+// The maximum number of characters which a strip can hold.
+// May be overridden at build time to save memory.
+//
+#ifndef CLOCK_TEXT_MAX_LENGTH
+#define CLOCK_TEXT_MAX_LENGTH 100U
+#endif
+
+#define CLOCK_TEXT_MAX_COLUMNS ( CLOCK_TEXT_MAX_LENGTH * CLOCK_SCREEN_WIDTH )
+
+//
+// The number of columns of a space between words in a proportional strip
+//
+#define CLOCK_TEXT_SPACE_WIDTH 2U
+
+//
+// The default number of blank columns between glyphs in a proportional strip
+//
+#define CLOCK_TEXT_DEFAULT_SPACING 1U
+
+//
+// A text compiled into columns. Column x of the strip is columns[x],
+// the most significant bit of which is the top pixel (the same order as
+// in ClockAlphabet rows)
+//
+typedef struct {
+    size_t        size;                             // the number of columns in the strip
+    unsigned char columns[CLOCK_TEXT_MAX_COLUMNS];  // the columns of the strip
+} ClockText;
+
+//
+// A text which is compiled column by column while it slides, so that it
+// needs neither a strip nor an unpacked copy of a packed text. The columns
+// are the same as of clock_text_prepareProportional() or clock_text_prepareFont()
+//
+typedef struct {
+    const char          *text;           // the plain text or NULL if it is packed
+    const char          *nextText;       // the plain text which follows _text_ or NULL
+    ClockPackedReader    reader;         // the packed text
+    const ClockFont     *font;           // if not NULL, the text is UTF-8 shown with this font
+    unsigned int         spacing;        // blank columns between glyphs of the alphabet
+    const unsigned char *columns;        // the next column of the current glyph, may be in ROM
+    unsigned int         glyphColumns;   // the number of columns of the current glyph left
+    size_t               blankColumns;   // the number of blank columns before the current glyph
+    size_t               blanks;         // the number of blank characters since the last glyph
+    size_t               size;           // the number of columns read so far
+    Bool                 hasGlyph;       // TRUE after the first glyph which is not blank
+    Bool                 isTextEnd;      // TRUE after the last character
+    Bool                 hasWindow;      // TRUE after the first window
+    Bool                 hasNext;        // TRUE if _next_ is the column after the window
+    unsigned char        next;
+    ClockFrame           window;         // the last window
+} ClockTextStream;
+
+//
+// @brief compiles _text_ into a strip of columns. Characters which don't
+//        have a glyph are compiled as blanks the same way clock_slideText()
+//        shows them.
+// @param strip the result will be written here
+// @param text a text to compile
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _text_ is NULL
+//          if _text_ is empty
+// ERANGE - if _text_ is longer than CLOCK_TEXT_MAX_LENGTH
+//
+int clock_text_prepare(ClockText *strip, const char *text);
+
+//
+// @brief compiles _text_ into a strip of columns where every glyph takes
+//        only the columns which its bitmap uses (see clock_alphabet_getGlyphExtent())
+//        and _spacing_ blank columns separate neighbor glyphs. Blanks take
+//        CLOCK_TEXT_SPACE_WIDTH columns, except for the leading and the trailing
+//        ones which take the whole screen width as in clock_text_prepare(), so
+//        that a slide still starts and ends on a whole blank screen.
+//        A strip narrower than the screen is padded with blank columns.
+// @param strip the result will be written here
+// @param text a text to compile
+// @param spacing the number of blank columns between glyphs
+//        (CLOCK_TEXT_DEFAULT_SPACING is a good one)
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _text_ is NULL
+//          if _text_ is empty
+// ERANGE - if the strip doesn't fit CLOCK_TEXT_MAX_COLUMNS
+//
+int clock_text_prepareProportional(ClockText *strip, const char *text, unsigned int spacing);
+
+//
+// @brief compiles a UTF-8 _text_ into a strip of columns with the glyphs of
+//        _font_. Every glyph takes the width which the font gives it, so the
+//        spacing comes from the font too. Codepoints which the font doesn't
+//        have are compiled as its default glyph. A strip narrower than the
+//        screen is padded with blank columns.
+// @param strip the result will be written here
+// @param font a loaded font
+// @param text a UTF-8 text to compile
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _font_ is NULL
+//          if _text_ is NULL
+//          if _text_ is empty
+// ERANGE - if the strip doesn't fit CLOCK_TEXT_MAX_COLUMNS
+//
+int clock_text_prepareFont(ClockText *strip, const ClockFont *font, const char *text);
+
+//
+// @brief starts compiling a text column by column
+// @param stream
+// @param text a plain text or NULL if _packed_ is given
+// @param packed a packed text (see clock_packed.h), which may be a ROM_DATA table,
+//        or NULL if _text_ is given
+// @param font if not NULL, the text is UTF-8 and it is compiled as with
+//        clock_text_prepareFont(). Otherwise it is compiled as with
+//        clock_text_prepareProportional()
+// @param spacing the number of blank columns between glyphs of the alphabet
+// @returns 0 on success
+// EINVAL - if _stream_ is NULL
+//          if both _text_ and _packed_ or none of them are given
+//          if the text is empty
+//
+int clock_text_openStream(ClockTextStream *stream, const char *text, const unsigned char *packed,
+                          const ClockFont *font, unsigned int spacing);
+
+//
+// @brief continues the plain text of a stream with another text, so that a
+//        text made of two parts is compiled without copying them together
+// @param stream a stream opened with a plain text, before its first column is read
+// @param text the text which follows [ *text != '\0' ]
+// @returns 0 on success
+// EINVAL - if _stream_ is NULL
+//          if _text_ is NULL
+//          if _text_ is empty
+//          if _stream_ is packed or already continued
+//
+int clock_text_continueStream(ClockTextStream *stream, const char *text);
+
+//
+// @brief reads the next column of a stream
+// @param stream
+// @param column the column will be written here
+// @param isEnd is set to TRUE if there are no more columns. _column_ is
+//        not written then
+// @returns 0 on success
+// EINVAL - if _stream_ is NULL
+//          if _column_ is NULL
+//          if _isEnd_ is NULL
+//
+int clock_text_readColumn(ClockTextStream *stream, unsigned char *column, Bool *isEnd);
+
+//
+// @brief gets the next window of a stream. The first call gets the window
+//        of step 0 and every next call moves it by one column, so the
+//        windows are the same as of clock_text_window() over a strip of the
+//        same text. Every step costs the same and reads a single column.
+// @param stream
+// @param isLastStep is an output variable which if set to non zero value indicates the last iteration
+// @param frame resulting frame will be written here
+// @returns 0 on success
+// EINVAL - if _stream_ is NULL
+//          if _isLastStep_ is NULL
+//          if _frame_ is NULL
+//          if the last window was already read
+//
+int clock_text_streamWindow(ClockTextStream *stream, Bool *isLastStep, ClockFrame *frame);
+
+//
+// @brief compiles the rest of a stream into a strip, i.e. for a panel
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _stream_ is NULL
+// ERANGE - if the strip doesn't fit CLOCK_TEXT_MAX_COLUMNS
+//
+int clock_text_prepareStream(ClockText *strip, ClockTextStream *stream);
+
+//
+// @brief extracts a window of the strip which starts at column _step_.
+//        For a strip from clock_text_prepare() the result is the same as
+//        clock_slideText() of the text which the strip was prepared from.
+// @param strip a strip prepared with clock_text_prepare(), clock_text_prepareProportional()
+//        or clock_text_prepareFont()
+// @param step indicates current iteration [ step <= strip->size - CLOCK_SCREEN_WIDTH ]
+// @param isLastStep is an output variable which if set to non zero value indicates the last iteration
+// @param frame resulting frame will be written here
+// @returns 0 on success
+// EINVAL - if _strip_ is NULL
+//          if _step_ > strip->size - CLOCK_SCREEN_WIDTH
+//          if _isLastStep_ is NULL
+//          if _frame_ is NULL
+//
+int clock_text_window(const ClockText *strip, size_t step, Bool *isLastStep, ClockFrame *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
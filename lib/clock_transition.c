@@ -0,0 +1,124 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock transitions
+//
+
+#ifdef PARAM_CHECKS
+#include <errno.h>
+
+#include <logger.h>
+#endif
+
+#include "clock_transition.h"
+
+//
+// The pixels of the new frame at every step of CLOCK_TRANSITION_CHECKERBOARD.
+// Step k shows the pixels which 8x8 Bayer matrix threshold is less than 8 * k,
+// so step 4 is a checkerboard.
+//
+static const ClockFrame CheckerboardMasks[CLOCK_TRANSITION_STEPS + 1] ROM_DATA = {
+    0x0000000000000000ULL,
+    0x0022008800220088ULL,
+    0x00aa00aa00aa00aaULL,
+    0x11aa44aa11aa44aaULL,
+    0x55aa55aa55aa55aaULL,
+    0x55bb55ee55bb55eeULL,
+    0x55ff55ff55ff55ffULL,
+    0x77ffddff77ffddffULL,
+    0xffffffffffffffffULL,
+};
+
+//
+// The pixels of the new frame at every step of CLOCK_TRANSITION_DISSOLVE.
+// Step k shows the first 8 * k pixels of a fixed random permutation of all
+// the 64 pixels.
+//
+static const ClockFrame DissolveMasks[CLOCK_TRANSITION_STEPS + 1] ROM_DATA = {
+    0x0000000000000000ULL,
+    0x20008000120100c1ULL,
+    0xa0008442128116c1ULL,
+    0xa8009c4612817ec9ULL,
+    0xa840de6712a37ee9ULL,
+    0xa861de6717b3ffedULL,
+    0xbc69ff6717fbffefULL,
+    0xbee9ffffbffbffefULL,
+    0xffffffffffffffffULL,
+};
+
+//
+// @brief takes the pixels of _to_ which are set in _mask_ and the rest of _from_
+//
+#define blendMasked(from, to, mask) ( ((from) & ~(mask)) | ((to) & (mask)) )
+
+//
+// @brief blends two frames
+// @param type one of CLOCK_TRANSITION_*
+// @param from the old frame
+// @param to the new frame
+// @param step [ step <= CLOCK_TRANSITION_STEPS ]
+// @param result the blended frame will be written here
+// @returns 0 on success
+// EINVAL - if _type_ is unknown
+//          if _step_ > CLOCK_TRANSITION_STEPS
+//          if _result_ is NULL
+//
+int clock_transition_blend(unsigned int type, ClockFrame from, ClockFrame to, unsigned int step, ClockFrame *result)
+{
+    NullCheck(result);
+
+#ifdef PARAM_CHECKS
+    if(step > CLOCK_TRANSITION_STEPS)
+        OriginateErrorEx(EINVAL, "%d", "step[%u] should be <= %u", step, CLOCK_TRANSITION_STEPS);
+#endif
+
+    switch(type) {
+        case CLOCK_TRANSITION_NONE:
+            *result = to;
+            break;
+
+        case CLOCK_TRANSITION_SCROLL_UP:
+            *result = clock_frame_shiftUp(from, step, 0) | clock_frame_shiftDown(to, CLOCK_TRANSITION_STEPS - step, 0);
+            break;
+
+        case CLOCK_TRANSITION_SCROLL_DOWN:
+            *result = clock_frame_shiftDown(from, step, 0) | clock_frame_shiftUp(to, CLOCK_TRANSITION_STEPS - step, 0);
+            break;
+
+        case CLOCK_TRANSITION_WIPE_RIGHT:
+            *result = blendMasked(from, to, clock_frame_replicateRow(0xff00U >> step));
+            break;
+
+        case CLOCK_TRANSITION_WIPE_DOWN:
+            *result = blendMasked(from, to, ~((CLOCK_FRAME_FULL << (step << 2)) << (step << 2)));
+            break;
+
+        case CLOCK_TRANSITION_CHECKERBOARD:
+            *result = blendMasked(from, to, romReadQword(&CheckerboardMasks[step]));
+            break;
+
+        case CLOCK_TRANSITION_DISSOLVE:
+            *result = blendMasked(from, to, romReadQword(&DissolveMasks[step]));
+            break;
+
+        default:
+#ifdef PARAM_CHECKS
+            OriginateErrorEx(EINVAL, "%d", "transition type[%u] is unknown", type);
+#else
+            *result = to;
+#endif
+    }
+
+    return 0;
+}
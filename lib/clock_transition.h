@@ -0,0 +1,74 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock transitions. A transition blends two frames in
+//        CLOCK_TRANSITION_STEPS steps. Every step is a couple of shifts or
+//        a precomputed mask, so it costs a few word operations.
+//
+
+#ifndef BINARY_CLOCK_LIB_CLOCK_TRANSITION_H
+#define BINARY_CLOCK_LIB_CLOCK_TRANSITION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "clock.h"
+
+//
+// CLOCK_TRANSITION_NONE         - the new frame replaces the old one at once
+// CLOCK_TRANSITION_SCROLL_UP    - the new frame pushes the old one up
+// CLOCK_TRANSITION_SCROLL_DOWN  - the new frame pushes the old one down
+// CLOCK_TRANSITION_WIPE_RIGHT   - the new frame covers the old one from left to right
+// CLOCK_TRANSITION_WIPE_DOWN    - the new frame covers the old one from top to bottom
+// CLOCK_TRANSITION_CHECKERBOARD - the new frame shows up in an ordered dither,
+//                                 which is a checkerboard half way through
+// CLOCK_TRANSITION_DISSOLVE     - the new frame shows up pixel by pixel in
+//                                 a fixed random order
+//
+#define CLOCK_TRANSITION_NONE           0U
+#define CLOCK_TRANSITION_SCROLL_UP      1U
+#define CLOCK_TRANSITION_SCROLL_DOWN    2U
+#define CLOCK_TRANSITION_WIPE_RIGHT     3U
+#define CLOCK_TRANSITION_WIPE_DOWN      4U
+#define CLOCK_TRANSITION_CHECKERBOARD   5U
+#define CLOCK_TRANSITION_DISSOLVE       6U
+
+#define CLOCK_TRANSITION_COUNT          7U
+
+//
+// The number of steps of every transition. Step 0 is the old frame,
+// step CLOCK_TRANSITION_STEPS is the new one
+//
+#define CLOCK_TRANSITION_STEPS          8U
+
+//
+// @brief blends two frames
+// @param type one of CLOCK_TRANSITION_*
+// @param from the old frame
+// @param to the new frame
+// @param step [ step <= CLOCK_TRANSITION_STEPS ]
+// @param result the blended frame will be written here
+// @returns 0 on success
+// EINVAL - if _type_ is unknown
+//          if _step_ > CLOCK_TRANSITION_STEPS
+//          if _result_ is NULL
+//
+int clock_transition_blend(unsigned int type, ClockFrame from, ClockFrame to, unsigned int step, ClockFrame *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -48,6 +48,28 @@ const char *DateTimeDayOfWeekStr[] = { "Sunday", "Monday", "Tuesday", "Wednesday
     } \
 }
 
+//
+// The number of days in every month of a common year and the number of days
+// in a common year before every month
+//
+static const unsigned char DaysInMonth[] ROM_DATA = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+static const uint16_t DaysBeforeMonth[] ROM_DATA = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+//
+// @brief checks whether _year_ is in DateTimeYears
+//
+#define _isInTable(year) \
+    ( (year) >= DATE_TIME_TABLE_FIRST_YEAR && (year) < DATE_TIME_TABLE_FIRST_YEAR + DATE_TIME_TABLE_YEARS )
+
+static Bool _isLeapYear(int year)
+{
+    if(_isInTable(year)) {
+        return (romReadByte(&DateTimeYears[year - DATE_TIME_TABLE_FIRST_YEAR]) & DATE_TIME_YEAR_LEAP) ? TRUE : FALSE;
+    }
+
+    return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) ? TRUE : FALSE;
+}
+
 static int _daysInMonth(int month, int year)
 {
     if(month < JANUARY) {
@@ -55,26 +77,27 @@ static int _daysInMonth(int month, int year)
         month = DECEMBER;
     }
 
-    switch(month) {
-        case JANUARY:
-        case MARCH:
-        case MAY:
-        case JULY:
-        case AUGUST:
-        case OCTOBER:
-        case DECEMBER:
-            return 31;
-
-        case FEBRUARY:
-            return (year % 4 == 0) ? 29 : 28;
-
-        default:
-            return 30;
-    };
+    return romReadByte(&DaysInMonth[month]) + (month == FEBRUARY && _isLeapYear(year));
+}
+
+//
+// @brief gets the number of days in _year_ before _month_
+//
+static int _daysBeforeMonth(int year, int month)
+{
+    return romReadWord(&DaysBeforeMonth[month]) + (month > FEBRUARY && _isLeapYear(year));
 }
 
 static int _dayOfWeek(int year, int month, int day)
 {
+    //
+    // A year of the table knows the day of week of its January 1
+    //
+    if(_isInTable(year)) {
+        const unsigned int first = romReadByte(&DateTimeYears[year - DATE_TIME_TABLE_FIRST_YEAR]) & DATE_TIME_YEAR_WEEKDAY_MASK;
+        return (int)((first + (unsigned int)_daysBeforeMonth(year, month) + (unsigned int)day - 1) % 7);
+    }
+
     //
     // Gauss's algorithm
     // to determine day of week in Gregorian Calendar
@@ -113,6 +136,69 @@ inline static void _normalize(int *minor, int *major, int minorBase)
     }
 }
 
+//
+// @brief checks that the time fields of _dt_ are in their ranges, so that
+//        adding less than a second carries at most one unit into every field
+//
+#define _isTimeNormal(dt) \
+    ( (unsigned int)(dt)->millisecond < 1000 && (unsigned int)(dt)->second < 60 && \
+      (unsigned int)(dt)->minute < 60 && (unsigned int)(dt)->hour < HOURS_COUNT )
+
+//
+// @brief floor division, which rounds negative quotients down too
+//
+inline static long _floorDiv(long a, long b)
+{
+    return (a >= 0) ? a / b : -((b - 1 - a) / b);
+}
+
+//
+// The calendar below is counted in eras of 400 years from March, so that
+// the leap day is the last day of a year. Every era has the same
+// DAYS_IN_AN_ERA days
+//
+#define YEARS_IN_AN_ERA 400
+#define DAYS_IN_AN_ERA  146097L
+
+//
+// @brief gets the serial number of a day. Day 0 is March 1, year 0
+// @param year
+// @param month [ JANUARY <= month <= DECEMBER ]
+// @param day [ day >= 1 ], a day past the end of the month goes on to the next months
+//
+static long _daysFromCivil(int year, int month, int day)
+{
+    //
+    // A year starts in March, so January and February are the end of the previous one
+    //
+    const long y = (long)year - (month < MARCH);
+
+    const long era         = _floorDiv(y, YEARS_IN_AN_ERA);
+    const long yearOfEra   = y - era * YEARS_IN_AN_ERA;            // [0, 399]
+    const long monthOfYear = (month + 12 - MARCH) % 12;            // March is 0
+    const long dayOfYear   = (153 * monthOfYear + 2) / 5 + day - 1;
+
+    return era * DAYS_IN_AN_ERA + yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+}
+
+//
+// @brief sets the year, the month and the day of _dt_ from the serial
+//        number of a day, see _daysFromCivil()
+//
+static void _civilFromDays(long days, DateTime *dt)
+{
+    const long era         = _floorDiv(days, DAYS_IN_AN_ERA);
+    const long dayOfEra    = days - era * DAYS_IN_AN_ERA;                             // [0, 146096]
+    const long yearOfEra   = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524
+                           - dayOfEra / (DAYS_IN_AN_ERA - 1)) / 365;                   // [0, 399]
+    const long dayOfYear   = dayOfEra - (yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100); // [0, 365]
+    const long monthOfYear = (5 * dayOfYear + 2) / 153;                               // [0, 11], March is 0
+
+    dt->day   = (int)(dayOfYear - (153 * monthOfYear + 2) / 5 + 1);
+    dt->month = (int)((monthOfYear + MARCH) % 12);
+    dt->year  = (int)(era * YEARS_IN_AN_ERA + yearOfEra + (dt->month < MARCH));
+}
+
 //
 // @brief returns the number of days in a month
 // @param year
@@ -146,6 +232,8 @@ int date_time_daysInMonth(int year, int month, int *daysInMonth)
 // @returns 0 on success
 // EINVAL - if _dt_ is NULL
 //
+// @note It takes the same time for an excess of a day or of a hundred years
+//
 // @note When dealing with underflows, day 0 will mean previous month
 //       last day. Day -1 will mean previous month, last day -1, i.e.
 //
@@ -167,43 +255,14 @@ int date_time_normalize(DateTime *dt)
     _normalize(&(dt->hour),        &(dt->day), HOURS_COUNT);
 
     //
-    // Now process month overflow and underflow.
-    // Days will be processed afterwards, because they
-    // depend on a month
+    // Now process month overflow and underflow, then move the day to
+    // the day number of the first day of the month plus _day_ - 1 and
+    // back. It costs the same for any excess of days, and day 0 comes
+    // out as the last day of the previous month
     //
     _normalize(&(dt->month), &(dt->year), 12);
 
-    //
-    // Process day overflows
-    //
-    for(int d = _daysInMonth(dt->month, dt->year);
-        dt->day > d;
-        d = _daysInMonth(dt->month, dt->year)) {
-
-        dt->day -= d;
-        ++(dt->month);
-
-        if(dt->month > DECEMBER) {
-            dt->month = JANUARY;
-            ++(dt->year);
-        }
-    }
-
-    //
-    // Process day underflows
-    //
-    for(int d = _daysInMonth(dt->month - 1, dt->year);
-        dt->day < 1;
-        d = _daysInMonth(dt->month - 1, dt->year)) {
-
-        dt->day += d;
-        --(dt->month);
-
-        if(dt->month < JANUARY) {
-            dt->month = DECEMBER;
-            --(dt->year);
-        }
-    }
+    _civilFromDays(_daysFromCivil(dt->year, dt->month, 1) + dt->day - 1, dt);
 
     return 0;
 }
@@ -219,10 +278,36 @@ int date_time_normalize(DateTime *dt)
 //       uptime with lib/clock_time::clock_updateUptimeMillis()
 //       dateTime_addMillis() calls dateTime_normalize() internally.
 //
+// @note A delta below a second added to a normalized _dt_ takes no
+//       divisions, unless the day rolls over
+//
 int date_time_addMillis(DateTime *dt, unsigned long millis)
 {
     NullCheck(dt);
 
+    //
+    // The fast path for a tick of the main loop. It only ripples the carries
+    // with compares and subtractions, no divisions. A day rollover may roll
+    // the month and the year over, so it goes to the full normalization
+    //
+    if(millis < 1000 && _isTimeNormal(dt)) {
+        dt->millisecond += (int)millis;
+        if(dt->millisecond < 1000) return 0;
+
+        dt->millisecond -= 1000;
+        if(++(dt->second) < 60) return 0;
+
+        dt->second = 0;
+        if(++(dt->minute) < 60) return 0;
+
+        dt->minute = 0;
+        if(++(dt->hour) < HOURS_COUNT) return 0;
+
+        dt->hour = 0;
+        ++(dt->day);
+        millis = 0;
+    }
+
     //
     // Since _v_ is unsigned long and all of DateTime member variables
     // are int, first calculate days part, then start from the
@@ -244,6 +329,167 @@ int date_time_addMillis(DateTime *dt, unsigned long millis)
     return res;
 }
 
+//
+// @brief sets the time fields of _dt_ from the milliseconds since midnight
+//
+static void _setTimeOfDay(DateTime *dt, unsigned long millis)
+{
+    dt->millisecond = (int)(millis % 1000);
+    millis /= 1000;
+    dt->second = (int)(millis % 60);
+    millis /= 60;
+    dt->minute = (int)(millis % 60);
+    dt->hour   = (int)(millis / 60);
+}
+
+//
+// @brief gets a mask of DATE_TIME_*_CHANGED fields which differ in _a_ and _b_
+//
+static unsigned int _changedFields(const DateTime *a, const DateTime *b)
+{
+    return (a->millisecond != b->millisecond ? DATE_TIME_MILLISECOND_CHANGED : 0)
+         | (a->second      != b->second      ? DATE_TIME_SECOND_CHANGED      : 0)
+         | (a->minute      != b->minute      ? DATE_TIME_MINUTE_CHANGED      : 0)
+         | (a->hour        != b->hour        ? DATE_TIME_HOUR_CHANGED        : 0)
+         | (a->day         != b->day         ? DATE_TIME_DAY_CHANGED         : 0)
+         | (a->month       != b->month       ? DATE_TIME_MONTH_CHANGED       : 0)
+         | (a->year        != b->year        ? DATE_TIME_YEAR_CHANGED        : 0);
+}
+
+//
+// @brief gets the serial number of the day of the epoch, see _daysFromCivil()
+//
+#define _epochDays() _daysFromCivil(1970, JANUARY, 1)
+
+//
+// @brief converts a date and time to milliseconds since the epoch
+// @param dt the fields may be out of their ranges, they are normalized
+//        the same way date_time_normalize() does
+// @param epoch the result will be written here
+// @returns 0 on success
+// EINVAL - if _dt_ is NULL
+//          if _epoch_ is NULL
+//
+// @note It takes the same time for any date
+//
+int date_time_toEpoch(const DateTime *dt, DateTimeEpoch *epoch)
+{
+    NullCheck(dt);
+    NullCheck(epoch);
+
+    int year  = dt->year;
+    int month = dt->month;
+    _normalize(&month, &year, 12);
+
+    const long days = _daysFromCivil(year, month, 1) + dt->day - 1 - _epochDays();
+
+    *epoch = (DateTimeEpoch)days * MILLIS_IN_A_DAY
+           + (((DateTimeEpoch)dt->hour * 60 + dt->minute) * 60 + dt->second) * 1000
+           + dt->millisecond;
+
+    return 0;
+}
+
+//
+// @brief converts milliseconds since the epoch to a normalized date and time
+// @param epoch
+// @param dt the result will be written here
+// @returns 0 on success
+// EINVAL - if _dt_ is NULL
+//
+// @note It takes the same time for any date
+//
+int date_time_fromEpoch(DateTimeEpoch epoch, DateTime *dt)
+{
+    NullCheck(dt);
+
+    DateTimeEpoch days   = epoch / (DateTimeEpoch)MILLIS_IN_A_DAY;
+    long          millis = (long)(epoch - days * (DateTimeEpoch)MILLIS_IN_A_DAY);
+
+    if(millis < 0) {
+        millis += MILLIS_IN_A_DAY;
+        --days;
+    }
+
+    _civilFromDays((long)days + _epochDays(), dt);
+    _setTimeOfDay(dt, (unsigned long)millis);
+
+    return 0;
+}
+
+//
+// @brief sets a clock to a date and time
+// @param clock
+// @param dt the fields may be out of their ranges, see date_time_toEpoch()
+// @param changed if not NULL, a mask of DATE_TIME_*_CHANGED fields of
+//        _clock->dateTime_ which were changed will be written here
+// @returns 0 on success
+// EINVAL - if _clock_ is NULL
+//          if _dt_ is NULL
+//
+int date_time_clock_set(DateTimeClock *clock, const DateTime *dt, unsigned int *changed)
+{
+    NullCheck(clock);
+
+    Call(date_time_toEpoch(dt, &(clock->epoch)));
+
+    //
+    // Make the cached day stale, so that the refresh computes everything
+    //
+    clock->dayStart    = clock->epoch + MILLIS_IN_A_DAY;
+    clock->secondStart = clock->dayStart;
+
+    Call(date_time_clock_refresh(clock, changed));
+
+    return 0;
+}
+
+//
+// @brief brings _clock->dateTime_ up to _clock->epoch_. Within the same second
+//        only the milliseconds are updated, within the same day only the time
+//        fields are recomputed, and the date is recomputed only on another day
+// @param clock
+// @param changed if not NULL, a mask of DATE_TIME_*_CHANGED fields of
+//        _clock->dateTime_ which were changed will be written here
+// @returns 0 on success
+// EINVAL - if _clock_ is NULL
+//
+int date_time_clock_refresh(DateTimeClock *clock, unsigned int *changed)
+{
+    NullCheck(clock);
+
+    const DateTimeEpoch sinceSecond = clock->epoch - clock->secondStart;
+
+    if(sinceSecond >= 0 && sinceSecond < 1000) {
+        if(changed != NULL) {
+            *changed = (clock->dateTime.millisecond != (int)sinceSecond) ? DATE_TIME_MILLISECOND_CHANGED : 0;
+        }
+        clock->dateTime.millisecond = (int)sinceSecond;
+        return 0;
+    }
+
+    const DateTime old = clock->dateTime;
+    const DateTimeEpoch sinceDay = clock->epoch - clock->dayStart;
+
+    if(sinceDay >= 0 && sinceDay < (DateTimeEpoch)MILLIS_IN_A_DAY) {
+        _setTimeOfDay(&(clock->dateTime), (unsigned long)sinceDay);
+    } else {
+        Call(date_time_fromEpoch(clock->epoch, &(clock->dateTime)));
+        clock->dayStart = clock->epoch - ((((DateTimeEpoch)clock->dateTime.hour * 60
+                                        + clock->dateTime.minute) * 60
+                                        + clock->dateTime.second) * 1000
+                                        + clock->dateTime.millisecond);
+    }
+
+    clock->secondStart = clock->epoch - clock->dateTime.millisecond;
+
+    if(changed != NULL) {
+        *changed = _changedFields(&old, &(clock->dateTime));
+    }
+
+    return 0;
+}
+
 //
 // @brief prints time from _dt_ to _str_ in format
 //        hh:mm:ss
@@ -385,3 +631,69 @@ int date_time_calculateDayOfWeek(int year, int month, int day, int *dayOfWeek)
 
     return 0;
 }
+
+//
+// @brief converts a date to a day of year
+// @param year
+// @param month
+// @param day
+// @param dayOfYear the result will be written here. January 1 is 1
+// @returns 0 on ok
+// EINVAL if _dayOfYear_ is NULL
+// ERANGE if _month_ < JANUARY or _month_ > DECEMBER
+//        if _day_ < 0 or _day_ > daysInMonth(month)
+//
+int date_time_dayOfYear(int year, int month, int day, int *dayOfYear)
+{
+    NullCheck(dayOfYear);
+#ifdef PARAM_CHECKS
+    if(month < JANUARY || month > DECEMBER) {
+        OriginateErrorEx(ERANGE, "%d", "month = [%d] should be >= 0 and < 11", month);
+    }
+    int _d = _daysInMonth(month, year);
+    if(day <= 0 || day > _d) {
+        OriginateErrorEx(ERANGE, "%d", "day = [%d] should be > 0 and <= %d", day, _d);
+    }
+#endif
+
+    *dayOfYear = _daysBeforeMonth(year, month) + day;
+
+    return 0;
+}
+
+//
+// @brief converts a day of year to a date
+// @param year
+// @param dayOfYear January 1 is 1 [ 1 <= dayOfYear <= 365 or 366 in a leap year ]
+// @param month the result will be written here
+// @param day the result will be written here
+// @returns 0 on ok
+// EINVAL if _month_ or _day_ is NULL
+// ERANGE if _dayOfYear_ is out of range
+//
+int date_time_fromDayOfYear(int year, int dayOfYear, int *month, int *day)
+{
+    NullCheck(month);
+    NullCheck(day);
+#ifdef PARAM_CHECKS
+    int _d = 365 + _isLeapYear(year);
+    if(dayOfYear <= 0 || dayOfYear > _d) {
+        OriginateErrorEx(ERANGE, "%d", "dayOfYear = [%d] should be > 0 and <= %d", dayOfYear, _d);
+    }
+#endif
+
+    //
+    // No month is longer than 32 days and no two months are shorter than
+    // 32 days together, so (dayOfYear - 1) / 32 is either the month or
+    // the month before it. One comparison puts it right
+    //
+    int m = (dayOfYear - 1) >> 5;
+    if(m < DECEMBER && dayOfYear > _daysBeforeMonth(year, m + 1)) {
+        ++m;
+    }
+
+    *month = m;
+    *day   = dayOfYear - _daysBeforeMonth(year, m);
+
+    return 0;
+}
@@ -67,6 +67,47 @@ typedef struct {
 
 #define date_time_initDate(year, month, dayOfMonth) { year, month, dayOfMonth, 0, 0, 0, 0 }
 
+//
+// The fields of DateTime which a change of the time touched,
+// see date_time_clock_refresh()
+//
+#define DATE_TIME_MILLISECOND_CHANGED  0x01U
+#define DATE_TIME_SECOND_CHANGED       0x02U
+#define DATE_TIME_MINUTE_CHANGED       0x04U
+#define DATE_TIME_HOUR_CHANGED         0x08U
+#define DATE_TIME_DAY_CHANGED          0x10U
+#define DATE_TIME_MONTH_CHANGED        0x20U
+#define DATE_TIME_YEAR_CHANGED         0x40U
+#define DATE_TIME_ALL_CHANGED          0x7fU
+
+#define DATE_TIME_TIME_CHANGED ( DATE_TIME_SECOND_CHANGED | DATE_TIME_MINUTE_CHANGED | DATE_TIME_HOUR_CHANGED )
+#define DATE_TIME_DATE_CHANGED ( DATE_TIME_DAY_CHANGED | DATE_TIME_MONTH_CHANGED | DATE_TIME_YEAR_CHANGED )
+
+//
+// Milliseconds since January 1, 1970 00:00:00.000
+//
+typedef int64_t DateTimeEpoch;
+
+//
+// A clock which keeps the time as a single DateTimeEpoch and derives the
+// broken-down _dateTime_ from it lazily. Advancing the time is a single add
+// to _epoch_, and date_time_clock_refresh() does the calendar work only when
+// a second or a day boundary is crossed
+//
+typedef struct {
+    DateTimeEpoch epoch;         // the canonical time
+    DateTimeEpoch secondStart;   // the epoch of the beginning of the second of _dateTime_
+    DateTimeEpoch dayStart;      // the epoch of the beginning of the day of _dateTime_
+    DateTime      dateTime;      // the broken-down _epoch_ as of the last date_time_clock_refresh()
+} DateTimeClock;
+
+//
+// @brief advances a clock by _millis_. Call date_time_clock_refresh()
+//        before reading its _dateTime_
+// @warning _clock_ is not checked
+//
+#define date_time_clock_add(clock, millis) { (clock)->epoch += (millis); }
+
 //
 // @brief three letter month
 //
@@ -77,6 +118,20 @@ extern const char *DateTimeMonthsStr[];
 //
 extern const char *DateTimeDayOfWeekStr[];
 
+//
+// The Gregorian calendar of years [ DATE_TIME_TABLE_FIRST_YEAR,
+// DATE_TIME_TABLE_FIRST_YEAR + DATE_TIME_TABLE_YEARS ), one byte per year:
+// the day of week of January 1 and the leap year flag. The dates of those
+// years are looked up, the others are calculated
+//
+#define DATE_TIME_TABLE_FIRST_YEAR  2000
+#define DATE_TIME_TABLE_YEARS       256
+
+#define DATE_TIME_YEAR_WEEKDAY_MASK 0x07U
+#define DATE_TIME_YEAR_LEAP         0x08U
+
+extern const unsigned char DateTimeYears[DATE_TIME_TABLE_YEARS];
+
 //
 // @brief returns the number of days in a month
 // @param year
@@ -99,6 +154,8 @@ int date_time_daysInMonth(int year, int month, int *daysInMonth);
 // @returns 0 on success
 // EINVAL - if _dt_ is NULL
 //
+// @note It takes the same time for an excess of a day or of a hundred years
+//
 // @note When dealing with underflows, day 0 will mean previous month
 //       last day. Day -1 will mean previous month, last day -1, i.e.
 //
@@ -123,8 +180,59 @@ int date_time_normalize(DateTime *dt);
 //       uptime with lib/clock_time::clock_updateUptimeMillis().
 //       dateTime_addMillis() calls dateTime_normalize() internally.
 //
+// @note A delta below a second added to a normalized _dt_ takes no
+//       divisions, unless the day rolls over
+//
 int date_time_addMillis(DateTime *dt, unsigned long millis);
 
+//
+// @brief converts a date and time to milliseconds since the epoch
+// @param dt the fields may be out of their ranges, they are normalized
+//        the same way date_time_normalize() does
+// @param epoch the result will be written here
+// @returns 0 on success
+// EINVAL - if _dt_ is NULL
+//          if _epoch_ is NULL
+//
+// @note It takes the same time for any date
+//
+int date_time_toEpoch(const DateTime *dt, DateTimeEpoch *epoch);
+
+//
+// @brief converts milliseconds since the epoch to a normalized date and time
+// @param epoch
+// @param dt the result will be written here
+// @returns 0 on success
+// EINVAL - if _dt_ is NULL
+//
+// @note It takes the same time for any date
+//
+int date_time_fromEpoch(DateTimeEpoch epoch, DateTime *dt);
+
+//
+// @brief sets a clock to a date and time
+// @param clock
+// @param dt the fields may be out of their ranges, see date_time_toEpoch()
+// @param changed if not NULL, a mask of DATE_TIME_*_CHANGED fields of
+//        _clock->dateTime_ which were changed will be written here
+// @returns 0 on success
+// EINVAL - if _clock_ is NULL
+//          if _dt_ is NULL
+//
+int date_time_clock_set(DateTimeClock *clock, const DateTime *dt, unsigned int *changed);
+
+//
+// @brief brings _clock->dateTime_ up to _clock->epoch_. Within the same second
+//        only the milliseconds are updated, within the same day only the time
+//        fields are recomputed, and the date is recomputed only on another day
+// @param clock
+// @param changed if not NULL, a mask of DATE_TIME_*_CHANGED fields of
+//        _clock->dateTime_ which were changed will be written here
+// @returns 0 on success
+// EINVAL - if _clock_ is NULL
+//
+int date_time_clock_refresh(DateTimeClock *clock, unsigned int *changed);
+
 //
 // @brief prints time from _dt_ to _str_ in format
 //        hh:mm:ss
@@ -171,6 +279,31 @@ int date_time_dateToStr(const DateTime *dt, char str[DATE_TIME_DATE_STR_SIZE]);
 //
 int date_time_calculateDayOfWeek(int year, int month, int day, int *dayOfWeek);
 
+//
+// @brief converts a date to a day of year
+// @param year
+// @param month
+// @param day
+// @param dayOfYear the result will be written here. January 1 is 1
+// @returns 0 on ok
+// EINVAL if _dayOfYear_ is NULL
+// ERANGE if _month_ < JANUARY or _month_ > DECEMBER
+//        if _day_ < 0 or _day_ > daysInMonth(month)
+//
+int date_time_dayOfYear(int year, int month, int day, int *dayOfYear);
+
+//
+// @brief converts a day of year to a date
+// @param year
+// @param dayOfYear January 1 is 1 [ 1 <= dayOfYear <= 365 or 366 in a leap year ]
+// @param month the result will be written here
+// @param day the result will be written here
+// @returns 0 on ok
+// EINVAL if _month_ or _day_ is NULL
+// ERANGE if _dayOfYear_ is out of range
+//
+int date_time_fromDayOfYear(int year, int dayOfYear, int *month, int *day);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,46 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock Gregorian calendar
+//
+// @warning generated by tools/gen_frames, do not edit. Run 'make frames'
+//          from the top directory instead
+//
+
+#include "date_time.h"
+
+const unsigned char DateTimeYears[DATE_TIME_TABLE_YEARS] ROM_DATA = {
+    0x0e, 0x01, 0x02, 0x03, 0x0c, 0x06, 0x00, 0x01, 0x0a, 0x04, 0x05, 0x06,
+    0x08, 0x02, 0x03, 0x04, 0x0d, 0x00, 0x01, 0x02, 0x0b, 0x05, 0x06, 0x00,
+    0x09, 0x03, 0x04, 0x05, 0x0e, 0x01, 0x02, 0x03, 0x0c, 0x06, 0x00, 0x01,
+    0x0a, 0x04, 0x05, 0x06, 0x08, 0x02, 0x03, 0x04, 0x0d, 0x00, 0x01, 0x02,
+    0x0b, 0x05, 0x06, 0x00, 0x09, 0x03, 0x04, 0x05, 0x0e, 0x01, 0x02, 0x03,
+    0x0c, 0x06, 0x00, 0x01, 0x0a, 0x04, 0x05, 0x06, 0x08, 0x02, 0x03, 0x04,
+    0x0d, 0x00, 0x01, 0x02, 0x0b, 0x05, 0x06, 0x00, 0x09, 0x03, 0x04, 0x05,
+    0x0e, 0x01, 0x02, 0x03, 0x0c, 0x06, 0x00, 0x01, 0x0a, 0x04, 0x05, 0x06,
+    0x08, 0x02, 0x03, 0x04, 0x05, 0x06, 0x00, 0x01, 0x0a, 0x04, 0x05, 0x06,
+    0x08, 0x02, 0x03, 0x04, 0x0d, 0x00, 0x01, 0x02, 0x0b, 0x05, 0x06, 0x00,
+    0x09, 0x03, 0x04, 0x05, 0x0e, 0x01, 0x02, 0x03, 0x0c, 0x06, 0x00, 0x01,
+    0x0a, 0x04, 0x05, 0x06, 0x08, 0x02, 0x03, 0x04, 0x0d, 0x00, 0x01, 0x02,
+    0x0b, 0x05, 0x06, 0x00, 0x09, 0x03, 0x04, 0x05, 0x0e, 0x01, 0x02, 0x03,
+    0x0c, 0x06, 0x00, 0x01, 0x0a, 0x04, 0x05, 0x06, 0x08, 0x02, 0x03, 0x04,
+    0x0d, 0x00, 0x01, 0x02, 0x0b, 0x05, 0x06, 0x00, 0x09, 0x03, 0x04, 0x05,
+    0x0e, 0x01, 0x02, 0x03, 0x0c, 0x06, 0x00, 0x01, 0x0a, 0x04, 0x05, 0x06,
+    0x08, 0x02, 0x03, 0x04, 0x0d, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x08, 0x02, 0x03, 0x04, 0x0d, 0x00, 0x01, 0x02, 0x0b, 0x05, 0x06, 0x00,
+    0x09, 0x03, 0x04, 0x05, 0x0e, 0x01, 0x02, 0x03, 0x0c, 0x06, 0x00, 0x01,
+    0x0a, 0x04, 0x05, 0x06, 0x08, 0x02, 0x03, 0x04, 0x0d, 0x00, 0x01, 0x02,
+    0x0b, 0x05, 0x06, 0x00, 0x09, 0x03, 0x04, 0x05, 0x0e, 0x01, 0x02, 0x03,
+    0x0c, 0x06, 0x00, 0x01,
+};
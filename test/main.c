@@ -21,9 +21,20 @@
 #include "test.h"
 #include "ut_clock.h"
 #include "ut_clock_alphabet.h"
+#include "ut_clock_batch.h"
+#include "ut_clock_buffer.h"
+#include "ut_clock_cache.h"
 #include "ut_clock_button.h"
 #include "ut_clock_event.h"
+#include "ut_clock_event_db.h"
+#include "ut_clock_font.h"
+#include "ut_clock_main.h"
+#include "ut_clock_packed.h"
+#include "ut_clock_panel.h"
+#include "ut_clock_scan.h"
+#include "ut_clock_text.h"
 #include "ut_clock_time.h"
+#include "ut_clock_transition.h"
 #include "ut_date_time.h"
 
 FILE *errStream;
@@ -36,6 +47,17 @@ static TestUnit testSuites[] = {
     { ut_clock_button, "ut_clock_button", FALSE },
     { ut_clock_alphabet, "ut_clock_alphabet", FALSE },
     { ut_clock_event, "ut_clock_event", FALSE },
+    { ut_clock_event_db, "ut_clock_event_db", FALSE },
+    { ut_clock_text, "ut_clock_text", FALSE },
+    { ut_clock_panel, "ut_clock_panel", FALSE },
+    { ut_clock_transition, "ut_clock_transition", FALSE },
+    { ut_clock_scan, "ut_clock_scan", FALSE },
+    { ut_clock_batch, "ut_clock_batch", FALSE },
+    { ut_clock_buffer, "ut_clock_buffer", FALSE },
+    { ut_clock_cache, "ut_clock_cache", FALSE },
+    { ut_clock_font, "ut_clock_font", FALSE },
+    { ut_clock_packed, "ut_clock_packed", FALSE },
+    { ut_clock_main, "ut_clock_main", FALSE },
 };
 
 int main()
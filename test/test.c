@@ -21,9 +21,13 @@
 #include "test.h"
 
 static unsigned char Screen[CLOCK_PATTERN_SIZE] = { 0 };
+static unsigned int SetPixelCalls  = 0;
+static unsigned int DrawFrameCalls = 0;
 
 int test_setPixel(int x, int y, Bool turnOn)
 {
+    ++SetPixelCalls;
+
     if(x < 0 || x >= CLOCK_SCREEN_WIDTH)
         OriginateErrorEx(EINVAL, "%d", "x[%d] should be 0 < x < %d", x, CLOCK_SCREEN_WIDTH);
     if(y < 0 || y >= CLOCK_SCREEN_HEIGHT)
@@ -45,6 +49,32 @@ int test_clearScreen()
     return 0;
 }
 
+int test_drawFrame(const unsigned char rows[CLOCK_PATTERN_SIZE])
+{
+    NullCheck(rows);
+
+    ++DrawFrameCalls;
+    memcpy(Screen, rows, sizeof(Screen));
+
+    return 0;
+}
+
+void test_resetCallCounters()
+{
+    SetPixelCalls  = 0;
+    DrawFrameCalls = 0;
+}
+
+unsigned int test_getSetPixelCalls()
+{
+    return SetPixelCalls;
+}
+
+unsigned int test_getDrawFrameCalls()
+{
+    return DrawFrameCalls;
+}
+
 int test_compareScreenPattern(const unsigned char pattern[CLOCK_PATTERN_SIZE])
 {
     NullCheck(pattern);
@@ -25,6 +25,24 @@
 
 int test_setPixel(int x, int y, Bool turnOn);
 int test_clearScreen();
+int test_drawFrame(const unsigned char rows[CLOCK_PATTERN_SIZE]);
+
+//
+// @brief resets the counters of test_setPixel() and test_drawFrame() calls
+//
+void test_resetCallCounters();
+
+//
+// @brief returns how many times test_setPixel() was called since the last
+//        test_resetCallCounters()
+//
+unsigned int test_getSetPixelCalls();
+
+//
+// @brief returns how many times test_drawFrame() was called since the last
+//        test_resetCallCounters()
+//
+unsigned int test_getDrawFrameCalls();
 
 //
 // @brief compares the test screen to a given pattern
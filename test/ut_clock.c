@@ -240,11 +240,392 @@ static int test_clock_slideText_correct()
     return 0;
 }
 
+static int test_clock_drawPattern_drawFrame_correct()
+{
+    Call(test_clearScreen());
+
+    clock_extern_drawFrame = test_drawFrame;
+    test_resetCallCounters();
+
+    int res = clock_drawPattern(ClockAlphabet[CLOCK_8]);
+    clock_extern_drawFrame = NULL;
+    if(res) ContinueError(res, "%d");
+
+    assert_number(test_getDrawFrameCalls(), 1U, "%u", "%u");
+    assert_number(test_getSetPixelCalls(), 0U, "%u", "%u");
+
+    res = test_compareScreenPattern(ClockAlphabet[CLOCK_8]);
+    if(res) OriginateErrorEx(res, "%d", "pattern ClockAlphabet[CLOCK_8] doesn't match the screen");
+
+    return 0;
+}
+
+static int test_clock_displayTime_drawFrame_matchesSetPixel()
+{
+    DateTime dt = date_time_initDate(2014, APRIL, 13);
+    dt.hour   = 21;
+    dt.minute = 42;
+    dt.second = 59;
+
+    unsigned char expected[CLOCK_PATTERN_SIZE];
+
+    clock_clearScreen();
+    Call(clock_displayTime(&dt));
+    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        expected[y] = test_getScreenBits(y);
+    }
+
+    clock_clearScreen();
+
+    clock_extern_drawFrame = test_drawFrame;
+    test_resetCallCounters();
+
+    int res = clock_displayTime(&dt);
+    clock_extern_drawFrame = NULL;
+    if(res) ContinueError(res, "%d");
+
+    assert_number(test_getDrawFrameCalls(), 1U, "%u", "%u");
+    assert_number(test_getSetPixelCalls(), 0U, "%u", "%u");
+
+    res = test_compareScreenPattern(expected);
+    if(res) {
+        test_dumpScreenBits();
+        OriginateErrorEx(res, "%d", "clock_displayTime() drew different frames with and without clock_extern_drawFrame");
+    }
+
+    return 0;
+}
+
+static int test_clock_clearScreen_drawFrame_correct()
+{
+    int (* clearScreen)(void) = clock_extern_clearScreen;
+
+    Call(clock_drawPattern(ClockAlphabet[CLOCK_W]));
+
+    clock_extern_clearScreen = NULL;
+    clock_extern_drawFrame   = test_drawFrame;
+    test_resetCallCounters();
+
+    int res = clock_clearFrame();
+    clock_extern_clearScreen = clearScreen;
+    clock_extern_drawFrame   = NULL;
+    if(res) ContinueError(res, "%d");
+
+    assert_number(test_getDrawFrameCalls(), 1U, "%u", "%u");
+    assert_number(test_getSetPixelCalls(), 0U, "%u", "%u");
+
+    res = test_compareScreenPattern(ClockAlphabet[CLOCK_BLANK]);
+    if(res) OriginateErrorEx(res, "%d", "the screen is not blank");
+
+    return 0;
+}
+
+//
+// @brief counts the bits of _a_ which differ from _b_
+//
+static unsigned int countChangedPixels(
+    const unsigned char a[CLOCK_PATTERN_SIZE],
+    const unsigned char b[CLOCK_PATTERN_SIZE])
+{
+    unsigned int count = 0;
+
+    for(int i = 0; i < CLOCK_SCREEN_HEIGHT; ++i) {
+        for(unsigned char diff = a[i] ^ b[i]; diff; diff &= diff - 1) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+static int test_clock_setFlushPolicy_pixels_sendsOnlyChangedPixels()
+{
+    const unsigned char *from = ClockAlphabet[CLOCK_8];
+    const unsigned char *to   = ClockAlphabet[CLOCK_9];
+
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_PIXELS));
+    clock_clearScreen();
+    Call(clock_drawPattern(from));
+
+    test_resetCallCounters();
+    int res = clock_drawPattern(to);
+    if(res) {
+        clock_setFlushPolicy(CLOCK_FLUSH_ALL);
+        ContinueError(res, "%d");
+    }
+
+    const unsigned int changedPixelsCalls = test_getSetPixelCalls();
+
+    //
+    // Drawing the same pattern once again must not touch the screen at all
+    //
+    test_resetCallCounters();
+    res = clock_drawPattern(to);
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_ALL));
+    if(res) ContinueError(res, "%d");
+
+    assert_number(changedPixelsCalls, countChangedPixels(from, to), "%u", "%u");
+    assert_number(test_getSetPixelCalls(), 0U, "%u", "%u");
+
+    res = test_compareScreenPattern(to);
+    if(res) OriginateErrorEx(res, "%d", "pattern ClockAlphabet[CLOCK_9] doesn't match the screen");
+
+    return 0;
+}
+
+static int test_clock_setFlushPolicy_rows_sendsOnlyChangedRows()
+{
+    DateTime dt = date_time_initDate(2014, APRIL, 13);
+    dt.hour   = 12;
+    dt.minute = 30;
+    dt.second = 15;
+
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_ROWS));
+    clock_clearScreen();
+    Call(clock_displayTime(&dt));
+
+    //
+    // 15 = 0b00001111 -> 16 = 0b00010000 changes the 5 lowest rows
+    //
+    ++dt.second;
+
+    test_resetCallCounters();
+    int res = clock_displayTime(&dt);
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_ALL));
+    if(res) ContinueError(res, "%d");
+
+    assert_number(test_getSetPixelCalls(), 5U * CLOCK_SCREEN_WIDTH, "%u", "%u");
+
+    return 0;
+}
+
+static int test_clock_updateTime_redrawsOnlyChangedBars()
+{
+    DateTime oldDt = date_time_initDate(2014, APRIL, 13);
+    oldDt.hour   = 12;
+    oldDt.minute = 30;
+    oldDt.second = 15;
+
+    DateTime dt = oldDt;
+    ++dt.second;
+
+    unsigned char expected[CLOCK_PATTERN_SIZE];
+
+    clock_clearScreen();
+    Call(clock_displayTime(&dt));
+    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        expected[y] = test_getScreenBits(y);
+    }
+
+    clock_clearScreen();
+    Call(clock_displayTime(&oldDt));
+
+    //
+    // Only the seconds bar (2 columns) has to be sent
+    //
+    test_resetCallCounters();
+    Call(clock_updateTime(&dt, DATE_TIME_SECOND_CHANGED | DATE_TIME_MILLISECOND_CHANGED));
+    assert_number(test_getSetPixelCalls(), 2U * CLOCK_SCREEN_HEIGHT, "%u", "%u");
+
+    int res = test_compareScreenPattern(expected);
+    if(res) {
+        test_dumpScreenBits();
+        OriginateErrorEx(res, "%d", "clock_updateTime() and clock_displayTime() drew different frames");
+    }
+
+    //
+    // Nothing which the face shows has changed, so nothing has to be sent
+    //
+    test_resetCallCounters();
+    Call(clock_updateTime(&dt, DATE_TIME_MILLISECOND_CHANGED));
+    assert_number(test_getSetPixelCalls(), 0U, "%u", "%u");
+
+    return 0;
+}
+
+static int test_clock_updateDate_redrawsOnlyChangedBars()
+{
+    DateTime oldDt = date_time_initDate(2014, DECEMBER, 31);
+    DateTime dt    = date_time_initDate(2015, DECEMBER, 31);
+
+    unsigned char expected[CLOCK_PATTERN_SIZE];
+
+    clock_clearScreen();
+    Call(clock_displayDate(&dt));
+    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        expected[y] = test_getScreenBits(y);
+    }
+
+    clock_clearScreen();
+    Call(clock_displayDate(&oldDt));
+
+    //
+    // Only the year bar (2 columns) has to be sent
+    //
+    test_resetCallCounters();
+    Call(clock_updateDate(&dt, DATE_TIME_YEAR_CHANGED));
+    assert_number(test_getSetPixelCalls(), 2U * CLOCK_SCREEN_HEIGHT, "%u", "%u");
+
+    int res = test_compareScreenPattern(expected);
+    if(res) {
+        test_dumpScreenBits();
+        OriginateErrorEx(res, "%d", "clock_updateDate() and clock_displayDate() drew different frames");
+    }
+
+    return 0;
+}
+
+static int test_clock_setFlushPolicy_drawFrame_skipsUnchangedFrames()
+{
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_PIXELS));
+    clock_extern_drawFrame = test_drawFrame;
+
+    clock_clearScreen();
+
+    test_resetCallCounters();
+    int res = clock_drawPattern(ClockAlphabet[CLOCK_A]);
+    if(res == 0) res = clock_drawPattern(ClockAlphabet[CLOCK_A]);
+
+    clock_extern_drawFrame = NULL;
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_ALL));
+    if(res) ContinueError(res, "%d");
+
+    assert_number(test_getDrawFrameCalls(), 1U, "%u", "%u");
+
+    return 0;
+}
+
+//
+// Patterns for ClockFrame tests. None of them is symmetric.
+//
+static const unsigned char FramePatterns[][CLOCK_PATTERN_SIZE] = {
+    { 0x3c, 0x42, 0xa5, 0x81, 0x99, 0xa5, 0x42, 0x3c },
+    { 0x80, 0x40, 0x00, 0x01, 0xf0, 0x0f, 0x12, 0x34 },
+    { 0xff, 0x00, 0x81, 0x7e, 0x01, 0x02, 0x04, 0x09 },
+};
+
+typedef int (* ExpectedPixel)(ClockFrame frame, int x, int y);
+
+static int expectedMirror(ClockFrame f, int x, int y)    { return clock_frame_getPixel(f, CLOCK_SCREEN_WIDTH - x - 1, y); }
+static int expectedFlip(ClockFrame f, int x, int y)      { return clock_frame_getPixel(f, x, CLOCK_SCREEN_HEIGHT - y - 1); }
+static int expectedTranspose(ClockFrame f, int x, int y) { return clock_frame_getPixel(f, y, x); }
+static int expectedRotate90(ClockFrame f, int x, int y)  { return clock_frame_getPixel(f, y, CLOCK_SCREEN_WIDTH - x - 1); }
+static int expectedRotate180(ClockFrame f, int x, int y)
+{
+    return clock_frame_getPixel(f, CLOCK_SCREEN_WIDTH - x - 1, CLOCK_SCREEN_HEIGHT - y - 1);
+}
+
+static int validateFrame(ClockFrame actual, ClockFrame source, ExpectedPixel expected, const char *name)
+{
+    for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        for(int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+            if(clock_frame_getPixel(actual, x, y) != expected(source, x, y)) {
+                OriginateErrorEx(-1, "%d", "%s: pixel (%d, %d) is wrong. source = 0x%016llx, actual = 0x%016llx",
+                                 name, x, y, (unsigned long long)source, (unsigned long long)actual);
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_clock_frame_fromPattern_toPattern_correct()
+{
+    for(size_t i = 0; i < countof(FramePatterns); ++i) {
+        const ClockFrame frame = clock_frame_fromPattern(FramePatterns[i]);
+        unsigned char pattern[CLOCK_PATTERN_SIZE];
+
+        for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+            assert_int_ex(clock_frame_getRow(frame, y), FramePatterns[i][y], "i = %zu, y = %d", i, y);
+        }
+
+        clock_frame_toPattern(frame, pattern);
+        int res = validatePattern(FramePatterns[i], pattern);
+        if(res) ContinueErrorEx(res, "%d", "i = %zu", i);
+    }
+
+    return 0;
+}
+
+static int test_clock_frame_transformations_correct()
+{
+    for(size_t i = 0; i < countof(FramePatterns); ++i) {
+        const ClockFrame f = clock_frame_fromPattern(FramePatterns[i]);
+
+        Call(validateFrame(clock_frame_mirror(f),    f, expectedMirror,    "mirror"));
+        Call(validateFrame(clock_frame_flip(f),      f, expectedFlip,      "flip"));
+        Call(validateFrame(clock_frame_transpose(f), f, expectedTranspose, "transpose"));
+        Call(validateFrame(clock_frame_rotate90(f),  f, expectedRotate90,  "rotate90"));
+        Call(validateFrame(clock_frame_rotate180(f), f, expectedRotate180, "rotate180"));
+    }
+
+    return 0;
+}
+
+static int test_clock_frame_shifts_correct()
+{
+    for(size_t i = 0; i < countof(FramePatterns); ++i) {
+        const ClockFrame f = clock_frame_fromPattern(FramePatterns[i]);
+
+        for(int n = 0; n <= CLOCK_SCREEN_WIDTH; ++n) {
+            for(int fill = 0; fill <= 1; ++fill) {
+                const ClockFrame left  = clock_frame_shiftLeft(f, n, fill);
+                const ClockFrame right = clock_frame_shiftRight(f, n, fill);
+                const ClockFrame up    = clock_frame_shiftUp(f, n, fill);
+                const ClockFrame down  = clock_frame_shiftDown(f, n, fill);
+
+                for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+                    for(int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+                        int expected = x + n < CLOCK_SCREEN_WIDTH ? clock_frame_getPixel(f, x + n, y) : fill;
+                        assert_int_ex(clock_frame_getPixel(left, x, y), expected, "left i = %zu, n = %d, fill = %d, (%d, %d)", i, n, fill, x, y);
+
+                        expected = x - n >= 0 ? clock_frame_getPixel(f, x - n, y) : fill;
+                        assert_int_ex(clock_frame_getPixel(right, x, y), expected, "right i = %zu, n = %d, fill = %d, (%d, %d)", i, n, fill, x, y);
+
+                        expected = y + n < CLOCK_SCREEN_HEIGHT ? clock_frame_getPixel(f, x, y + n) : fill;
+                        assert_int_ex(clock_frame_getPixel(up, x, y), expected, "up i = %zu, n = %d, fill = %d, (%d, %d)", i, n, fill, x, y);
+
+                        expected = y - n >= 0 ? clock_frame_getPixel(f, x, y - n) : fill;
+                        assert_int_ex(clock_frame_getPixel(down, x, y), expected, "down i = %zu, n = %d, fill = %d, (%d, %d)", i, n, fill, x, y);
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_clock_drawFrame_correct()
+{
+    const ClockFrame frame = clock_frame_fromPattern(FramePatterns[1]);
+
+    clock_clearScreen();
+    Call(clock_drawFrame(frame));
+
+    int res = test_compareScreenPattern(FramePatterns[1]);
+    if(res) OriginateErrorEx(res, "%d", "the frame doesn't match the screen");
+
+    return 0;
+}
+
 static TestUnit testSuite[] = {
     { test_clock_slidePattern_returnsCorrectResult, "clock_slidePattern() returns correct result", FALSE },
     { test_clock_drawPattern_correct, "clock_drawPattern() correct", FALSE },
     { test_clock_displayBinaryNumber_correct, "clock_displayBinaryNumber() correct", FALSE },
     { test_clock_slideText_correct, "clock_slideText() correct", FALSE },
+    { test_clock_drawPattern_drawFrame_correct, "clock_drawPattern() with clock_extern_drawFrame correct", FALSE },
+    { test_clock_displayTime_drawFrame_matchesSetPixel, "clock_displayTime() with clock_extern_drawFrame matches clock_extern_setPixel", FALSE },
+    { test_clock_clearScreen_drawFrame_correct, "clock_clearScreen() with clock_extern_drawFrame correct", FALSE },
+    { test_clock_setFlushPolicy_pixels_sendsOnlyChangedPixels, "clock_setFlushPolicy(CLOCK_FLUSH_PIXELS) sends only changed pixels", FALSE },
+    { test_clock_setFlushPolicy_rows_sendsOnlyChangedRows, "clock_setFlushPolicy(CLOCK_FLUSH_ROWS) sends only changed rows", FALSE },
+    { test_clock_frame_fromPattern_toPattern_correct, "clock_frame_fromPattern() and clock_frame_toPattern() correct", FALSE },
+    { test_clock_frame_transformations_correct, "clock_frame mirror, flip, transpose and rotations correct", FALSE },
+    { test_clock_frame_shifts_correct, "clock_frame shifts correct", FALSE },
+    { test_clock_drawFrame_correct, "clock_drawFrame() correct", FALSE },
+    { test_clock_setFlushPolicy_drawFrame_skipsUnchangedFrames, "clock_setFlushPolicy() skips unchanged frames with clock_extern_drawFrame", FALSE },
+    { test_clock_updateTime_redrawsOnlyChangedBars, "clock_updateTime() redraws only changed bars", FALSE },
+    { test_clock_updateDate_redrawsOnlyChangedBars, "clock_updateDate() redraws only changed bars", FALSE },
 };
 
 int ut_clock()
@@ -39,20 +39,74 @@ static int test_clock_alphabet_getIndexByCharacter_correct()
     Call(clock_alphabet_getIndexByCharacter('\001', &index));
     assert_number(index, CLOCK_SMILEY_FACE_SMILE, "%d", "%d");
 
+    for(unsigned char ch = '0'; ch <= '9'; ++ch) {
+        Call(clock_alphabet_getIndexByCharacter(ch, &index));
+        assert_int_ex(index, CLOCK_0 + (ch - '0'), "ch = '%c'", ch);
+    }
+
+    for(unsigned char ch = 'A'; ch <= 'Z'; ++ch) {
+        Call(clock_alphabet_getIndexByCharacter(ch, &index));
+        assert_int_ex(index, CLOCK_A + (ch - 'A'), "ch = '%c'", ch);
+    }
+
+    for(unsigned char ch = 'a'; ch <= 'z'; ++ch) {
+        Call(clock_alphabet_getIndexByCharacter(ch, &index));
+        assert_int_ex(index, CLOCK_SMALL_A + (ch - 'a'), "ch = '%c'", ch);
+    }
+
+    Call(clock_alphabet_getIndexByCharacter('?', &index));
+    assert_number(index, CLOCK_QUESTION_MARK, "%d", "%d");
+
     return 0;
 }
 
 static int test_clock_alphabet_getIndexByCharacter_returns_ERANGE_andCorrectIndex()
 {
-    for(unsigned char ch = 'a'; ch <= 'z'; ++ch) {
-        Call(validate_getAlphabetIndexByCharacter_ERANGE(ch, CLOCK_A + (ch - 'a')));
-    }
+    Call(validate_getAlphabetIndexByCharacter_ERANGE('{', CLOCK_OPENING_PARENTHESES));
+    Call(validate_getAlphabetIndexByCharacter_ERANGE('}', CLOCK_CLOSING_PARENTHESES));
+    Call(validate_getAlphabetIndexByCharacter_ERANGE('`', CLOCK_TICK));
 
     //
     // Test a random character which is not defined in the alphabet.
     // Expected resulting index is CLOCK_BLANK.
     //
     Call(validate_getAlphabetIndexByCharacter_ERANGE('~', CLOCK_BLANK));
+    Call(validate_getAlphabetIndexByCharacter_ERANGE(0xff, CLOCK_BLANK));
+
+    return 0;
+}
+
+static int test_clock_alphabet_getGlyph_correct()
+{
+    for(int i = 0; i < CLOCK_ALPHABET_SIZE; ++i) {
+        assert_number_ex((unsigned long long)clock_alphabet_getGlyph(i),
+                         (unsigned long long)clock_frame_fromPattern(ClockAlphabet[i]),
+                         "%016llx", "%016llx", "index = %d", i);
+    }
+
+    return 0;
+}
+
+static int test_clock_alphabet_getGlyphExtent_correct()
+{
+    unsigned int left, width;
+
+    Call(clock_alphabet_getGlyphExtent(CLOCK_I, &left, &width));
+    assert_number(left, 2U, "%u", "%u");
+    assert_number(width, 3U, "%u", "%u");
+
+    Call(clock_alphabet_getGlyphExtent(CLOCK_W, &left, &width));
+    assert_number(left, 1U, "%u", "%u");
+    assert_number(width, 5U, "%u", "%u");
+
+    Call(clock_alphabet_getGlyphExtent(CLOCK_SMILEY_FACE_SMILE, &left, &width));
+    assert_number(left, 0U, "%u", "%u");
+    assert_number(width, (unsigned int)CLOCK_SCREEN_WIDTH, "%u", "%u");
+
+    Call(clock_alphabet_getGlyphExtent(CLOCK_BLANK, &left, &width));
+    assert_number(width, 0U, "%u", "%u");
+
+    assert_function(clock_alphabet_getGlyphExtent(CLOCK_ALPHABET_SIZE, &left, &width), ERANGE);
 
     return 0;
 }
@@ -60,6 +114,8 @@ static int test_clock_alphabet_getIndexByCharacter_returns_ERANGE_andCorrectInde
 static TestUnit testSuite[] = {
     { test_clock_alphabet_getIndexByCharacter_correct, "clock_alphabet_getIndexByCharacter() correct", FALSE },
     { test_clock_alphabet_getIndexByCharacter_returns_ERANGE_andCorrectIndex, "clock_alphabet_getIndexByCharacter() returns ERANGE and correct index", FALSE },
+    { test_clock_alphabet_getGlyph_correct, "clock_alphabet_getGlyph() correct", FALSE },
+    { test_clock_alphabet_getGlyphExtent_correct, "clock_alphabet_getGlyphExtent() correct", FALSE },
 };
 
 int ut_clock_alphabet()
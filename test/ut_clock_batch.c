@@ -0,0 +1,163 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_batch unit tests
+//
+
+#include <clock_batch.h>
+#include <clock_state.h>
+
+#include "test.h"
+#include "ut_clock_batch.h"
+
+#define DATE_TIMES_COUNT 37
+
+static const char *PathNames[CLOCK_BATCH_PATH_COUNT] = { "auto", "scalar", "sse2", "avx2" };
+
+static ClockText Strip;
+
+//
+// @brief fills _dts_ with a fixed pseudo random sequence of valid DateTimes
+//
+static void fillDateTimes(DateTime *dts, size_t count)
+{
+    unsigned long seed = 12345;
+
+    for(size_t i = 0; i < count; ++i) {
+        seed = seed * 1103515245UL + 12345UL;
+        const unsigned long r = (seed >> 8) & 0xffffffUL;
+
+        dts[i].year        = MIN_YEAR + (int)(r % (MAX_YEAR - MIN_YEAR + 1));
+        dts[i].month       = (int)(r % 12);
+        dts[i].day         = 1 + (int)(r % 31);
+        dts[i].hour        = (int)((r >> 3) % 24);
+        dts[i].minute      = (int)((r >> 5) % 60);
+        dts[i].second      = (int)((r >> 11) % 60);
+        dts[i].millisecond = 0;
+    }
+}
+
+static int test_clock_batch_renderFaces_sameAsDisplay()
+{
+    DateTime dts[DATE_TIMES_COUNT];
+    ClockFrame frames[DATE_TIMES_COUNT];
+    unsigned char pattern[CLOCK_PATTERN_SIZE];
+
+    fillDateTimes(dts, countof(dts));
+
+    for(unsigned int path = 0; path < CLOCK_BATCH_PATH_COUNT; ++path) {
+        if(!clock_batch_isSupported(path)) {
+            continue;
+        }
+
+        Call(clock_batch_setPath(path));
+
+        Call(clock_batch_renderTime(dts, countof(dts), frames));
+        for(size_t i = 0; i < countof(dts); ++i) {
+            clock_clearScreen();
+            Call(clock_displayTime(&dts[i]));
+            clock_frame_toPattern(frames[i], pattern);
+            CallEx(test_compareScreenPattern(pattern), "time %zu, path %s", i, PathNames[path]);
+        }
+
+        Call(clock_batch_renderDate(dts, countof(dts), frames));
+        for(size_t i = 0; i < countof(dts); ++i) {
+            clock_clearScreen();
+            Call(clock_displayDate(&dts[i]));
+            clock_frame_toPattern(frames[i], pattern);
+            CallEx(test_compareScreenPattern(pattern), "date %zu, path %s", i, PathNames[path]);
+        }
+    }
+
+    Call(clock_batch_setPath(CLOCK_BATCH_AUTO));
+
+    return 0;
+}
+
+static int test_clock_batch_slideText_sameAsSlideText()
+{
+    const char *text = "Batch 0123, slide!";
+    ClockFrame frames[CLOCK_TEXT_MAX_COLUMNS];
+    unsigned char pattern[CLOCK_PATTERN_SIZE];
+    Bool isLastStep;
+
+    Call(clock_text_prepare(&Strip, text));
+    const size_t steps = Strip.size - CLOCK_SCREEN_WIDTH + 1;
+
+    for(unsigned int path = 0; path < CLOCK_BATCH_PATH_COUNT; ++path) {
+        if(!clock_batch_isSupported(path)) {
+            continue;
+        }
+
+        Call(clock_batch_setPath(path));
+
+        //
+        // All the steps at once and a run which doesn't start at a glyph boundary
+        //
+        Call(clock_batch_slideText(&Strip, 0, steps, frames));
+        for(size_t step = 0; step < steps; ++step) {
+            Call(clock_slideText(text, step, &isLastStep, pattern));
+            const unsigned long long actual   = frames[step];
+            const unsigned long long expected = clock_frame_fromPattern(pattern);
+            assert_number_ex(actual, expected, "%016llx", "%016llx", "step %zu, path %s", step, PathNames[path]);
+        }
+
+        Call(clock_batch_slideText(&Strip, 5, 19, frames));
+        for(size_t i = 0; i < 19; ++i) {
+            Call(clock_slideText(text, 5 + i, &isLastStep, pattern));
+            const unsigned long long actual   = frames[i];
+            const unsigned long long expected = clock_frame_fromPattern(pattern);
+            assert_number_ex(actual, expected, "%016llx", "%016llx", "step %zu, path %s", 5 + i, PathNames[path]);
+        }
+    }
+
+    Call(clock_batch_setPath(CLOCK_BATCH_AUTO));
+
+    return 0;
+}
+
+static int test_clock_batch_returnsErrors()
+{
+    ClockFrame frame;
+
+    Call(clock_text_prepare(&Strip, "AB"));
+
+    assert_function(clock_batch_setPath(CLOCK_BATCH_PATH_COUNT), EINVAL);
+    assert_function(clock_batch_renderTime(NULL, 1, &frame), EINVAL);
+    assert_function(clock_batch_renderDate(NULL, 1, &frame), EINVAL);
+    assert_function(clock_batch_slideText(&Strip, 8, 2, &frame), EINVAL);
+    assert_function(clock_batch_slideText(&Strip, 9, 1, &frame), EINVAL);
+    Call(clock_batch_slideText(&Strip, 8, 1, &frame));
+
+    Call(clock_batch_setPath(CLOCK_BATCH_SCALAR));
+    assert_int(clock_batch_getPath(), CLOCK_BATCH_SCALAR);
+    Call(clock_batch_setPath(CLOCK_BATCH_AUTO));
+
+    const unsigned int path = clock_batch_getPath();
+    assert_true((path != CLOCK_BATCH_AUTO));
+    assert_true(clock_batch_isSupported(path));
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_batch_renderFaces_sameAsDisplay, "clock_batch_renderTime() and clock_batch_renderDate() same as display", FALSE },
+    { test_clock_batch_slideText_sameAsSlideText, "clock_batch_slideText() same as clock_slideText()", FALSE },
+    { test_clock_batch_returnsErrors, "clock_batch returns errors", FALSE },
+};
+
+int ut_clock_batch()
+{
+    return runTestSuite(testSuite);
+}
@@ -0,0 +1,170 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_buffer unit tests
+//
+
+#include <pthread.h>
+
+#include <clock_alphabet.h>
+#include <clock_batch.h>
+#include <clock_buffer.h>
+
+#include "test.h"
+#include "ut_clock_buffer.h"
+
+#define PUBLISH_COUNT 200000UL
+
+//
+// Both 32 bit halves of a published frame hold the same counter, so a torn
+// frame is seen as halves which differ
+//
+#define counterFrame(counter) ( (ClockFrame)(counter) * 0x0000000100000001ULL )
+
+static ClockBuffer Buffer;
+
+static int test_clock_buffer_read_getsLatestFrame()
+{
+    const ClockFrame first  = clock_alphabet_getGlyph(CLOCK_A);
+    const ClockFrame second = clock_alphabet_getGlyph(CLOCK_B);
+    ClockFrame frame;
+    Bool isNew;
+
+    Call(clock_buffer_init(&Buffer));
+    Call(clock_buffer_read(&Buffer, &frame, &isNew));
+    assert_false(isNew);
+    assert_true((frame == CLOCK_FRAME_BLANK));
+
+    Call(clock_buffer_publish(&Buffer, first));
+    Call(clock_buffer_read(&Buffer, &frame, &isNew));
+    assert_true(isNew);
+    assert_true((frame == first));
+
+    //
+    // The reader skips the frames which it was too slow to see
+    //
+    Call(clock_buffer_publish(&Buffer, second));
+    Call(clock_buffer_publish(&Buffer, first));
+    Call(clock_buffer_publish(&Buffer, second));
+    Call(clock_buffer_read(&Buffer, &frame, &isNew));
+    assert_true(isNew);
+    assert_true((frame == second));
+
+    Call(clock_buffer_read(&Buffer, &frame, NULL));
+    assert_true((frame == second));
+    Call(clock_buffer_read(&Buffer, &frame, &isNew));
+    assert_false(isNew);
+
+    assert_function(clock_buffer_publish(NULL, first), EINVAL);
+    assert_function(clock_buffer_read(&Buffer, NULL, &isNew), EINVAL);
+
+    return 0;
+}
+
+static void *writeFrames(void *arg)
+{
+    (void)arg;
+
+    for(unsigned long counter = 1; counter <= PUBLISH_COUNT; ++counter) {
+        clock_buffer_publish(&Buffer, counterFrame(counter));
+    }
+
+    return NULL;
+}
+
+static int test_clock_buffer_read_neverTorn()
+{
+    const ClockFrame last = counterFrame(PUBLISH_COUNT);
+    ClockFrame frame = CLOCK_FRAME_BLANK;
+    ClockFrame previous = CLOCK_FRAME_BLANK;
+    pthread_t writer;
+
+    Call(clock_buffer_init(&Buffer));
+    Call(pthread_create(&writer, NULL, writeFrames, NULL));
+
+    while(frame != last) {
+        Call(clock_buffer_read(&Buffer, &frame, NULL));
+
+        const unsigned long counter = (unsigned long)(frame & 0xffffffffUL);
+        if(frame != counterFrame(counter)) {
+            pthread_join(writer, NULL);
+            OriginateErrorEx(EFAULT, "%d", "frame %016llx is torn", (unsigned long long)frame);
+        }
+
+        //
+        // The counter never wraps, so a frame never goes back. The reader
+        // may miss any number of frames while it is not scheduled
+        //
+        if(frame < previous) {
+            pthread_join(writer, NULL);
+            OriginateErrorEx(EFAULT, "%d", "frame %016llx came after %016llx",
+                                           (unsigned long long)frame, (unsigned long long)previous);
+        }
+
+        previous = frame;
+    }
+
+    Call(pthread_join(writer, NULL));
+
+    return 0;
+}
+
+static int test_clock_readFrame_getsFramesWithoutFlush()
+{
+    const DateTime dt = { 2014, FEBRUARY, 21, 12, 34, 56, 0 };
+    ClockFrame expected;
+    ClockFrame frame;
+    Bool isNew;
+
+    Call(clock_batch_renderTime(&dt, 1, &expected));
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_NONE));
+    Call(clock_readFrame(&frame, NULL));
+
+    test_resetCallCounters();
+    clock_clearScreen();
+    int res = clock_displayTime(&dt);
+    if(res == 0) res = clock_readFrame(&frame, &isNew);
+
+    Call(clock_setFlushPolicy(CLOCK_FLUSH_ALL));
+    clock_clearScreen();
+    if(res) ContinueError(res, "%d");
+
+    assert_number(test_getSetPixelCalls(), 0U, "%u", "%u");
+    assert_true(isNew);
+    assert_true((frame == expected));
+
+    //
+    // Other policies publish the frames as well
+    //
+    Call(clock_readFrame(&frame, &isNew));
+    assert_true(isNew);
+    assert_true((frame == CLOCK_FRAME_BLANK));
+    Call(clock_readFrame(&frame, &isNew));
+    assert_false(isNew);
+
+    assert_function(clock_setFlushPolicy(CLOCK_FLUSH_NONE + 1), EINVAL);
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_buffer_read_getsLatestFrame, "clock_buffer_read() gets the latest frame", FALSE },
+    { test_clock_buffer_read_neverTorn, "clock_buffer_read() never gets a torn frame", FALSE },
+    { test_clock_readFrame_getsFramesWithoutFlush, "clock_readFrame() gets frames without flush", FALSE },
+};
+
+int ut_clock_buffer()
+{
+    return runTestSuite(testSuite);
+}
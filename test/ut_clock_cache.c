@@ -0,0 +1,136 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_cache unit tests
+//
+
+#include <string.h>
+
+#include <clock_cache.h>
+#include <clock_messages.h>
+#include <clock_packed.h>
+#include <clock_text.h>
+
+#include "test.h"
+#include "ut_clock_cache.h"
+
+static ClockText Strip;
+
+//
+// @brief unpacks a packed text to _text_
+//
+static void unpack(const unsigned char *packed, char *text)
+{
+    ClockPackedReader reader;
+
+    clock_packed_begin(&reader, packed);
+    while((*text++ = clock_packed_next(&reader)) != '\0') ;
+}
+
+static int test_clock_messages_framesUpToDate()
+{
+    char text[CLOCK_TEXT_MAX_LENGTH + 1];
+
+    for(size_t i = 0; i < ClockMessagesCount; ++i) {
+        const ClockCacheEntry *entry = &ClockMessages[i];
+
+        unpack(entry->packed, text);
+        Call(clock_text_prepareProportional(&Strip, text, CLOCK_TEXT_DEFAULT_SPACING));
+
+        const size_t steps = Strip.size - CLOCK_SCREEN_WIDTH + 1;
+        assert_number_ex(entry->count, steps, "%zu", "%zu", "'%s' is stale, run 'make frames'", text);
+
+        for(size_t step = 0; step < steps; ++step) {
+            ClockFrame expected, actual;
+            Bool isExpectedLast, isActualLast;
+
+            Call(clock_text_window(&Strip, step, &isExpectedLast, &expected));
+            Call(clock_cache_getFrame(entry, step, &isActualLast, &actual));
+
+            assert_number_ex((unsigned long long)actual, (unsigned long long)expected, "%016llx", "%016llx",
+                             "'%s' is stale at step %zu, run 'make frames'", text, step);
+            assert_int(isActualLast, isExpectedLast);
+        }
+    }
+
+    return 0;
+}
+
+static int test_clock_messages_packedUpToDate()
+{
+    char text[CLOCK_TEXT_MAX_LENGTH + 1];
+
+    unpack(ClockMessageHello, text);
+    assert_str(text, CLOCK_MESSAGE_HELLO);
+    unpack(ClockMessageNoEvents, text);
+    assert_str(text, CLOCK_MESSAGE_NO_EVENTS);
+
+    return 0;
+}
+
+static int test_clock_cache_find_findsByTable()
+{
+    unsigned char packed[clock_packed_size(CLOCK_TEXT_MAX_LENGTH)];
+    size_t packedSize;
+    const ClockCacheEntry *entry;
+
+    Call(clock_cache_find(ClockMessages, ClockMessagesCount, ClockMessageHello, &entry));
+    assert_true((entry == &ClockMessages[0]));
+    Call(clock_cache_find(ClockMessages, ClockMessagesCount, ClockMessageNoEvents, &entry));
+    assert_true((entry == &ClockMessages[1]));
+
+    //
+    // Only the tables themselves are cached, not their copies
+    //
+    Call(clock_packed_pack(CLOCK_MESSAGE_NO_EVENTS, packed, sizeof(packed), &packedSize));
+    Call(clock_cache_find(ClockMessages, ClockMessagesCount, packed, &entry));
+    assert_true((entry == NULL));
+    Call(clock_cache_find(NULL, 0, ClockMessageHello, &entry));
+    assert_true((entry == NULL));
+
+    assert_function(clock_cache_find(ClockMessages, ClockMessagesCount, NULL, &entry), EINVAL);
+    assert_function(clock_cache_find(NULL, 1, ClockMessageHello, &entry), EINVAL);
+
+    return 0;
+}
+
+static int test_clock_cache_getFrame_returnsErrors()
+{
+    const ClockCacheEntry *entry = &ClockMessages[0];
+    ClockFrame frame;
+    Bool isLastStep;
+
+    Call(clock_cache_getFrame(entry, entry->count - 1, &isLastStep, &frame));
+    assert_true(isLastStep);
+    Call(clock_cache_getFrame(entry, 0, &isLastStep, &frame));
+    assert_false(isLastStep);
+
+    assert_function(clock_cache_getFrame(entry, entry->count, &isLastStep, &frame), EINVAL);
+    assert_function(clock_cache_getFrame(NULL, 0, &isLastStep, &frame), EINVAL);
+    assert_function(clock_cache_getFrame(entry, 0, NULL, &frame), EINVAL);
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_messages_framesUpToDate, "clock_messages frames are up to date", FALSE },
+    { test_clock_messages_packedUpToDate, "clock_messages packed texts are up to date", FALSE },
+    { test_clock_cache_find_findsByTable, "clock_cache_find() finds by table", FALSE },
+    { test_clock_cache_getFrame_returnsErrors, "clock_cache_getFrame() returns errors", FALSE },
+};
+
+int ut_clock_cache()
+{
+    return runTestSuite(testSuite);
+}
@@ -22,6 +22,17 @@
 #include <clock_event.h>
 #include "ut_clock_event.h"
 
+//
+// @brief binds _events_ to _list_ and initializes it for _year_
+//
+static int initList(ClockEventList *list, ClockEvent *events, ClockEventIndex *order, size_t sz, int year)
+{
+    Call( clock_event_setList(list, events, order, sz) );
+    Call( clock_event_initList(list, year) );
+
+    return 0;
+}
+
 static int test_clock_event_initDayOfMonth_correct()
 {
     const char name[] = "Fool's day";
@@ -156,7 +167,9 @@ static int test_clock_event_initList_correct()
     // code
     //
 
-    Call( clock_event_initList(events, countof(events), 2013) );
+    ClockEventList list;
+    ClockEventIndex order[countof(events)];
+    Call( initList(&list, events, order, countof(events), 2013) );
 
     for(size_t i = 0; i < countof(events); ++i) {
         assert_int_ex( clock_event_getDayOfWeek(events[i]) , details[i].dayOfWeek, "i = %zu", i);
@@ -214,15 +227,218 @@ static int test_clock_event_updateList_correct()
     // code
     //
 
-    Call( clock_event_initList(events, countof(events), year) );
-    Call( clock_event_updateList(events, countof(events), &dt) );
+    ClockEventList list;
+    ClockEventIndex order[countof(events)];
+    Call( initList(&list, events, order, countof(events), year) );
+    Call( clock_event_updateList(&list, &dt) );
 
     for(size_t i = 0; i < countof(events); ++i) {
-        assert_str_ex(events[i].name, eventsNames[i], "i = %zu", i);
-        assert_int_ex(events[i].yearCalculated, details[i].year, "i = %zu", i);
-        assert_int_ex( clock_event_getDayOfWeek(events[i]) , details[i].dayOfWeek, "i = %zu", i);
-        assert_int_ex( clock_event_getDayOfMonth(events[i]) , details[i].dayOfMonth, "i = %zu", i);
-        assert_int_ex( clock_event_getMonth(events[i]) , details[i].month, "i = %zu", i);
+        const ClockEvent *event = &clock_event_listAt(&list, i);
+        assert_str_ex(event->name, eventsNames[i], "i = %zu", i);
+        assert_int_ex(event->yearCalculated, details[i].year, "i = %zu", i);
+        assert_int_ex( clock_event_getDayOfWeek(*event) , details[i].dayOfWeek, "i = %zu", i);
+        assert_int_ex( clock_event_getDayOfMonth(*event) , details[i].dayOfMonth, "i = %zu", i);
+        assert_int_ex( clock_event_getMonth(*event) , details[i].month, "i = %zu", i);
+    }
+
+    return 0;
+}
+
+//
+// @brief checks _list_ updated for _dt_ against the dates of its events
+//        calculated from scratch
+//
+static int assert_listUpdated(const ClockEventList *list, const DateTime *dt)
+{
+    for(size_t i = 0; i < list->size; ++i) {
+        const ClockEvent *event = &clock_event_listAt(list, i);
+
+        //
+        // The order is sorted and the cursor points to the first event of today or later
+        //
+        if(i > 0) {
+            const ClockEvent *prev = &clock_event_listAt(list, i - 1);
+            int isSorted = clock_event_getMonth(*prev) < clock_event_getMonth(*event)
+                       || (clock_event_getMonth(*prev) == clock_event_getMonth(*event)
+                        && clock_event_getDayOfMonth(*prev) <= clock_event_getDayOfMonth(*event));
+            assert_int_ex(isSorted, TRUE, "%d/%d: i = %zu", dt->month, dt->day, i);
+        }
+
+        int isBefore = clock_event_getMonth(*event) < dt->month
+                    || (clock_event_getMonth(*event) == dt->month && clock_event_getDayOfMonth(*event) < dt->day);
+        assert_int_ex(isBefore, (i < list->cursor), "%d/%d: i = %zu", dt->month, dt->day, i);
+
+        //
+        // An event which has passed this year is on its next year's date
+        // if that one has passed too
+        //
+        ClockEventDetails details;
+        int year = dt->year;
+
+        Call( clock_event_getEventDetails(event, year, &details) );
+        if(details.month < dt->month || (details.month == dt->month && details.dayOfMonth < dt->day)) {
+            ClockEventDetails next;
+            Call( clock_event_getEventDetails(event, year + 1, &next) );
+            if(next.month < dt->month || (next.month == dt->month && next.dayOfMonth < dt->day)) {
+                details = next;
+                ++year;
+            }
+        }
+
+        assert_int_ex(event->yearCalculated, year, "%d/%d/%d: %s", dt->year, dt->month, dt->day, event->name);
+        assert_int_ex(clock_event_getMonth(*event), details.month, "%d/%d/%d: %s", dt->year, dt->month, dt->day, event->name);
+        assert_int_ex(clock_event_getDayOfMonth(*event), details.dayOfMonth, "%d/%d/%d: %s", dt->year, dt->month, dt->day, event->name);
+    }
+
+    return 0;
+}
+
+static int test_clock_event_updateList_dayByDay()
+{
+    ClockEvent events[] = {
+        clock_event_initDayOfWeek (THURSDAY, 3, WEEK_FROM_START, NOVEMBER, 1574, "Thanksgiving"),
+        clock_event_initDayOfMonth(25, DECEMBER,    0, "Christmas"),
+        clock_event_initDayOfYear (60, 2000, "Day 60"),
+        clock_event_initDayOfWeek (SUNDAY, 0, WEEK_FROM_END, DECEMBER, 2000, "Last Sunday"),
+        clock_event_initDayOfMonth(1,  JANUARY,     0, "New year"),
+        clock_event_initDayOfWeek (FRIDAY, 0, WEEK_FROM_END, JULY, 2000, "System Administrator Appreciation Day"),
+        clock_event_initDayOfMonth(28, FEBRUARY,    0, "February 28"),
+        clock_event_initDayOfYear (256, 2009, "Programmer's day"),
+        clock_event_initDayOfWeek (MONDAY, 0, WEEK_FROM_START, JANUARY, 2000, "First Monday"),
+    };
+
+    ClockEventList list;
+    ClockEventIndex order[countof(events)];
+    DateTime dt = date_time_initDate(2012, JANUARY, 1);
+
+    Call( initList(&list, events, order, countof(events), dt.year) );
+
+    //
+    // Every day forward
+    //
+    for(; dt.year < 2021; ) {
+        Call( clock_event_updateList(&list, &dt) );
+        Call( assert_listUpdated(&list, &dt) );
+
+        ++dt.day;
+        Call( date_time_normalize(&dt) );
+    }
+
+    //
+    // Jumps back and forth
+    //
+    const DateTime jumps[] = {
+        date_time_initDate(2020, NOVEMBER, 30),
+        date_time_initDate(2020, NOVEMBER, 20),
+        date_time_initDate(2020, DECEMBER, 31),
+        date_time_initDate(2020, JANUARY,   1),
+        date_time_initDate(2020, MARCH,     1),
+        date_time_initDate(2020, FEBRUARY, 29),
+        date_time_initDate(2020, SEPTEMBER, 30),
+    };
+
+    for(size_t i = 0; i < countof(jumps); ++i) {
+        Call( clock_event_updateList(&list, &jumps[i]) );
+        Call( assert_listUpdated(&list, &jumps[i]) );
+    }
+
+    return 0;
+}
+
+static int test_clock_event_calendar_sameAsWithout()
+{
+    ClockEvent events[] = {
+        clock_event_initDayOfWeek (THURSDAY, 3, WEEK_FROM_START, NOVEMBER, 1574, "Thanksgiving"),
+        clock_event_initDayOfMonth(25, DECEMBER,    0, "Christmas"),
+        clock_event_initDayOfYear (60, 2000, "Day 60"),
+        clock_event_initDayOfWeek (SUNDAY, 0, WEEK_FROM_END, DECEMBER, 2000, "Last Sunday"),
+        clock_event_initDayOfMonth(1,  JANUARY,     0, "New year"),
+        clock_event_initDayOfWeek (FRIDAY, 0, WEEK_FROM_END, JULY, 2000, "System Administrator Appreciation Day"),
+        clock_event_initDayOfYear (256, 2009, "Programmer's day"),
+    };
+    ClockEvent cachedEvents[countof(events)];
+    memcpy(cachedEvents, events, sizeof(events));
+
+    ClockEventList list;
+    ClockEventList cachedList;
+    ClockEventIndex order[countof(events)];
+    ClockEventIndex cachedOrder[countof(events)];
+    ClockEventCalendar calendar;
+    ClockEventDate dates[CLOCK_EVENT_CALENDAR_YEARS * countof(events)];
+
+    Call( clock_event_setList(&cachedList, cachedEvents, cachedOrder, countof(events)) );
+    Call( clock_event_setCalendar(&cachedList, &calendar, dates) );
+    Call( clock_event_initList(&cachedList, 2012) );
+    Call( initList(&list, events, order, countof(events), 2012) );
+
+    //
+    // Scroll the years back and forth as the date setting does, further
+    // than the calendar keeps, and go through some days of every year
+    //
+    const int years[] = { 2012, 2013, 2014, 2013, 2020, 2012, 2019, 2015, 2016, 2017, 2018, 2014, 2013 };
+
+    for(size_t y = 0; y < countof(years); ++y) {
+        DateTime dt = date_time_initDate(years[y], JANUARY, 1);
+
+        if(y > 0) {
+            Call( clock_event_initList(&cachedList, dt.year) );
+            Call( clock_event_initList(&list, dt.year) );
+        }
+
+        for(; dt.year == years[y]; dt.day += 5, date_time_normalize(&dt)) {
+            Call( clock_event_updateList(&cachedList, &dt) );
+            Call( clock_event_updateList(&list, &dt) );
+
+            assert_int_ex((int)cachedList.cursor, (int)list.cursor, "%d/%d/%d", dt.year, dt.month, dt.day);
+            for(size_t i = 0; i < countof(events); ++i) {
+                assert_int_ex((int)cachedOrder[i], (int)order[i], "%d/%d/%d: i = %zu", dt.year, dt.month, dt.day, i);
+                assert_int_ex(cachedEvents[i].yearCalculated, events[i].yearCalculated, "%d/%d/%d: %s", dt.year, dt.month, dt.day, events[i].name);
+                assert_int_ex(cachedEvents[i].blob_1, events[i].blob_1, "%d/%d/%d: %s", dt.year, dt.month, dt.day, events[i].name);
+                assert_int_ex(cachedEvents[i].blob_2, events[i].blob_2, "%d/%d/%d: %s", dt.year, dt.month, dt.day, events[i].name);
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_clock_event_calendar_keepsRecentlyUsedYears()
+{
+    ClockEvent events[] = {
+        clock_event_initDayOfWeek (THURSDAY, 3, WEEK_FROM_START, NOVEMBER, 1574, "Thanksgiving"),
+    };
+
+    ClockEventList list;
+    ClockEventIndex order[countof(events)];
+    ClockEventCalendar calendar;
+    ClockEventDate dates[CLOCK_EVENT_CALENDAR_YEARS * countof(events)];
+
+    Call( clock_event_setList(&list, events, order, countof(events)) );
+    Call( clock_event_setCalendar(&list, &calendar, dates) );
+
+    const struct {
+        int year;
+        int dayOfMonth;
+        int years[CLOCK_EVENT_CALENDAR_YEARS];
+    } steps[] = {
+        { 2010, 25, { 2010, CLOCK_EVENT_YEAR_NOT_CALCULATED, CLOCK_EVENT_YEAR_NOT_CALCULATED, CLOCK_EVENT_YEAR_NOT_CALCULATED, CLOCK_EVENT_YEAR_NOT_CALCULATED } },
+        { 2011, 24, { 2011, 2010, CLOCK_EVENT_YEAR_NOT_CALCULATED, CLOCK_EVENT_YEAR_NOT_CALCULATED, CLOCK_EVENT_YEAR_NOT_CALCULATED } },
+        { 2012, 22, { 2012, 2011, 2010, CLOCK_EVENT_YEAR_NOT_CALCULATED, CLOCK_EVENT_YEAR_NOT_CALCULATED } },
+        { 2013, 28, { 2013, 2012, 2011, 2010, CLOCK_EVENT_YEAR_NOT_CALCULATED } },
+        { 2014, 27, { 2014, 2013, 2012, 2011, 2010 } },
+        { 2012, 22, { 2012, 2014, 2013, 2011, 2010 } },
+        { 2015, 26, { 2015, 2012, 2014, 2013, 2011 } },
+        { 2010, 25, { 2010, 2015, 2012, 2014, 2013 } },
+        { 2010, 25, { 2010, 2015, 2012, 2014, 2013 } },
+    };
+
+    for(size_t s = 0; s < countof(steps); ++s) {
+        Call( clock_event_initList(&list, steps[s].year) );
+
+        assert_int_ex(clock_event_getDayOfMonth(events[0]), steps[s].dayOfMonth, "s = %zu", s);
+        for(size_t y = 0; y < CLOCK_EVENT_CALENDAR_YEARS; ++y) {
+            assert_int_ex(calendar.years[y].year, steps[s].years[y], "s = %zu, y = %zu", s, y);
+        }
     }
 
     return 0;
@@ -262,12 +478,14 @@ static int test_clock_event_findClosestFromList_correct()
     // code
     //
 
-    Call( clock_event_initList(events, countof(events), year) );
-    Call( clock_event_updateList(events, countof(events), &dt) );
+    ClockEventList list;
+    ClockEventIndex order[countof(events)];
+    Call( initList(&list, events, order, countof(events), year) );
+    Call( clock_event_updateList(&list, &dt) );
 
     for(size_t i = 0; i < countof(eventsIndeces); ++i, ++eventIndex) {
         int index;
-        Call( clock_event_findClosestFromList( events, countof(events), eventIndex->month, eventIndex->day, &index) );
+        Call( clock_event_findClosestFromList( &list, eventIndex->month, eventIndex->day, &index) );
 
         assert_int_ex(index, eventIndex->index, "i = %zu", i);
     }
@@ -275,6 +493,101 @@ static int test_clock_event_findClosestFromList_correct()
     return 0;
 }
 
+static int test_clock_event_dayIndex_sameAsWithout()
+{
+    ClockEvent events[] = {
+        clock_event_initDayOfWeek (THURSDAY, 3, WEEK_FROM_START, NOVEMBER, 1574, "Thanksgiving"),
+        clock_event_initDayOfMonth(25, DECEMBER,    0, "Christmas"),
+        clock_event_initDayOfYear (60, 2000, "Day 60"),
+        clock_event_initDayOfWeek (SUNDAY, 0, WEEK_FROM_END, DECEMBER, 2000, "Last Sunday"),
+        clock_event_initDayOfMonth(25, DECEMBER,   10, "Another Christmas"),
+        clock_event_initDayOfWeek (FRIDAY, 0, WEEK_FROM_END, JULY, 2000, "System Administrator Appreciation Day"),
+    };
+    ClockEvent indexedEvents[countof(events)];
+    memcpy(indexedEvents, events, sizeof(events));
+
+    ClockEventList list;
+    ClockEventList indexedList;
+    ClockEventIndex order[countof(events)];
+    ClockEventIndex indexedOrder[countof(events)];
+    ClockEventDayIndex dayIndex;
+
+    Call( clock_event_setList(&indexedList, indexedEvents, indexedOrder, countof(events)) );
+    Call( clock_event_setDayIndex(&indexedList, &dayIndex) );
+    Call( clock_event_initList(&indexedList, 2012) );
+    Call( initList(&list, events, order, countof(events), 2012) );
+
+    for(DateTime dt = date_time_initDate(2012, JANUARY, 1); dt.year < 2014; ++dt.day, date_time_normalize(&dt)) {
+        Call( clock_event_updateList(&indexedList, &dt) );
+        Call( clock_event_updateList(&list, &dt) );
+
+        //
+        // Every day of a leap year
+        //
+        for(DateTime day = date_time_initDate(2000, JANUARY, 1); day.year == 2000; ++day.day, date_time_normalize(&day)) {
+            int index;
+            int indexedIndex;
+            Bool isEventDay;
+            Bool indexedIsEventDay;
+
+            Call( clock_event_findClosestFromList(&list, day.month, day.day, &index) );
+            Call( clock_event_findClosestFromList(&indexedList, day.month, day.day, &indexedIndex) );
+            assert_int_ex(indexedIndex, index, "%d/%d/%d: %d/%d", dt.year, dt.month, dt.day, day.month, day.day);
+
+            Call( clock_event_isEventDay(&list, day.month, day.day, &isEventDay) );
+            Call( clock_event_isEventDay(&indexedList, day.month, day.day, &indexedIsEventDay) );
+            assert_int_ex(indexedIsEventDay, isEventDay, "%d/%d/%d: %d/%d", dt.year, dt.month, dt.day, day.month, day.day);
+        }
+    }
+
+    return 0;
+}
+
+static int test_clock_event_isEventDay_correct()
+{
+    ClockEvent events[] = {
+        clock_event_initDayOfMonth(1,  JANUARY,     0, "New year"),
+        clock_event_initDayOfWeek (THURSDAY, 3, WEEK_FROM_START, NOVEMBER, 1574, "Thanksgiving"),
+        clock_event_initDayOfMonth(25, DECEMBER,    0, "Christmas"),
+    };
+
+    struct {
+        int  month;
+        int  day;
+        Bool isEventDay;
+    } days[] = {
+        { JANUARY,    1, TRUE },
+        { JANUARY,    2, FALSE },
+        { NOVEMBER,  22, FALSE },
+        { NOVEMBER,  28, TRUE },
+        { DECEMBER,  24, FALSE },
+        { DECEMBER,  25, TRUE },
+        { DECEMBER,  31, FALSE },
+    };
+
+    ClockEventList list;
+    ClockEventIndex order[countof(events)];
+    ClockEventDayIndex dayIndex;
+    const DateTime dt = date_time_initDate(2013, NOVEMBER, 28);
+
+    Call( initList(&list, events, order, countof(events), dt.year) );
+    Call( clock_event_updateList(&list, &dt) );
+
+    for(int withIndex = 0; withIndex < 2; ++withIndex) {
+        if(withIndex) {
+            Call( clock_event_setDayIndex(&list, &dayIndex) );
+        }
+
+        for(size_t i = 0; i < countof(days); ++i) {
+            Bool isEventDay;
+            Call( clock_event_isEventDay(&list, days[i].month, days[i].day, &isEventDay) );
+            assert_int_ex(isEventDay, days[i].isEventDay, "withIndex = %d, i = %zu", withIndex, i);
+        }
+    }
+
+    return 0;
+}
+
 static int test_clock_event_yearInfoToStr_correct()
 {
     ClockEvent events[] = {
@@ -302,12 +615,14 @@ static int test_clock_event_yearInfoToStr_correct()
     // code
     //
 
-    Call( clock_event_initList(events, countof(events), year) );
-    Call( clock_event_updateList(events, countof(events), &dt) );
+    ClockEventList list;
+    ClockEventIndex order[countof(events)];
+    Call( initList(&list, events, order, countof(events), year) );
+    Call( clock_event_updateList(&list, &dt) );
 
     for(size_t i = 0; i < countof(expectedStrs); ++i) {
         char str[EVENT_STRING_BUFFER_SIZE];
-        Call( clock_event_yearInfoToStr(events + i, str) );
+        Call( clock_event_yearInfoToStr(&clock_event_listAt(&list, i), str) );
         assert_str_ex(expectedStrs[i], str, "i = %zu", i);
     }
 
@@ -328,8 +643,10 @@ static int test_clock_event_yearInfoToStr_afterDateIncreaseDecrease_correct()
     // code
     //
 
-    Call( clock_event_initList(&event, 1, year) );
-    Call( clock_event_updateList(&event, 1, &dt) );
+    ClockEventList list;
+    ClockEventIndex order[1];
+    Call( initList(&list, &event, order, 1, year) );
+    Call( clock_event_updateList(&list, &dt) );
 
     char str[EVENT_STRING_BUFFER_SIZE];
 
@@ -337,12 +654,12 @@ static int test_clock_event_yearInfoToStr_afterDateIncreaseDecrease_correct()
     assert_str(expectedStr, str);
 
     dt.month++;
-    Call( clock_event_updateList(&event, 1, &dt) );
+    Call( clock_event_updateList(&list, &dt) );
     Call( clock_event_yearInfoToStr(&event, str) );
     assert_str(expectedNextStr, str);
 
     dt.month--;
-    Call( clock_event_updateList(&event, 1, &dt) );
+    Call( clock_event_updateList(&list, &dt) );
     Call( clock_event_yearInfoToStr(&event, str) );
     assert_str(expectedStr, str);
 
@@ -356,7 +673,12 @@ static TestUnit testSuite[] = {
     { test_clock_event_getEventDetails_correct, "clock_event_getEventDetails() is correct", FALSE },
     { test_clock_event_initList_correct, "clock_event_initList() is correct", FALSE },
     { test_clock_event_updateList_correct, "clock_event_updateList() is correct", FALSE },
+    { test_clock_event_updateList_dayByDay, "clock_event_updateList() day by day is the same as from scratch", FALSE },
+    { test_clock_event_calendar_sameAsWithout, "clock_event_setCalendar() doesn't change the dates of a list", FALSE },
+    { test_clock_event_calendar_keepsRecentlyUsedYears, "ClockEventCalendar keeps the recently used years", FALSE },
     { test_clock_event_findClosestFromList_correct, "clock_event_findClosestFromList() is correct", FALSE },
+    { test_clock_event_dayIndex_sameAsWithout, "clock_event_setDayIndex() doesn't change the closest events", FALSE },
+    { test_clock_event_isEventDay_correct, "clock_event_isEventDay() is correct", FALSE },
     { test_clock_event_yearInfoToStr_correct, "clock_event_yearInfoToStr() is correct", FALSE },
     { test_clock_event_yearInfoToStr_afterDateIncreaseDecrease_correct, "test_clock_event_yearInfoToStr_afterDateIncreaseDecrease_correct() is correct1", FALSE },
 };
@@ -0,0 +1,301 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_event_db unit tests
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include <clock_event_db.h>
+#include <clock_extern.h>
+#include <clock_main.h>
+
+#include "test.h"
+#include "ut_clock_event_db.h"
+
+//
+// These events compiled with 'event-db -y 2013':
+//
+// 12/25,0,Christmas
+// 11/thu/4,1863,Thanksgiving
+// 05/mon/-1,1868,Memorial Day
+// 256,2009,Programmer's Day
+// 01/01,0,New Year, again
+// 12/25,2000,Christmas
+//
+static const unsigned char Sample[181] = {
+    0x42, 0x43, 0x45, 0x44, 0x01, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x19, 0x00, 0x0b, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x47, 0x07, 0x00, 0x00, 0xe0, 0xff, 0xca, 0x00,
+    0x38, 0x00, 0x00, 0x00, 0x4c, 0x07, 0x00, 0x00, 0xe0, 0x3f, 0x14, 0x00,
+    0x0a, 0x00, 0x00, 0x00, 0xd9, 0x07, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00,
+    0x27, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x17, 0x00, 0x00, 0x00, 0xd0, 0x07, 0x00, 0x00, 0x19, 0x00, 0x0b, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x43, 0x68, 0x72, 0x69, 0x73, 0x74, 0x6d, 0x61,
+    0x73, 0x00, 0x4d, 0x65, 0x6d, 0x6f, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x44,
+    0x61, 0x79, 0x00, 0x4e, 0x65, 0x77, 0x20, 0x59, 0x65, 0x61, 0x72, 0x2c,
+    0x20, 0x61, 0x67, 0x61, 0x69, 0x6e, 0x00, 0x50, 0x72, 0x6f, 0x67, 0x72,
+    0x61, 0x6d, 0x6d, 0x65, 0x72, 0x27, 0x73, 0x20, 0x44, 0x61, 0x79, 0x00,
+    0x54, 0x68, 0x61, 0x6e, 0x6b, 0x73, 0x67, 0x69, 0x76, 0x69, 0x6e, 0x67,
+    0x00,
+};
+
+#define SAMPLE_EVENTS      6
+#define SAMPLE_ORDER       ( CLOCK_EVENT_DB_HEADER_SIZE + SAMPLE_EVENTS * CLOCK_EVENT_DB_EVENT_SIZE )
+#define SAMPLE_STRINGS     ( SAMPLE_ORDER + SAMPLE_EVENTS * CLOCK_EVENT_DB_ORDER_SIZE )
+#define SAMPLE_RULE(event) ( CLOCK_EVENT_DB_HEADER_SIZE + (event) * CLOCK_EVENT_DB_EVENT_SIZE + 4 )
+#define SAMPLE_NAME(event) ( CLOCK_EVENT_DB_HEADER_SIZE + (event) * CLOCK_EVENT_DB_EVENT_SIZE + 8 )
+
+#define SAMPLE_PATH "ut_clock_event_db.bced"
+
+static ClockEventDb    Db;
+static ClockEventList  List;
+static ClockEvent      Events[SAMPLE_EVENTS];
+static ClockEventIndex Order[SAMPLE_EVENTS];
+static unsigned char   Bytes[sizeof(Sample)];
+
+static int test_clock_event_db_setList_sortsEvents()
+{
+    static const char *names[SAMPLE_EVENTS] = {
+        "New Year, again", "Memorial Day", "Programmer's Day", "Thanksgiving", "Christmas", "Christmas"
+    };
+
+    Call(clock_event_db_load(&Db, Sample, sizeof(Sample)));
+    assert_int((int)Db.count, SAMPLE_EVENTS);
+
+    Call(clock_event_db_setList(&Db, &List, Events, Order));
+    assert_int((int)List.size, SAMPLE_EVENTS);
+
+    //
+    // The names are not copied and equal names are stored once
+    //
+    assert_true((Events[0].name == (const char *)Sample + SAMPLE_STRINGS));
+    assert_true((Events[0].name == Events[5].name));
+    assert_int(Events[1].yearStarted, 1863);
+
+    Call(clock_event_initList(&List, 2013));
+    for(size_t i = 0; i < SAMPLE_EVENTS; ++i) {
+        assert_str_ex(clock_event_listAt(&List, i).name, names[i], "i = %zu", i);
+    }
+
+    //
+    // The order of another year is sorted again
+    //
+    Call(clock_event_db_setList(&Db, &List, Events, Order));
+    Call(clock_event_initList(&List, 2042));
+    for(size_t i = 1; i < SAMPLE_EVENTS; ++i) {
+        ClockEventDetails a;
+        ClockEventDetails b;
+        Call(clock_event_getEventDetails(&clock_event_listAt(&List, i - 1), 2042, &a));
+        Call(clock_event_getEventDetails(&clock_event_listAt(&List, i), 2042, &b));
+        assert_int_ex((a.month < b.month || (a.month == b.month && a.dayOfMonth <= b.dayOfMonth)), TRUE, "i = %zu", i);
+    }
+
+    char str[EVENT_STRING_BUFFER_SIZE];
+    Call(clock_event_toStr(&clock_event_listAt(&List, 3), str));
+    assert_str(str, "Thanksgiving - Nov 27 2042 Thursday");
+
+    return 0;
+}
+
+static int test_clock_event_db_load_rejectsMalformed()
+{
+    memcpy(Bytes, Sample, sizeof(Sample));
+    Bytes[0] = 'X';
+    assert_function(clock_event_db_load(&Db, Bytes, sizeof(Bytes)), EINVAL);
+
+    memcpy(Bytes, Sample, sizeof(Sample));
+    Bytes[4] = CLOCK_EVENT_DB_VERSION + 1;
+    assert_function(clock_event_db_load(&Db, Bytes, sizeof(Bytes)), EINVAL);
+
+    memcpy(Bytes, Sample, sizeof(Sample));
+    assert_function(clock_event_db_load(&Db, Bytes, CLOCK_EVENT_DB_HEADER_SIZE - 1), EINVAL);
+    assert_function(clock_event_db_load(&Db, Bytes, sizeof(Bytes) - 1), EINVAL);
+
+    Bytes[11] = 0x80;
+    assert_function(clock_event_db_load(&Db, Bytes, sizeof(Bytes)), EINVAL);
+
+    memcpy(Bytes, Sample, sizeof(Sample));
+    Bytes[sizeof(Bytes) - 1] = 'g';
+    assert_function(clock_event_db_load(&Db, Bytes, sizeof(Bytes)), EINVAL);
+
+    return 0;
+}
+
+//
+// @brief sets a list from the sample with byte _offset_ changed to _value_
+//
+static int setListWith(size_t offset, unsigned char value)
+{
+    memcpy(Bytes, Sample, sizeof(Sample));
+    Bytes[offset] = value;
+    Call(clock_event_db_load(&Db, Bytes, sizeof(Bytes)));
+
+    return clock_event_db_setList(&Db, &List, Events, Order);
+}
+
+static int test_clock_event_db_setList_rejectsOutOfRange()
+{
+    //
+    // Names and indexes
+    //
+    assert_function(setListWith(SAMPLE_NAME(2), sizeof(Sample) - SAMPLE_STRINGS), ERANGE);
+    assert_function(setListWith(SAMPLE_ORDER + 3 * CLOCK_EVENT_DB_ORDER_SIZE, SAMPLE_EVENTS), ERANGE);
+
+    //
+    // The order should be a permutation: event 2 twice, event 3 never
+    //
+    assert_function(setListWith(SAMPLE_ORDER + 2 * CLOCK_EVENT_DB_ORDER_SIZE, 2), ERANGE);
+    for(size_t i = 0; i < SAMPLE_EVENTS; ++i) {
+        assert_int_ex(Events[i].yearCalculated, CLOCK_EVENT_YEAR_NOT_CALCULATED, "i = %zu", i);
+    }
+
+    //
+    // Rules. Event 0 is 12/25, 1 is 11/thu/4 and 3 is day of year 256
+    //
+    assert_function(setListWith(SAMPLE_RULE(0) + 2, 0x0c), ERANGE);     // month 13
+    assert_function(setListWith(SAMPLE_RULE(0), 0x00), ERANGE);         // day 0
+    Call(setListWith(SAMPLE_RULE(0), 0x1f));                            // day 31
+    assert_function(setListWith(SAMPLE_RULE(1) + 2, 0xfa), ERANGE);     // day of week 7
+    assert_function(setListWith(SAMPLE_RULE(3) + 1, 0x2e), ERANGE);     // day of year 368
+    Call(setListWith(SAMPLE_RULE(3) + 1, 0x2d));                        // day of year 360
+
+    return 0;
+}
+
+static int test_clock_event_db_map_mapsFile()
+{
+    FILE *file = fopen(SAMPLE_PATH, "wb");
+    assert_true((file != NULL));
+    const size_t written = fwrite(Sample, 1, sizeof(Sample), file);
+    assert_true((written == sizeof(Sample)));
+    fclose(file);
+
+    Call(clock_event_db_map(&Db, SAMPLE_PATH));
+    assert_true((Db.mapping != NULL));
+    Call(clock_event_db_setList(&Db, &List, Events, Order));
+    assert_str(Events[3].name, "Programmer's Day");
+    Call(clock_event_db_unmap(&Db));
+    assert_function(clock_event_db_unmap(&Db), EINVAL);
+
+    //
+    // A file which is not a database
+    //
+    file = fopen(SAMPLE_PATH, "wb");
+    assert_true((file != NULL));
+    fwrite(Sample, 1, CLOCK_EVENT_DB_HEADER_SIZE, file);
+    fclose(file);
+
+    assert_function(clock_event_db_map(&Db, SAMPLE_PATH), EINVAL);
+
+    remove(SAMPLE_PATH);
+    assert_function(clock_event_db_map(&Db, SAMPLE_PATH), ENOENT);
+
+    return 0;
+}
+
+static unsigned long Uptime;
+
+static int uptimeMillis(unsigned long *millis)
+{
+    Uptime += 70;
+    *millis = Uptime;
+
+    return 0;
+}
+
+static int test_clock_publishEvents_swapsBetweenTexts()
+{
+    static ClockEvent      nextEvents[SAMPLE_EVENTS];
+    static ClockEventIndex nextOrder[SAMPLE_EVENTS];
+
+    ClockState     cs;
+    ClockEventList next;
+    ClockEventList retired;
+    Bool           isRetired;
+
+    clock_extern_uptimeMillis = uptimeMillis;
+    Call(clock_init(&cs));
+    Call(clock_event_db_load(&Db, Sample, sizeof(Sample)));
+
+    //
+    // Swapped in before the first event text
+    //
+    Call(clock_event_db_setList(&Db, &List, Events, Order));
+    Call(clock_publishEvents(&cs, &List));
+    assert_function(clock_publishEvents(&cs, &List), EBUSY);
+
+    cs.state = CLOCK_STATE_SHOW_EVENTS;
+    cs.step  = 0;
+    Call(clock_update(&cs));
+    assert_true((cs.events.list.events == Events));
+    assert_str(cs.text, " Jan 01 0000 Sunday - ");
+    assert_str(cs.textStream.nextText, "New Year, again");
+
+    Call(clock_reclaimEvents(&cs, &retired, &isRetired));
+    assert_true(isRetired);
+    assert_true((retired.events != Events));
+    Call(clock_reclaimEvents(&cs, &retired, &isRetired));
+    assert_false(isRetired);
+
+    //
+    // Waits for the text to be slid
+    //
+    Call(clock_event_db_setList(&Db, &next, nextEvents, nextOrder));
+    Call(clock_publishEvents(&cs, &next));
+
+    int updates = 0;
+    while(cs.events.list.events == Events) {
+        assert_int_ex(cs.state, CLOCK_STATE_SHOW_EVENTS, "update %d", updates);
+        assert_int_ex((updates < 1000), TRUE, "update %d", updates);
+
+        Call(clock_update(&cs));
+        ++updates;
+    }
+
+    assert_true((cs.events.list.events == nextEvents));
+    assert_true((updates > 1));
+    assert_int(cs.step, 1);
+
+    //
+    // The events start over from the closest one in the new list
+    //
+    assert_int(cs.events.index, 0);
+    assert_str(cs.text, " Jan 01 0000 Sunday - ");
+    assert_str(cs.textStream.nextText, "New Year, again");
+
+    Call(clock_reclaimEvents(&cs, &retired, &isRetired));
+    assert_true(isRetired);
+    assert_true((retired.events == Events));
+
+    clock_extern_uptimeMillis = NULL;
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_event_db_setList_sortsEvents, "clock_event_db_setList() sets the events which initList() sorts", FALSE },
+    { test_clock_event_db_load_rejectsMalformed, "clock_event_db_load() rejects a malformed database", FALSE },
+    { test_clock_event_db_setList_rejectsOutOfRange, "clock_event_db_setList() rejects names, indexes and rules out of range", FALSE },
+    { test_clock_event_db_map_mapsFile, "clock_event_db_map() maps a database file", FALSE },
+    { test_clock_publishEvents_swapsBetweenTexts, "clock_publishEvents() swaps a list in between event texts", FALSE },
+};
+
+int ut_clock_event_db()
+{
+    return runTestSuite(testSuite);
+}
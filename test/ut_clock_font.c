@@ -0,0 +1,293 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_font unit tests
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include <clock_font.h>
+#include <clock_text.h>
+
+#include "test.h"
+#include "ut_clock_font.h"
+
+//
+// tools/bdf_atlas/sample.bdf compiled with 'bdf-atlas -c'. It has ' ', '?',
+// 'A', 'B', 'g', U+00B0, U+00E9 and U+20AC
+//
+static const unsigned char Sample[146] = {
+    0x42, 0x43, 0x46, 0x41, 0x01, 0x08, 0x08, 0x00, 0x07, 0x00, 0x01, 0x00,
+    0x2a, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x3f, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x41, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x02, 0x00, 0x67, 0x00, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00,
+    0xb0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x05, 0x00, 0xe9, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x06, 0x00, 0xac, 0x20, 0x00, 0x00, 0x01, 0x00, 0x07, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x06, 0x09, 0x00, 0x00, 0x06,
+    0x0f, 0x00, 0x00, 0x06, 0x15, 0x00, 0x00, 0x05, 0x1a, 0x00, 0x00, 0x04,
+    0x1e, 0x00, 0x00, 0x06, 0x24, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x40,
+    0x80, 0x8a, 0x90, 0x60, 0x00, 0x7e, 0x90, 0x90, 0x90, 0x7e, 0x00, 0xfe,
+    0x92, 0x92, 0x92, 0x6c, 0x00, 0x18, 0x25, 0x25, 0x3e, 0x00, 0x40, 0xa0,
+    0x40, 0x00, 0x1c, 0x2a, 0x6a, 0xaa, 0x18, 0x00, 0x28, 0x7c, 0xaa, 0xaa,
+    0x82, 0x00,
+};
+
+#define SAMPLE_PATH "ut_clock_font.bca"
+
+static ClockFont Font;
+static ClockText Strip;
+
+static int test_clock_font_load_findsGlyphs()
+{
+    static const uint32_t codepoints[] = { ' ', '?', 'A', 'B', 'g', 0xb0, 0xe9, 0x20ac };
+    static const unsigned char columnsA[] = { 0x7e, 0x90, 0x90, 0x90, 0x7e, 0x00 };
+
+    Call(clock_font_load(&Font, Sample, sizeof(Sample)));
+    assert_int(Font.height, 8);
+    assert_int(Font.glyphCount, 8);
+
+    unsigned int glyph;
+    for(unsigned int i = 0; i < countof(codepoints); ++i) {
+        Call(clock_font_findGlyph(&Font, codepoints[i], &glyph));
+        assert_int(glyph, i);
+    }
+
+    //
+    // Missing codepoints, including the ones between and around the ranges,
+    // are shown as '?'
+    //
+    static const uint32_t missing[] = { 0, 'C', 'f', 'h', 0xe8, 0x20ab, 0x20ad, 0x10ffff };
+    for(unsigned int i = 0; i < countof(missing); ++i) {
+        Call(clock_font_findGlyph(&Font, missing[i], &glyph));
+        assert_int(glyph, 1);
+    }
+
+    const unsigned char *columns;
+    unsigned int width;
+
+    Call(clock_font_getGlyph(&Font, 2, &columns, &width));
+    assert_int(width, (unsigned int)sizeof(columnsA));
+    assert_true((memcmp(columns, columnsA, sizeof(columnsA)) == 0));
+
+    assert_function(clock_font_getGlyph(&Font, 8, &columns, &width), ERANGE);
+    assert_function(clock_font_findGlyph(NULL, 'A', &glyph), EINVAL);
+
+    //
+    // Malformed atlases
+    //
+    unsigned char broken[sizeof(Sample)];
+
+    assert_function(clock_font_load(&Font, Sample, sizeof(Sample) - 1), EINVAL);
+    assert_function(clock_font_load(&Font, Sample, 8), EINVAL);
+
+    memcpy(broken, Sample, sizeof(Sample));
+    broken[0] = 'X';
+    assert_function(clock_font_load(&Font, broken, sizeof(broken)), EINVAL);
+
+    memcpy(broken, Sample, sizeof(Sample));
+    broken[4] = CLOCK_FONT_VERSION + 1;
+    assert_function(clock_font_load(&Font, broken, sizeof(broken)), EINVAL);
+
+    //
+    // The ranges of 'A' and 'g' swapped
+    //
+    memcpy(broken, Sample, sizeof(Sample));
+    memcpy(broken + CLOCK_FONT_HEADER_SIZE + 2 * CLOCK_FONT_RANGE_SIZE,
+           Sample + CLOCK_FONT_HEADER_SIZE + 3 * CLOCK_FONT_RANGE_SIZE, CLOCK_FONT_RANGE_SIZE);
+    memcpy(broken + CLOCK_FONT_HEADER_SIZE + 3 * CLOCK_FONT_RANGE_SIZE,
+           Sample + CLOCK_FONT_HEADER_SIZE + 2 * CLOCK_FONT_RANGE_SIZE, CLOCK_FONT_RANGE_SIZE);
+    assert_function(clock_font_load(&Font, broken, sizeof(broken)), EINVAL);
+
+    assert_function(clock_font_load(NULL, Sample, sizeof(Sample)), EINVAL);
+    assert_function(clock_font_load(&Font, NULL, sizeof(Sample)), EINVAL);
+
+    return 0;
+}
+
+static int test_clock_font_decodeUtf8_decodes()
+{
+    //
+    // 'A', U+00E9, U+20AC, U+1F600, a stray continuation byte, a truncated
+    // sequence, an overlong '/' and a surrogate
+    //
+    static const char text[] = "A\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\x80\xe2\x82" "B\xc0\xaf\xed\xa0\x80";
+    static const uint32_t expected[] = {
+        'A', 0xe9, 0x20ac, 0x1f600, CLOCK_FONT_REPLACEMENT, CLOCK_FONT_REPLACEMENT,
+        CLOCK_FONT_REPLACEMENT, 'B', CLOCK_FONT_REPLACEMENT, CLOCK_FONT_REPLACEMENT, 0
+    };
+
+    const char *p = text;
+    for(unsigned int i = 0; i < countof(expected); ++i) {
+        const uint32_t codepoint = clock_font_decodeUtf8(&p);
+        assert_number_ex((unsigned long)codepoint, (unsigned long)expected[i], "%lx", "%lx", "at codepoint %u", i);
+    }
+
+    //
+    // The end of the string is not passed
+    //
+    assert_true((p == text + sizeof(text) - 1));
+    assert_int(clock_font_decodeUtf8(&p), 0);
+
+    return 0;
+}
+
+static int test_clock_slideText_usesFont()
+{
+    static const char text[] = "A\xc3\xa9\xe2\x82\xac";
+    unsigned char pattern[CLOCK_PATTERN_SIZE];
+    Bool isLastStep;
+
+    Call(clock_font_load(&Font, Sample, sizeof(Sample)));
+    clock_setFont(&Font);
+
+    //
+    // Three codepoints take three screens
+    //
+    for(size_t step = 0; step <= 2 * CLOCK_SCREEN_WIDTH; ++step) {
+        static const unsigned int glyphs[] = { 2, 6, 7, 0 };
+        const size_t index = step / CLOCK_SCREEN_WIDTH;
+        const unsigned int shift = step % CLOCK_SCREEN_WIDTH;
+
+        const ClockFrame first  = clock_font_getGlyphFrame(&Font, glyphs[index]);
+        const ClockFrame second = index < 2 ? clock_font_getGlyphFrame(&Font, glyphs[index + 1]) : CLOCK_FRAME_BLANK;
+        const ClockFrame expected = clock_frame_shiftLeft(first, shift, 0)
+                                  | clock_frame_shiftRight(second, CLOCK_SCREEN_WIDTH - shift, 0);
+
+        Call(clock_slideText(text, step, &isLastStep, pattern));
+        const ClockFrame actual = clock_frame_fromPattern(pattern);
+
+        assert_number_ex((unsigned long long)actual, (unsigned long long)expected, "%016llx", "%016llx", "at step %zu", step);
+        const Bool isExpectedLast = step == 2 * CLOCK_SCREEN_WIDTH;
+        assert_int(isLastStep, isExpectedLast);
+    }
+
+    assert_function(clock_slideText(text, 2 * CLOCK_SCREEN_WIDTH + 1, &isLastStep, pattern), EINVAL);
+
+    //
+    // A strip takes the widths of the glyphs: 'A' 6, U+00E9 6 and U+20AC 6
+    //
+    Call(clock_text_prepareFont(&Strip, &Font, text));
+    assert_int((int)Strip.size, 18);
+    assert_true((Strip.columns[1] == 0x90));
+    assert_function(clock_text_prepareFont(&Strip, NULL, text), EINVAL);
+
+    //
+    // A stream slides the same windows without a strip
+    //
+    ClockTextStream stream;
+    Call(clock_text_openStream(&stream, text, NULL, &Font, 0));
+
+    for(size_t step = 0; step <= Strip.size - CLOCK_SCREEN_WIDTH; ++step) {
+        ClockFrame expected, actual;
+        Bool isExpectedLast;
+
+        Call(clock_text_window(&Strip, step, &isExpectedLast, &expected));
+        Call(clock_text_streamWindow(&stream, &isLastStep, &actual));
+
+        assert_number_ex((unsigned long long)actual, (unsigned long long)expected, "%016llx", "%016llx", "at step %zu", step);
+        assert_int(isLastStep, isExpectedLast);
+    }
+
+    clock_setFont(NULL);
+    assert_true((clock_getFont() == NULL));
+
+    //
+    // The built-in alphabet takes a byte per character
+    //
+    Call(clock_slideText(text, 5 * CLOCK_SCREEN_WIDTH, &isLastStep, pattern));
+    assert_true(isLastStep);
+
+    return 0;
+}
+
+static int test_clock_text_prepareFont_staysInStrip()
+{
+    static struct {
+        ClockText     strip;
+        unsigned char guard[CLOCK_SCREEN_WIDTH];
+    } guarded;
+
+    //
+    // 'A' is 6 columns wide, so that the text is longer than the strip
+    //
+    char text[CLOCK_TEXT_MAX_COLUMNS / 6 + 2];
+    memset(text, 'A', sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+
+    memset(guarded.guard, 0xa5, sizeof(guarded.guard));
+
+    Call(clock_font_load(&Font, Sample, sizeof(Sample)));
+    assert_function(clock_text_prepareFont(&guarded.strip, &Font, text), ERANGE);
+    assert_true((guarded.strip.size <= CLOCK_TEXT_MAX_COLUMNS));
+
+    for(size_t i = 0; i < sizeof(guarded.guard); ++i) {
+        assert_int_ex(guarded.guard[i], 0xa5, "guard[%zu]", i);
+    }
+
+    //
+    // The longest text which fits
+    //
+    text[CLOCK_TEXT_MAX_COLUMNS / 6] = '\0';
+    Call(clock_text_prepareFont(&guarded.strip, &Font, text));
+    assert_int((int)guarded.strip.size, CLOCK_TEXT_MAX_COLUMNS / 6 * 6);
+
+    return 0;
+}
+
+static int test_clock_font_map_mapsFile()
+{
+    FILE *file = fopen(SAMPLE_PATH, "wb");
+    assert_true((file != NULL));
+    const size_t written = fwrite(Sample, 1, sizeof(Sample), file);
+    assert_true((written == sizeof(Sample)));
+    fclose(file);
+
+    unsigned int glyph;
+
+    Call(clock_font_map(&Font, SAMPLE_PATH));
+    assert_true((Font.mapping != NULL));
+    Call(clock_font_findGlyph(&Font, 0x20ac, &glyph));
+    assert_int(glyph, 7);
+    Call(clock_font_unmap(&Font));
+    assert_function(clock_font_unmap(&Font), EINVAL);
+
+    //
+    // A file which is not an atlas
+    //
+    file = fopen(SAMPLE_PATH, "wb");
+    assert_true((file != NULL));
+    fwrite(Sample, 1, CLOCK_FONT_HEADER_SIZE, file);
+    fclose(file);
+
+    assert_function(clock_font_map(&Font, SAMPLE_PATH), EINVAL);
+
+    remove(SAMPLE_PATH);
+    assert_function(clock_font_map(&Font, SAMPLE_PATH), ENOENT);
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_font_load_findsGlyphs, "clock_font_load() loads an atlas which finds glyphs", FALSE },
+    { test_clock_font_decodeUtf8_decodes, "clock_font_decodeUtf8() decodes UTF-8", FALSE },
+    { test_clock_slideText_usesFont, "clock_slideText() slides UTF-8 text with a font", FALSE },
+    { test_clock_text_prepareFont_staysInStrip, "clock_text_prepareFont() doesn't write past the strip", FALSE },
+    { test_clock_font_map_mapsFile, "clock_font_map() maps an atlas file", FALSE },
+};
+
+int ut_clock_font()
+{
+    return runTestSuite(testSuite);
+}
@@ -0,0 +1,174 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_main unit tests
+//
+
+#include <clock_extern.h>
+#include <clock_main.h>
+
+#include "test.h"
+#include "ut_clock_main.h"
+
+static unsigned long Uptime;
+
+static int uptimeMillis(unsigned long *millis)
+{
+    Uptime += 70;
+    *millis = Uptime;
+
+    return 0;
+}
+
+static int initDateTime(DateTime *dt)
+{
+    *dt = (DateTime)date_time_initDate(2013, NOVEMBER, 20);
+    dt->hour   = 10;
+    dt->minute = 30;
+
+    return 0;
+}
+
+//
+// @brief clicks a button and runs the clock once
+//
+static int click(ClockState *cs, size_t button)
+{
+    Call(clock_button_press(&(cs->buttons), button, TRUE));
+    Call(clock_button_press(&(cs->buttons), button, FALSE));
+    Call(clock_update(cs));
+
+    return 0;
+}
+
+static int initClock(ClockState *cs, unsigned int state, int step)
+{
+    clock_extern_uptimeMillis = uptimeMillis;
+    clock_extern_initDateTime = initDateTime;
+
+    Call(clock_init(cs));
+    Call(clock_update(cs));
+
+    cs->state   = state;
+    cs->step    = step;
+    cs->changed = 0;
+
+    return 0;
+}
+
+static int test_clock_state_setDate_followsYearWithEvents()
+{
+    ClockState cs;
+    Call(initClock(&cs, CLOCK_STATE_SET_DATE, 4));
+
+    Call(click(&cs, CLOCK_BUTTON_RIGHT));
+    assert_int(cs.time.dateTime.year, 2014);
+    assert_int((cs.changed & DATE_TIME_YEAR_CHANGED), DATE_TIME_YEAR_CHANGED);
+
+    //
+    // The events are in the new year: those which have passed are in the next one
+    //
+    const ClockEventList *list = &(cs.events.list);
+    assert_int(list->year, 2014);
+    assert_true((list->cursor < list->size));
+    for(size_t i = 0; i < list->size; ++i) {
+        const int expected = i < list->cursor ? 2015 : 2014;
+        assert_int_ex(clock_event_listAt(list, i).yearCalculated, expected, "i = %zu", i);
+    }
+
+    Call(click(&cs, CLOCK_BUTTON_LEFT));
+    Call(click(&cs, CLOCK_BUTTON_LEFT));
+    assert_int(cs.time.dateTime.year, 2012);
+    assert_int(cs.events.list.year, 2012);
+
+    clock_extern_uptimeMillis = NULL;
+    clock_extern_initDateTime = NULL;
+
+    return 0;
+}
+
+static int test_clock_state_setTime_reportsChangedFields()
+{
+    ClockState cs;
+    Call(initClock(&cs, CLOCK_STATE_SET_TIME, 0));
+
+    Call(click(&cs, CLOCK_BUTTON_RIGHT));
+    assert_int(cs.time.dateTime.hour, 11);
+    assert_int((cs.changed & DATE_TIME_HOUR_CHANGED), DATE_TIME_HOUR_CHANGED);
+    assert_int((cs.changed & DATE_TIME_DATE_CHANGED), 0);
+
+    clock_extern_uptimeMillis = NULL;
+    clock_extern_initDateTime = NULL;
+
+    return 0;
+}
+
+static int test_clock_publishEvents_leavesStaleListToPublisher()
+{
+    static ClockEvent events[] = {
+        clock_event_initDayOfMonth(1, JANUARY, 2000, "New Year"),
+        clock_event_initDayOfMonth(25, DECEMBER, 2000, "Christmas"),
+    };
+    static ClockEventIndex order[countof(events)];
+
+    ClockState     cs;
+    ClockEventList list;
+    ClockEventList retired;
+    Bool           isRetired;
+
+    Call(initClock(&cs, CLOCK_STATE_SHOW_TIME, 0));
+    Call(clock_event_setList(&list, events, order, countof(events)));
+    Call(clock_publishEvents(&cs, &list));
+
+    //
+    // The clock goes to the next year before the list is swapped in
+    //
+    DateTime dt = date_time_initDate(2014, JANUARY, 2);
+    Call(date_time_clock_set(&(cs.time), &dt, NULL));
+
+    Call(clock_update(&cs));
+    assert_int(cs.events.swap, CLOCK_EVENTS_SWAP_STALE);
+    assert_int(cs.events.next.year, 2013);
+    assert_true((cs.events.list.events != events));
+    Call(clock_reclaimEvents(&cs, &retired, &isRetired));
+    assert_false(isRetired);
+
+    //
+    // Published again, it is swapped in
+    //
+    list = cs.events.next;
+    Call(clock_publishEvents(&cs, &list));
+    assert_int(cs.events.next.year, 2014);
+
+    Call(clock_update(&cs));
+    assert_int(cs.events.swap, CLOCK_EVENTS_SWAP_RETIRED);
+    assert_true((cs.events.list.events == events));
+    assert_int((int)cs.events.list.cursor, 1);
+
+    clock_extern_uptimeMillis = NULL;
+    clock_extern_initDateTime = NULL;
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_state_setDate_followsYearWithEvents, "setting the year rebuilds the events for that year", FALSE },
+    { test_clock_state_setTime_reportsChangedFields, "setting the time reports the changed fields", FALSE },
+    { test_clock_publishEvents_leavesStaleListToPublisher, "clock_publishEvents() lists of another year are published again", FALSE },
+};
+
+int ut_clock_main()
+{
+    return runTestSuite(testSuite);
+}
@@ -0,0 +1,80 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_packed unit tests
+//
+
+#include <string.h>
+
+#include <clock_packed.h>
+
+#include "test.h"
+#include "ut_clock_packed.h"
+
+static int test_clock_packed_next_readsPacked()
+{
+    const char text[] = " Pack me: 0123456789 ~\001 ";
+    unsigned char packed[clock_packed_size(sizeof(text) - 1)];
+    size_t packedSize;
+    ClockPackedReader reader;
+
+    Call(clock_packed_pack(text, packed, sizeof(packed), &packedSize));
+    assert_number(packedSize, sizeof(packed), "%zu", "%zu");
+    assert_true((packedSize < sizeof(text)));
+
+    clock_packed_begin(&reader, packed);
+    for(size_t i = 0; i < sizeof(text) - 1; ++i) {
+        const char ch = clock_packed_next(&reader);
+        assert_int_ex(ch, text[i], "at character %zu", i);
+    }
+
+    //
+    // The reader stays at the end
+    //
+    assert_int(clock_packed_next(&reader), '\0');
+    assert_int(clock_packed_next(&reader), '\0');
+
+    Call(clock_packed_pack("", packed, sizeof(packed), &packedSize));
+    assert_number(packedSize, (size_t)2, "%zu", "%zu");
+    clock_packed_begin(&reader, packed);
+    assert_int(clock_packed_next(&reader), '\0');
+
+    return 0;
+}
+
+static int test_clock_packed_pack_returnsErrors()
+{
+    unsigned char packed[8];
+    size_t packedSize;
+
+    Call(clock_packed_pack("1234567", packed, sizeof(packed), &packedSize));
+    assert_function(clock_packed_pack("12345678", packed, sizeof(packed), &packedSize), ERANGE);
+    assert_function(clock_packed_pack("\xc3\xa9", packed, sizeof(packed), &packedSize), EINVAL);
+
+    assert_function(clock_packed_pack(NULL, packed, sizeof(packed), &packedSize), EINVAL);
+    assert_function(clock_packed_pack("", NULL, sizeof(packed), &packedSize), EINVAL);
+    assert_function(clock_packed_pack("", packed, sizeof(packed), NULL), EINVAL);
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_packed_next_readsPacked, "clock_packed_next() reads clock_packed_pack()", FALSE },
+    { test_clock_packed_pack_returnsErrors, "clock_packed_pack() returns errors", FALSE },
+};
+
+int ut_clock_packed()
+{
+    return runTestSuite(testSuite);
+}
@@ -0,0 +1,248 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_panel unit tests
+//
+
+#include <string.h>
+
+#include <clock_alphabet.h>
+#include <clock_panel.h>
+
+#include "test.h"
+#include "ut_clock_panel.h"
+
+static ClockPanel Panel;
+static ClockText  Strip;
+
+//
+// @brief fills every module of the panel with a different glyph
+//
+static int fillPanel(ClockPanel *panel)
+{
+    for(unsigned int my = 0; my < panel->modulesHigh; ++my) {
+        for(unsigned int mx = 0; mx < panel->modulesWide; ++mx) {
+            int glyph = CLOCK_A + (my * panel->modulesWide + mx) % 26;
+            Call(clock_panel_putFrame(panel, clock_alphabet_getGlyph(glyph),
+                                      mx * CLOCK_SCREEN_WIDTH, my * CLOCK_SCREEN_HEIGHT));
+        }
+    }
+
+    return 0;
+}
+
+static int test_clock_panel_init_correct()
+{
+    assert_function(clock_panel_init(&Panel, 0, 1), ERANGE);
+    assert_function(clock_panel_init(&Panel, CLOCK_PANEL_MAX_MODULES_WIDE + 1, 1), ERANGE);
+    assert_function(clock_panel_init(&Panel, 1, CLOCK_PANEL_MAX_MODULES_HIGH + 1), ERANGE);
+
+    Call(clock_panel_init(&Panel, 5, 2));
+    assert_number(Panel.width, 40U, "%u", "%u");
+    assert_number(Panel.height, 16U, "%u", "%u");
+    assert_number(Panel.stride, 2U, "%u", "%u");
+
+    return 0;
+}
+
+static int test_clock_panel_putFrame_getModule_correct()
+{
+    Call(clock_panel_init(&Panel, 5, 2));
+    Call(fillPanel(&Panel));
+
+    for(unsigned int my = 0; my < Panel.modulesHigh; ++my) {
+        for(unsigned int mx = 0; mx < Panel.modulesWide; ++mx) {
+            const ClockFrame expected = clock_alphabet_getGlyph(CLOCK_A + (my * Panel.modulesWide + mx) % 26);
+            ClockFrame frame;
+
+            Call(clock_panel_getModule(&Panel, mx, my, &frame));
+            assert_true((frame == expected));
+
+            for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+                for(int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+                    int pixel = clock_panel_getPixel(&Panel, mx * CLOCK_SCREEN_WIDTH + x, my * CLOCK_SCREEN_HEIGHT + y);
+                    int expectedPixel = clock_frame_getPixel(expected, x, y);
+                    assert_int_ex(pixel, expectedPixel, "module (%u, %u), pixel (%d, %d)", mx, my, x, y);
+                }
+            }
+        }
+    }
+
+    assert_function(clock_panel_putFrame(&Panel, CLOCK_FRAME_FULL, 4, 0), ERANGE);
+    assert_function(clock_panel_putFrame(&Panel, CLOCK_FRAME_FULL, 0, 9), ERANGE);
+
+    return 0;
+}
+
+static int test_clock_panel_shifts_correct()
+{
+    static const unsigned int shifts[] = { 0, 1, 7, 8, 31, 32, 33, 39, 40 };
+    ClockPanel source;
+
+    Call(clock_panel_init(&source, 5, 1));
+    Call(fillPanel(&source));
+
+    for(size_t i = 0; i < countof(shifts); ++i) {
+        const unsigned int n = shifts[i];
+
+        memcpy(&Panel, &source, sizeof(Panel));
+        Call(clock_panel_shiftLeft(&Panel, n));
+
+        for(unsigned int y = 0; y < Panel.height; ++y) {
+            for(unsigned int x = 0; x < Panel.width; ++x) {
+                int pixel    = clock_panel_getPixel(&Panel, x, y);
+                int expected = x + n < source.width ? clock_panel_getPixel(&source, x + n, y) : 0;
+                assert_int_ex(pixel, expected, "left by %u, pixel (%u, %u)", n, x, y);
+            }
+        }
+
+        memcpy(&Panel, &source, sizeof(Panel));
+        Call(clock_panel_shiftRight(&Panel, n));
+
+        for(unsigned int y = 0; y < Panel.height; ++y) {
+            for(unsigned int x = 0; x < Panel.width; ++x) {
+                int pixel    = clock_panel_getPixel(&Panel, x, y);
+                int expected = x >= n ? clock_panel_getPixel(&source, x - n, y) : 0;
+                assert_int_ex(pixel, expected, "right by %u, pixel (%u, %u)", n, x, y);
+            }
+        }
+
+        //
+        // Nothing should be left beyond the right edge
+        //
+        const ClockPanelWord beyondEdge = Panel.rows[0][Panel.stride - 1] & 0xffffffU;
+        assert_number(beyondEdge, 0U, "%x", "%x");
+    }
+
+    return 0;
+}
+
+static int test_clock_panel_slideText_correct()
+{
+    Bool isLastStep;
+    Bool isLastWindowStep;
+    ClockFrame frame;
+    ClockFrame expected;
+
+    Call(clock_text_prepareProportional(&Strip, " Wide panel text ", CLOCK_TEXT_DEFAULT_SPACING));
+
+    //
+    // A single module shows the same as clock_text_window()
+    //
+    Call(clock_panel_init(&Panel, 1, 1));
+    for(size_t step = 0; step <= Strip.size - CLOCK_SCREEN_WIDTH; ++step) {
+        Call(clock_panel_slideText(&Panel, &Strip, step, &isLastStep));
+        Call(clock_text_window(&Strip, step, &isLastWindowStep, &expected));
+        Call(clock_panel_getModule(&Panel, 0, 0, &frame));
+
+        assert_int_ex(isLastStep, isLastWindowStep, "step = %zu", step);
+        assert_true((frame == expected));
+    }
+
+    //
+    // The text enters at the right edge and leaves at the left one
+    //
+    Call(clock_panel_init(&Panel, 4, 2));
+    const size_t offset = Panel.width - CLOCK_SCREEN_WIDTH;
+    const unsigned int top = (Panel.height - CLOCK_SCREEN_HEIGHT) / 2;
+
+    for(size_t step = 0; step <= Strip.size + offset - CLOCK_SCREEN_WIDTH; ++step) {
+        Call(clock_panel_slideText(&Panel, &Strip, step, &isLastStep));
+        const Bool expectedIsLastStep = step == Strip.size + offset - CLOCK_SCREEN_WIDTH;
+        assert_int_ex(isLastStep, expectedIsLastStep, "step = %zu", step);
+
+        for(unsigned int y = 0; y < Panel.height; ++y) {
+            for(unsigned int x = 0; x < Panel.width; ++x) {
+                const size_t c = step + x;
+                int expectedPixel = 0;
+
+                if(y >= top && y < top + CLOCK_SCREEN_HEIGHT && c >= offset && c - offset < Strip.size) {
+                    expectedPixel = (Strip.columns[c - offset] >> (CLOCK_SCREEN_HEIGHT - (y - top) - 1)) & 1;
+                }
+
+                int pixel = clock_panel_getPixel(&Panel, x, y);
+                assert_int_ex(pixel, expectedPixel, "step = %zu, pixel (%u, %u)", step, x, y);
+            }
+        }
+    }
+
+    assert_function(clock_panel_slideText(&Panel, &Strip, Strip.size + offset, &isLastStep), EINVAL);
+
+    return 0;
+}
+
+static int test_clock_panel_putTime_correct()
+{
+    DateTime dt = date_time_initDate(2014, APRIL, 13);
+    dt.hour   = 21;
+    dt.minute = 42;
+    dt.second = 59;
+
+    //
+    // A single module looks the same as clock_displayTime()
+    //
+    unsigned char expected[CLOCK_PATTERN_SIZE];
+    ClockFrame frame;
+
+    clock_clearScreen();
+    Call(clock_displayTime(&dt));
+    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        expected[y] = test_getScreenBits(y);
+    }
+
+    Call(clock_panel_init(&Panel, 1, 1));
+    Call(clock_panel_putTime(&Panel, &dt));
+    Call(clock_panel_getModule(&Panel, 0, 0, &frame));
+    assert_true((frame == clock_frame_fromPattern(expected)));
+
+    //
+    // A wide panel has wide bars: (64 - 2) / 3 = 20 columns each
+    //
+    Call(clock_panel_init(&Panel, 8, 2));
+    Call(clock_panel_putTime(&Panel, &dt));
+
+    static const struct {
+        unsigned int x;
+        int          value;
+    } bars[] = { { 0, 21 }, { 21, 42 }, { 42, 59 } };
+
+    for(size_t i = 0; i < countof(bars); ++i) {
+        for(unsigned int y = 0; y < Panel.height; ++y) {
+            const int bit = (bars[i].value >> (Panel.height - y - 1)) & 1;
+
+            const int first = clock_panel_getPixel(&Panel, bars[i].x, y);
+            const int last  = clock_panel_getPixel(&Panel, bars[i].x + 19, y);
+            const int gap   = clock_panel_getPixel(&Panel, bars[i].x + 20, y);
+
+            assert_int_ex(first, bit, "bar %zu, y = %u", i, y);
+            assert_int_ex(last, bit, "bar %zu, y = %u", i, y);
+            assert_int_ex(gap, 0, "bar %zu, y = %u", i, y);
+        }
+    }
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_panel_init_correct, "clock_panel_init() correct", FALSE },
+    { test_clock_panel_putFrame_getModule_correct, "clock_panel_putFrame() and clock_panel_getModule() correct", FALSE },
+    { test_clock_panel_shifts_correct, "clock_panel_shiftLeft() and clock_panel_shiftRight() correct", FALSE },
+    { test_clock_panel_slideText_correct, "clock_panel_slideText() correct", FALSE },
+    { test_clock_panel_putTime_correct, "clock_panel_putTime() correct", FALSE },
+};
+
+int ut_clock_panel()
+{
+    return runTestSuite(testSuite);
+}
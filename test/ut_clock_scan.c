@@ -0,0 +1,183 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_scan unit tests
+//
+
+#include <string.h>
+
+#include <clock_alphabet.h>
+#include <clock_scan_sim.h>
+
+#include "test.h"
+#include "ut_clock_scan.h"
+
+#define BASE_MICROS 25UL
+
+static int test_clock_scan_crossFade_levelsCorrect()
+{
+    const ClockFrame from = clock_alphabet_getGlyph(CLOCK_W);
+    const ClockFrame to   = clock_alphabet_getGlyph(CLOCK_SMILEY_FACE_SMILE);
+    ClockGrayFrame gray;
+
+    for(unsigned int step = 0; step <= CLOCK_SCAN_MAX_LEVEL; ++step) {
+        Call(clock_scan_crossFade(from, to, step, &gray));
+
+        for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+            for(unsigned int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+                const int inFrom = clock_frame_getPixel(from, x, y);
+                const int inTo   = clock_frame_getPixel(to, x, y);
+                const unsigned int expected = (inFrom ? CLOCK_SCAN_MAX_LEVEL - step : 0) + (inTo ? step : 0);
+                const unsigned int level = clock_scan_getLevel(&gray, x, y);
+
+                assert_number_ex(level, expected, "%u", "%u", "step %u, pixel (%u, %u)", step, x, y);
+            }
+        }
+    }
+
+    for(unsigned int level = 0; level <= CLOCK_SCAN_MAX_LEVEL; ++level) {
+        Call(clock_scan_grayFromFrame(to, level, &gray));
+
+        for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+            for(unsigned int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+                const unsigned int expected = clock_frame_getPixel(to, x, y) ? level : 0;
+                const unsigned int actual   = clock_scan_getLevel(&gray, x, y);
+
+                assert_number_ex(actual, expected, "%u", "%u", "level %u, pixel (%u, %u)", level, x, y);
+            }
+        }
+    }
+
+    assert_function(clock_scan_grayFromFrame(to, CLOCK_SCAN_LEVELS, &gray), EINVAL);
+    assert_function(clock_scan_crossFade(from, to, CLOCK_SCAN_LEVELS, &gray), EINVAL);
+
+    return 0;
+}
+
+static int test_clock_scan_next_dutyCyclesExact()
+{
+    ClockScan scan;
+    ClockScanSimulator sim;
+    ClockGrayFrame gray;
+
+    //
+    // Every level shows up in every row
+    //
+    memset(&gray, 0, sizeof(gray));
+    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        for(unsigned int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+            const unsigned int level = (x + y) & CLOCK_SCAN_MAX_LEVEL;
+
+            for(unsigned int p = 0; p < CLOCK_SCAN_PLANES; ++p) {
+                if(level & (1U << p)) {
+                    gray.planes[p] |= (ClockFrame)1 << ((y << 3) + CLOCK_SCREEN_WIDTH - x - 1);
+                }
+            }
+        }
+    }
+
+    Call(clock_scan_init(&scan, BASE_MICROS));
+    Call(clock_scan_setFrame(&scan, &gray));
+    Call(clock_scan_sim_reset(&sim));
+
+    //
+    // Plane p of every row dwells exactly BASE_MICROS << p
+    //
+    for(unsigned int i = 0; i < CLOCK_SCAN_CYCLE_SLOTS; ++i) {
+        ClockScanSlot slot;
+
+        const unsigned int row       = i / CLOCK_SCAN_PLANES;
+        const unsigned long micros   = BASE_MICROS << (i - row * CLOCK_SCAN_PLANES);
+
+        Call(clock_scan_next(&scan, &slot));
+        assert_number(slot.row, row, "%u", "%u");
+        assert_number(slot.micros, micros, "%lu", "%lu");
+        Call(clock_scan_sim_show(&sim, &slot));
+    }
+
+    const unsigned long cycleMicros = clock_scan_cycleMicros(&scan);
+    assert_number(sim.totalMicros, cycleMicros, "%lu", "%lu");
+
+    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        assert_number(sim.rowMicros[y], CLOCK_SCAN_MAX_LEVEL * BASE_MICROS, "%lu", "%lu");
+
+        for(unsigned int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+            const unsigned long expected = ((x + y) & CLOCK_SCAN_MAX_LEVEL) * BASE_MICROS;
+            assert_number_ex(sim.onMicros[y][x], expected, "%lu", "%lu", "pixel (%u, %u)", x, y);
+        }
+    }
+
+    //
+    // Many cycles keep the same ratio
+    //
+    Call(clock_scan_sim_reset(&sim));
+    Call(clock_scan_sim_run(&sim, &scan, 100 * CLOCK_SCAN_CYCLE_SLOTS));
+    assert_number(sim.totalMicros, 100 * cycleMicros, "%lu", "%lu");
+    assert_number(sim.onMicros[0][CLOCK_SCAN_MAX_LEVEL], 100 * CLOCK_SCAN_MAX_LEVEL * BASE_MICROS, "%lu", "%lu");
+
+    assert_function(clock_scan_init(&scan, 0), EINVAL);
+
+    return 0;
+}
+
+static int test_clock_scan_setFrame_latchedPerCycle()
+{
+    const ClockFrame glyph = clock_alphabet_getGlyph(CLOCK_SMILEY_FACE_SMILE);
+    ClockScan scan;
+    ClockScanSimulator sim;
+    ClockGrayFrame gray;
+
+    Call(clock_scan_init(&scan, BASE_MICROS));
+    Call(clock_scan_sim_reset(&sim));
+
+    //
+    // A frame set in the middle of a cycle is not shown until the next one
+    //
+    Call(clock_scan_sim_run(&sim, &scan, CLOCK_SCAN_CYCLE_SLOTS / 2));
+    Call(clock_scan_grayFromFrame(glyph, CLOCK_SCAN_MAX_LEVEL, &gray));
+    Call(clock_scan_setFrame(&scan, &gray));
+    Call(clock_scan_sim_run(&sim, &scan, CLOCK_SCAN_CYCLE_SLOTS / 2));
+
+    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        for(unsigned int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+            assert_number_ex(sim.onMicros[y][x], 0UL, "%lu", "%lu", "pixel (%u, %u)", x, y);
+        }
+    }
+
+    Call(clock_scan_sim_reset(&sim));
+    Call(clock_scan_sim_run(&sim, &scan, CLOCK_SCAN_CYCLE_SLOTS));
+
+    for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+        for(unsigned int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+            const unsigned long expected = clock_frame_getPixel(glyph, x, y) ? CLOCK_SCAN_MAX_LEVEL * BASE_MICROS : 0;
+            assert_number_ex(sim.onMicros[y][x], expected, "%lu", "%lu", "pixel (%u, %u)", x, y);
+        }
+    }
+
+    ClockScanSlot slot = { CLOCK_SCREEN_HEIGHT, 0, BASE_MICROS };
+    assert_function(clock_scan_sim_show(&sim, &slot), ERANGE);
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_scan_crossFade_levelsCorrect, "clock_scan_crossFade() levels correct", FALSE },
+    { test_clock_scan_next_dutyCyclesExact, "clock_scan_next() duty cycles exact", FALSE },
+    { test_clock_scan_setFrame_latchedPerCycle, "clock_scan_setFrame() latched per cycle", FALSE },
+};
+
+int ut_clock_scan()
+{
+    return runTestSuite(testSuite);
+}
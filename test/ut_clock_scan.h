@@ -0,0 +1,26 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_scan unit tests
+//
+
+#ifndef BINARY_CLOCK_TEST_UT_CLOCK_SCAN_H
+#define BINARY_CLOCK_TEST_UT_CLOCK_SCAN_H
+
+//
+// @brief runs all tests from this suite
+//
+int ut_clock_scan();
+
+#endif
@@ -0,0 +1,263 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_text unit tests
+//
+
+#include <string.h>
+
+#include <clock_alphabet.h>
+#include <clock_packed.h>
+#include <clock_text.h>
+#include "ut_clock_text.h"
+
+static ClockText Strip;
+
+static int test_clock_text_window_matchesSlideText()
+{
+    const char text[] = " Th1s TEXT:should.BE-correctly*PROCESSED!!! ~\001 ";
+    const size_t lastStep = CLOCK_SCREEN_WIDTH * (strlen(text) - 1);
+
+    Call(clock_text_prepare(&Strip, text));
+    assert_number(Strip.size, lastStep + CLOCK_SCREEN_WIDTH, "%zu", "%zu");
+
+    for(size_t step = 0; step <= lastStep; ++step) {
+        Bool isLastStep;
+        Bool isLastStripStep;
+        unsigned char expected[CLOCK_PATTERN_SIZE];
+        unsigned char actual[CLOCK_PATTERN_SIZE];
+        ClockFrame frame;
+
+        Call(clock_slideText(text, step, &isLastStep, expected));
+        Call(clock_text_window(&Strip, step, &isLastStripStep, &frame));
+        clock_frame_toPattern(frame, actual);
+
+        assert_int_ex(isLastStripStep, isLastStep, "step = %zu", step);
+
+        if(memcmp(expected, actual, CLOCK_PATTERN_SIZE) != 0) {
+            OriginateErrorEx(-1, "%d", "clock_text_window() and clock_slideText() differ at step %zu, text = '%s'",
+                                       step, text);
+        }
+    }
+
+    return 0;
+}
+
+static int test_clock_text_returnsErrors()
+{
+    char text[CLOCK_TEXT_MAX_LENGTH + 2];
+    Bool isLastStep;
+    ClockFrame frame;
+
+    assert_function(clock_text_prepare(&Strip, ""), EINVAL);
+
+    memset(text, 'A', sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    assert_function(clock_text_prepare(&Strip, text), ERANGE);
+
+    text[sizeof(text) - 2] = '\0';
+    Call(clock_text_prepare(&Strip, text));
+    assert_number(Strip.size, (size_t)CLOCK_TEXT_MAX_COLUMNS, "%zu", "%zu");
+
+    Call(clock_text_window(&Strip, Strip.size - CLOCK_SCREEN_WIDTH, &isLastStep, &frame));
+    assert_true(isLastStep);
+    assert_function(clock_text_window(&Strip, Strip.size - CLOCK_SCREEN_WIDTH + 1, &isLastStep, &frame), EINVAL);
+
+    return 0;
+}
+
+//
+// @brief counts the columns of the strip which are not blank
+//
+static size_t countUsedColumns(const ClockText *strip)
+{
+    size_t count = 0;
+
+    for(size_t i = 0; i < strip->size; ++i) {
+        if(strip->columns[i]) ++count;
+    }
+
+    return count;
+}
+
+static int test_clock_text_prepareProportional_packsGlyphs()
+{
+    const char text[] = "  Hi, WILL!  ";
+    const size_t innerLength = sizeof("Hi, WILL!") - 1;
+    size_t expectedSize = 4 * CLOCK_SCREEN_WIDTH + (innerLength - 1) * 2;
+
+    //
+    // Compute the expected width from the glyph extents
+    //
+    for(size_t i = 2; i < 2 + innerLength; ++i) {
+        int index;
+        unsigned int left, width;
+
+        Call(clock_alphabet_getIndexByCharacter(text[i], &index));
+        Call(clock_alphabet_getGlyphExtent(index, &left, &width));
+        expectedSize += width ? width : CLOCK_TEXT_SPACE_WIDTH;
+    }
+
+    ClockText monospace;
+    Call(clock_text_prepare(&monospace, text));
+    Call(clock_text_prepareProportional(&Strip, text, 2));
+
+    assert_number(Strip.size, expectedSize, "%zu", "%zu");
+    assert_true((Strip.size < monospace.size));
+    assert_number(countUsedColumns(&Strip), countUsedColumns(&monospace), "%zu", "%zu");
+
+    //
+    // The slide starts and ends on a blank screen
+    //
+    Bool isLastStep;
+    ClockFrame frame;
+
+    Call(clock_text_window(&Strip, 0, &isLastStep, &frame));
+    assert_true((frame == CLOCK_FRAME_BLANK));
+
+    Call(clock_text_window(&Strip, Strip.size - CLOCK_SCREEN_WIDTH, &isLastStep, &frame));
+    assert_true(isLastStep);
+    assert_true((frame == CLOCK_FRAME_BLANK));
+
+    //
+    // A narrow text is padded up to the screen width
+    //
+    Call(clock_text_prepareProportional(&Strip, "I", CLOCK_TEXT_DEFAULT_SPACING));
+    assert_number(Strip.size, (size_t)CLOCK_SCREEN_WIDTH, "%zu", "%zu");
+
+    return 0;
+}
+
+//
+// @brief checks that every window of _stream_ is the same as of _strip_
+//
+static int assertStreamMatches(ClockTextStream *stream, const ClockText *strip, const char *text)
+{
+    const size_t lastStep = strip->size - CLOCK_SCREEN_WIDTH;
+
+    for(size_t step = 0; step <= lastStep; ++step) {
+        Bool isExpectedLast, isActualLast;
+        ClockFrame expected, actual;
+
+        Call(clock_text_window(strip, step, &isExpectedLast, &expected));
+        Call(clock_text_streamWindow(stream, &isActualLast, &actual));
+
+        assert_number_ex((unsigned long long)actual, (unsigned long long)expected, "%016llx", "%016llx",
+                         "'%s' differs at step %zu", text, step);
+        assert_int_ex(isActualLast, isExpectedLast, "'%s' at step %zu", text, step);
+    }
+
+    Bool isLastStep;
+    ClockFrame frame;
+    assert_function(clock_text_streamWindow(stream, &isLastStep, &frame), EINVAL);
+
+    return 0;
+}
+
+static int test_clock_text_streamWindow_matchesWindow()
+{
+    const char *texts[] = {
+        "  Hi, WILL!  ",
+        " Th1s TEXT:should.BE-correctly*PROCESSED!!! ~\001 ",
+        "I",
+        "   ",
+        "a  b",
+    };
+
+    ClockTextStream stream;
+    unsigned char packed[clock_packed_size(CLOCK_TEXT_MAX_LENGTH)];
+    size_t packedSize;
+
+    for(size_t i = 0; i < countof(texts); ++i) {
+        for(unsigned int spacing = 0; spacing <= 2; ++spacing) {
+            Call(clock_text_prepareProportional(&Strip, texts[i], spacing));
+
+            Call(clock_text_openStream(&stream, texts[i], NULL, NULL, spacing));
+            Call(assertStreamMatches(&stream, &Strip, texts[i]));
+
+            Call(clock_packed_pack(texts[i], packed, sizeof(packed), &packedSize));
+            Call(clock_text_openStream(&stream, NULL, packed, NULL, spacing));
+            Call(assertStreamMatches(&stream, &Strip, texts[i]));
+        }
+    }
+
+    return 0;
+}
+
+static int test_clock_text_prepareStream_matchesPrepareProportional()
+{
+    const char text[] = " Stream me, please ";
+    ClockText expected;
+    ClockTextStream stream;
+
+    Call(clock_text_prepareProportional(&expected, text, CLOCK_TEXT_DEFAULT_SPACING));
+    Call(clock_text_openStream(&stream, text, NULL, NULL, CLOCK_TEXT_DEFAULT_SPACING));
+    Call(clock_text_prepareStream(&Strip, &stream));
+
+    assert_number(Strip.size, expected.size, "%zu", "%zu");
+    assert_true((memcmp(Strip.columns, expected.columns, Strip.size) == 0));
+
+    assert_function(clock_text_openStream(&stream, "", NULL, NULL, 0), EINVAL);
+    assert_function(clock_text_openStream(&stream, NULL, NULL, NULL, 0), EINVAL);
+    assert_function(clock_text_openStream(&stream, text, (const unsigned char *)text, NULL, 0), EINVAL);
+    assert_function(clock_text_openStream(NULL, text, NULL, NULL, 0), EINVAL);
+
+    return 0;
+}
+
+static int test_clock_text_continueStream_matchesWholeText()
+{
+    const char text[]     = " Nov 28 2013 Thursday - ";
+    const char nextText[] = "Thanksgiving";
+    const char whole[]    = " Nov 28 2013 Thursday - Thanksgiving";
+    ClockTextStream stream;
+
+    for(unsigned int spacing = 0; spacing <= 2; ++spacing) {
+        Call(clock_text_prepareProportional(&Strip, whole, spacing));
+
+        Call(clock_text_openStream(&stream, text, NULL, NULL, spacing));
+        Call(clock_text_continueStream(&stream, nextText));
+        Call(assertStreamMatches(&stream, &Strip, whole));
+    }
+
+    unsigned char packed[clock_packed_size(CLOCK_TEXT_MAX_LENGTH)];
+    size_t packedSize;
+
+    Call(clock_text_openStream(&stream, text, NULL, NULL, 0));
+    assert_function(clock_text_continueStream(&stream, ""), EINVAL);
+    assert_function(clock_text_continueStream(&stream, NULL), EINVAL);
+    assert_function(clock_text_continueStream(NULL, nextText), EINVAL);
+    Call(clock_text_continueStream(&stream, nextText));
+    assert_function(clock_text_continueStream(&stream, nextText), EINVAL);
+
+    Call(clock_packed_pack(text, packed, sizeof(packed), &packedSize));
+    Call(clock_text_openStream(&stream, NULL, packed, NULL, 0));
+    assert_function(clock_text_continueStream(&stream, nextText), EINVAL);
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_text_window_matchesSlideText, "clock_text_window() matches clock_slideText()", FALSE },
+    { test_clock_text_returnsErrors, "clock_text_prepare() and clock_text_window() return errors", FALSE },
+    { test_clock_text_prepareProportional_packsGlyphs, "clock_text_prepareProportional() packs glyphs", FALSE },
+    { test_clock_text_streamWindow_matchesWindow, "clock_text_streamWindow() matches clock_text_window()", FALSE },
+    { test_clock_text_prepareStream_matchesPrepareProportional, "clock_text_prepareStream() matches clock_text_prepareProportional()", FALSE },
+    { test_clock_text_continueStream_matchesWholeText, "clock_text_continueStream() matches the whole text", FALSE },
+};
+
+int ut_clock_text()
+{
+    return runTestSuite(testSuite);
+}
@@ -0,0 +1,178 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief BinaryClock lib/clock_transition unit tests
+//
+
+#include <clock_alphabet.h>
+#include <clock_transition.h>
+
+#include "test.h"
+#include "ut_clock_transition.h"
+
+static unsigned int countPixels(ClockFrame frame)
+{
+    unsigned int count = 0;
+
+    for(; frame; frame &= frame - 1) {
+        ++count;
+    }
+
+    return count;
+}
+
+static int test_clock_transition_blend_startsAndEndsCorrectly()
+{
+    const ClockFrame from = clock_alphabet_getGlyph(CLOCK_W);
+    const ClockFrame to   = clock_alphabet_getGlyph(CLOCK_SMILEY_FACE_SMILE);
+
+    for(unsigned int type = 0; type < CLOCK_TRANSITION_COUNT; ++type) {
+        ClockFrame result;
+
+        Call(clock_transition_blend(type, from, to, CLOCK_TRANSITION_STEPS, &result));
+        assert_true((result == to));
+
+        if(type != CLOCK_TRANSITION_NONE) {
+            Call(clock_transition_blend(type, from, to, 0, &result));
+            assert_true((result == from));
+        }
+    }
+
+    ClockFrame result;
+    assert_function(clock_transition_blend(CLOCK_TRANSITION_COUNT, from, to, 0, &result), EINVAL);
+    assert_function(clock_transition_blend(CLOCK_TRANSITION_WIPE_DOWN, from, to, CLOCK_TRANSITION_STEPS + 1, &result), EINVAL);
+
+    return 0;
+}
+
+static int test_clock_transition_blend_stepsCorrect()
+{
+    for(unsigned int step = 0; step <= CLOCK_TRANSITION_STEPS; ++step) {
+        ClockFrame result;
+
+        //
+        // Blending a blank frame into a full one shows which pixels are new
+        //
+        Call(clock_transition_blend(CLOCK_TRANSITION_DISSOLVE, CLOCK_FRAME_BLANK, CLOCK_FRAME_FULL, step, &result));
+        assert_number(countPixels(result), step * 8, "%u", "%u");
+
+        ClockFrame previous;
+        if(step > 0) {
+            Call(clock_transition_blend(CLOCK_TRANSITION_DISSOLVE, CLOCK_FRAME_BLANK, CLOCK_FRAME_FULL, step - 1, &previous));
+            assert_true(((previous & ~result) == 0));
+        }
+
+        Call(clock_transition_blend(CLOCK_TRANSITION_CHECKERBOARD, CLOCK_FRAME_BLANK, CLOCK_FRAME_FULL, step, &result));
+        assert_number(countPixels(result), step * 8, "%u", "%u");
+
+        Call(clock_transition_blend(CLOCK_TRANSITION_WIPE_RIGHT, CLOCK_FRAME_BLANK, CLOCK_FRAME_FULL, step, &result));
+        for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+            for(int x = 0; x < CLOCK_SCREEN_WIDTH; ++x) {
+                const int pixel    = clock_frame_getPixel(result, x, y);
+                const int expected = (unsigned int)x < step;
+                assert_int_ex(pixel, expected, "wipe right, step %u, pixel (%d, %d)", step, x, y);
+            }
+        }
+
+        Call(clock_transition_blend(CLOCK_TRANSITION_WIPE_DOWN, CLOCK_FRAME_BLANK, CLOCK_FRAME_FULL, step, &result));
+        for(int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+            const int pixel    = clock_frame_getPixel(result, 0, y);
+            const int expected = (unsigned int)y < step;
+            assert_int_ex(pixel, expected, "wipe down, step %u, row %d", step, y);
+        }
+    }
+
+    ClockFrame result;
+    Call(clock_transition_blend(CLOCK_TRANSITION_CHECKERBOARD, CLOCK_FRAME_BLANK, CLOCK_FRAME_FULL,
+                                CLOCK_TRANSITION_STEPS / 2, &result));
+    assert_true((result == 0x55aa55aa55aa55aaULL));
+
+    //
+    // Scrolling up: row y shows row (y + step) of the old frame or
+    // row (y + step - CLOCK_SCREEN_HEIGHT) of the new one
+    //
+    const ClockFrame from = clock_alphabet_getGlyph(CLOCK_A);
+    const ClockFrame to   = clock_alphabet_getGlyph(CLOCK_Z);
+
+    for(unsigned int step = 0; step <= CLOCK_TRANSITION_STEPS; ++step) {
+        Call(clock_transition_blend(CLOCK_TRANSITION_SCROLL_UP, from, to, step, &result));
+
+        for(unsigned int y = 0; y < CLOCK_SCREEN_HEIGHT; ++y) {
+            const unsigned int source = y + step;
+            const unsigned char expected = source < CLOCK_SCREEN_HEIGHT
+                                                ? clock_frame_getRow(from, source)
+                                                : clock_frame_getRow(to, source - CLOCK_SCREEN_HEIGHT);
+            const unsigned char row = clock_frame_getRow(result, y);
+
+            assert_int_ex(row, expected, "scroll up, step %u, row %u", step, y);
+        }
+    }
+
+    return 0;
+}
+
+static int test_clock_beginTransition_blendsScreen()
+{
+    const ClockFrame from = clock_alphabet_getGlyph(CLOCK_8);
+    const ClockFrame to   = clock_alphabet_getGlyph(CLOCK_9);
+    unsigned char expected[CLOCK_PATTERN_SIZE];
+    Bool isDone = FALSE;
+
+    Call(clock_drawFrame(from));
+    Call(clock_beginTransition(CLOCK_TRANSITION_WIPE_DOWN));
+
+    //
+    // The screen keeps the old frame until the transition steps
+    //
+    Call(clock_drawFrame(to));
+    clock_frame_toPattern(from, expected);
+    Call(test_compareScreenPattern(expected));
+
+    for(unsigned int step = 1; step <= CLOCK_TRANSITION_STEPS; ++step) {
+        ClockFrame blend;
+
+        assert_false(isDone);
+        Call(clock_stepTransition(&isDone));
+        Call(clock_transition_blend(CLOCK_TRANSITION_WIPE_DOWN, from, to, step, &blend));
+
+        clock_frame_toPattern(blend, expected);
+        int res = test_compareScreenPattern(expected);
+        if(res) {
+            test_dumpScreenBits();
+            OriginateErrorEx(res, "%d", "the screen doesn't show step %u of the transition", step);
+        }
+    }
+
+    assert_true(isDone);
+
+    //
+    // Once the transition is over, the frame is drawn as is
+    //
+    Call(clock_drawFrame(from));
+    clock_frame_toPattern(from, expected);
+    Call(test_compareScreenPattern(expected));
+
+    return 0;
+}
+
+static TestUnit testSuite[] = {
+    { test_clock_transition_blend_startsAndEndsCorrectly, "clock_transition_blend() starts and ends correctly", FALSE },
+    { test_clock_transition_blend_stepsCorrect, "clock_transition_blend() steps correct", FALSE },
+    { test_clock_beginTransition_blendsScreen, "clock_beginTransition() blends the screen", FALSE },
+};
+
+int ut_clock_transition()
+{
+    return runTestSuite(testSuite);
+}
@@ -124,6 +124,39 @@ static int test_date_time_addMillis_correct()
     return 0;
 }
 
+static int test_date_time_addMillis_fastPathSameAsNormalize()
+{
+    DateTime dt       = { 2012, DECEMBER, 31, 23, 58, 59, 990 };
+    DateTime expected = dt;
+
+    //
+    // Ticks of different lengths over a minute, an hour, a day, a month
+    // and a year rollover
+    //
+    for(unsigned long i = 0; i < 200000; ++i) {
+        const unsigned long millis = (i * 37) % 1000;
+
+        Call(date_time_addMillis(&dt, millis));
+
+        expected.millisecond += (int)millis;
+        Call(date_time_normalize(&expected));
+        Call(assert_dateTime(&dt, &expected));
+    }
+
+    assert_int(dt.year, 2013);
+
+    //
+    // Fields out of range take the full normalization
+    //
+    dt       = (DateTime){ 2013, FEBRUARY, 28, 23, 59, 75, 500 };
+    expected = (DateTime){ 2013, MARCH, 1, 0, 0, 16, 0 };
+
+    Call(date_time_addMillis(&dt, 500));
+    Call(assert_dateTime(&dt, &expected));
+
+    return 0;
+}
+
 static int test_date_time_normalize_handlesOverflows()
 {
     DateTime dt1;
@@ -275,6 +308,188 @@ static int test_date_time_normalize_handlesUnderflows()
     return 0;
 }
 
+//
+// @brief moves _dt_ to the next day
+//
+static int nextDay(DateTime *dt)
+{
+    int daysInMonth;
+
+    Call(date_time_daysInMonth(dt->year, dt->month, &daysInMonth));
+
+    if(++(dt->day) > daysInMonth) {
+        dt->day = 1;
+        if(++(dt->month) > DECEMBER) {
+            dt->month = JANUARY;
+            ++(dt->year);
+        }
+    }
+
+    return 0;
+}
+
+static int test_date_time_normalize_handlesLargeDeltas()
+{
+    const int firstYear = -8;
+    const int lastYear  = 2300;
+
+    DateTime expected = date_time_initDate(firstYear, JANUARY, 1);
+    DateTime dt;
+    int total = 0;
+
+    //
+    // Count the days to compare from the end as well
+    //
+    for(DateTime t = expected; t.year < lastYear; ++total) {
+        Call(nextDay(&t));
+    }
+
+    //
+    // Every day is reached the same from the first day forward and from
+    // the last day backward
+    //
+    for(int n = 0; n < total; ++n) {
+        dt = (DateTime)date_time_initDate(firstYear, JANUARY, 1 + n);
+        Call(date_time_normalize(&dt));
+        Call(assert_dateTime(&dt, &expected));
+
+        dt = (DateTime)date_time_initDate(lastYear, JANUARY, 1 - (total - n));
+        Call(date_time_normalize(&dt));
+        Call(assert_dateTime(&dt, &expected));
+
+        Call(nextDay(&expected));
+    }
+
+    //
+    // 100 years at once
+    //
+    dt       = (DateTime)date_time_initDate(2000, JANUARY, 1 + 36524);
+    expected = (DateTime)date_time_initDate(2099, DECEMBER, 31);
+    dt.hour  = 23;
+    Call(date_time_normalize(&dt));
+    expected.hour = 23;
+    Call(assert_dateTime(&dt, &expected));
+
+    return 0;
+}
+
+static int test_date_time_toEpoch_roundTrips()
+{
+    DateTime dt = { 1970, JANUARY, 1, 0, 0, 0, 0 };
+    DateTime back;
+    DateTimeEpoch epoch;
+
+    Call(date_time_toEpoch(&dt, &epoch));
+    assert_true((epoch == 0));
+
+    //
+    // 1385676000123 is Nov 28 2013 22:00:00.123 UTC
+    //
+    dt = (DateTime){ 2013, NOVEMBER, 28, 22, 0, 0, 123 };
+    Call(date_time_toEpoch(&dt, &epoch));
+    assert_true((epoch == 1385676000123LL));
+    Call(date_time_fromEpoch(epoch, &back));
+    Call(assert_dateTime(&back, &dt));
+
+    //
+    // Before the epoch
+    //
+    dt = (DateTime){ 1969, DECEMBER, 31, 23, 59, 59, 999 };
+    Call(date_time_toEpoch(&dt, &epoch));
+    assert_true((epoch == -1));
+    Call(date_time_fromEpoch(epoch, &back));
+    Call(assert_dateTime(&back, &dt));
+
+    //
+    // Fields out of range are the same as normalized
+    //
+    DateTimeEpoch expected;
+    dt = (DateTime){ 2013, -42, -101, -900, -141, -324, -23232 };
+    Call(date_time_toEpoch(&dt, &epoch));
+    Call(date_time_normalize(&dt));
+    Call(date_time_toEpoch(&dt, &expected));
+    assert_true((epoch == expected));
+    Call(date_time_fromEpoch(epoch, &back));
+    Call(assert_dateTime(&back, &dt));
+
+    assert_function(date_time_toEpoch(NULL, &epoch), EINVAL);
+    assert_function(date_time_fromEpoch(epoch, NULL), EINVAL);
+
+    return 0;
+}
+
+//
+// @brief gets a mask of DATE_TIME_*_CHANGED fields which differ in _a_ and _b_
+//
+static unsigned int changedFields(const DateTime *a, const DateTime *b)
+{
+    const int fieldsA[] = { a->millisecond, a->second, a->minute, a->hour, a->day, a->month, a->year };
+    const int fieldsB[] = { b->millisecond, b->second, b->minute, b->hour, b->day, b->month, b->year };
+    unsigned int changed = 0;
+
+    for(size_t i = 0; i < countof(fieldsA); ++i) {
+        if(fieldsA[i] != fieldsB[i]) changed |= 1U << i;
+    }
+
+    return changed;
+}
+
+static int test_date_time_clock_refreshSameAsAddMillis()
+{
+    DateTime expected = { 2012, DECEMBER, 31, 23, 58, 59, 990 };
+    DateTimeClock clock;
+    unsigned int changed;
+    unsigned int seen = 0;
+
+    Call(date_time_clock_set(&clock, &expected, NULL));
+    Call(assert_dateTime(&clock.dateTime, &expected));
+
+    for(unsigned long i = 0; i < 200000; ++i) {
+        const unsigned long millis = (i * 37) % 1000;
+        const DateTime old = expected;
+
+        date_time_clock_add(&clock, millis);
+        Call(date_time_clock_refresh(&clock, &changed));
+
+        Call(date_time_addMillis(&expected, millis));
+        Call(assert_dateTime(&clock.dateTime, &expected));
+        assert_number_ex(changed, changedFields(&old, &expected), "%02x", "%02x", "at tick %lu", i);
+
+        seen |= changed;
+    }
+
+    assert_number(seen, DATE_TIME_ALL_CHANGED, "%02x", "%02x");
+
+    //
+    // Big steps and steps back
+    //
+    date_time_clock_add(&clock, 40LL * MILLIS_IN_A_DAY + 1);
+    Call(date_time_clock_refresh(&clock, NULL));
+    expected.day += 40;
+    expected.millisecond += 1;
+    Call(date_time_normalize(&expected));
+    Call(assert_dateTime(&clock.dateTime, &expected));
+
+    date_time_clock_add(&clock, -2);
+    Call(date_time_clock_refresh(&clock, &changed));
+    expected.millisecond -= 2;
+    Call(date_time_normalize(&expected));
+    Call(assert_dateTime(&clock.dateTime, &expected));
+
+    //
+    // Setting a clock reports the fields which it changed
+    //
+    expected.year += 1;
+    expected.second = (expected.second + 1) % 60;
+    Call(date_time_clock_set(&clock, &expected, &changed));
+    assert_number(changed, (DATE_TIME_YEAR_CHANGED | DATE_TIME_SECOND_CHANGED), "%02x", "%02x");
+
+    assert_function(date_time_clock_set(&clock, NULL, NULL), EINVAL);
+    assert_function(date_time_clock_refresh(NULL, NULL), EINVAL);
+
+    return 0;
+}
+
 static int test_date_time_timeToStr_correct()
 {
     if(DATE_TIME_TIME_STR_SIZE != 9) {
@@ -421,6 +636,22 @@ static int test_date_time_daysInMonth_correct()
     Call(date_time_daysInMonth(2012, APRIL, &daysInMonth));
     assert_number(daysInMonth, 30, "%d", "%d");
 
+    //
+    // Century years are leap only if they are divisible by 400,
+    // both in the calendar table and out of it
+    //
+    Call(date_time_daysInMonth(1900, FEBRUARY, &daysInMonth));
+    assert_number(daysInMonth, 28, "%d", "%d");
+
+    Call(date_time_daysInMonth(2000, FEBRUARY, &daysInMonth));
+    assert_number(daysInMonth, 29, "%d", "%d");
+
+    Call(date_time_daysInMonth(2100, FEBRUARY, &daysInMonth));
+    assert_number(daysInMonth, 28, "%d", "%d");
+
+    Call(date_time_daysInMonth(2400, FEBRUARY, &daysInMonth));
+    assert_number(daysInMonth, 29, "%d", "%d");
+
     return 0;
 }
 
@@ -459,10 +690,76 @@ static int test_date_time_calculateDayOfWeek_correct()
     return 0;
 }
 
+static int test_date_time_calculateDayOfWeek_wholeCalendar()
+{
+    const int lastYear = DATE_TIME_TABLE_FIRST_YEAR + DATE_TIME_TABLE_YEARS + 1;
+
+    //
+    // Walk every day from one year before the calendar table to
+    // one year after it, counting the days of week
+    //
+    DateTime dt = date_time_initDate(DATE_TIME_TABLE_FIRST_YEAR - 1, JANUARY, 1);
+    int expected = FRIDAY;
+    int dayOfWeek;
+
+    for(; dt.year < lastYear; expected = (expected + 1) % 7) {
+        Call(date_time_calculateDayOfWeek(dt.year, dt.month, dt.day, &dayOfWeek));
+        assert_int(dayOfWeek, expected);
+
+        Call(nextDay(&dt));
+    }
+
+    return 0;
+}
+
+static int test_date_time_dayOfYear_roundTrips()
+{
+    for(int year = 1999; year <= 2401; ++year) {
+        int isLeap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        DateTime dt = date_time_initDate(year, JANUARY, 1);
+        int dayOfYear;
+        int month;
+        int day;
+
+        for(int n = 1; dt.year == year; ++n) {
+            Call(date_time_dayOfYear(year, dt.month, dt.day, &dayOfYear));
+            assert_int(dayOfYear, n);
+
+            Call(date_time_fromDayOfYear(year, n, &month, &day));
+            assert_int(month, dt.month);
+            assert_int(day, dt.day);
+
+            Call(nextDay(&dt));
+        }
+
+        Call(date_time_dayOfYear(year, DECEMBER, 31, &dayOfYear));
+        assert_int(dayOfYear, 365 + isLeap);
+    }
+
+    return 0;
+}
+
+static int test_date_time_fromDayOfYear_returnsERANGEIfDayIsOutOfRange()
+{
+    int month;
+    int day;
+
+    assert_function(date_time_fromDayOfYear(2013, 0, &month, &day), ERANGE);
+    assert_function(date_time_fromDayOfYear(2013, 366, &month, &day), ERANGE);
+    assert_function(date_time_fromDayOfYear(2100, 366, &month, &day), ERANGE);
+    assert_function(date_time_fromDayOfYear(2012, 367, &month, &day), ERANGE);
+
+    return 0;
+}
+
 static TestUnit testSuite[] = {
     { test_date_time_addMillis_correct, "date_time_addMillis() correct", FALSE },
+    { test_date_time_addMillis_fastPathSameAsNormalize, "date_time_addMillis() fast path is the same as date_time_normalize()", FALSE },
     { test_date_time_normalize_handlesOverflows, "date_time_normalize() handles overflows", FALSE },
     { test_date_time_normalize_handlesUnderflows, "date_time_normalize() handles underflows", FALSE },
+    { test_date_time_normalize_handlesLargeDeltas, "date_time_normalize() handles large deltas", FALSE },
+    { test_date_time_toEpoch_roundTrips, "date_time_toEpoch() and date_time_fromEpoch() round trip", FALSE },
+    { test_date_time_clock_refreshSameAsAddMillis, "date_time_clock_refresh() is the same as date_time_addMillis()", FALSE },
     { test_date_time_timeToStr_correct, "date_time_timeToStr() converts time correctly", FALSE },
     { test_date_time_timeToStr_returnsERANGEIfValuesAreOutOfRange, "date_time_timeToStr() returns ERANGE if _dt_ values are out of range", FALSE },
     { test_date_time_dateToStr_correct, "date_time_dateToStr() converts date correctly", FALSE },
@@ -470,6 +767,9 @@ static TestUnit testSuite[] = {
     { test_date_time_daysInMonth_correct, "date_time_daysInMonth() returns correct result", FALSE },
     { test_date_time_daysInMonth_returnsERANGEIfMonthIsOutOfRange, "date_time_daysInMonth() returns ERANGE if month is out of range", FALSE },
     { test_date_time_calculateDayOfWeek_correct, "date_time_calculateDayOfWeek() returns correct result", FALSE },
+    { test_date_time_calculateDayOfWeek_wholeCalendar, "date_time_calculateDayOfWeek() is correct for every day of the calendar table", FALSE },
+    { test_date_time_dayOfYear_roundTrips, "date_time_dayOfYear() and date_time_fromDayOfYear() round trip", FALSE },
+    { test_date_time_fromDayOfYear_returnsERANGEIfDayIsOutOfRange, "date_time_fromDayOfYear() returns ERANGE if day of year is out of range", FALSE },
 };
 
 int ut_date_time()
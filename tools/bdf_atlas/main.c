@@ -0,0 +1,381 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief Compiles a BDF bitmap font into a font atlas (see lib/clock_font.h)
+//
+//        Usage: bdf-atlas [-c name] [-d codepoint] font.bdf output
+//
+//        -c name       write the atlas as a C source with a ROM_DATA table
+//                      _name_ and its size _nameSize_ instead of a binary file
+//        -d codepoint  the glyph which is shown for a codepoint missing in the
+//                      font. It is '?' by default, if the font has it
+//
+//        The font should not be taller than the screen. Glyphs are placed
+//        against the top of the font bounding box and are as wide as their
+//        DWIDTH, but not wider than the screen.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <clock_font.h>
+
+FILE *errStream;
+FILE *outStream;
+
+#define MAX_LINE 1024
+
+typedef struct {
+    uint32_t      codepoint;
+    unsigned int  width;
+    unsigned char columns[CLOCK_SCREEN_WIDTH];
+} Glyph;
+
+typedef struct {
+    int           width;      // FONTBOUNDINGBOX
+    int           height;
+    int           x;
+    int           y;
+    Glyph        *glyphs;
+    size_t        count;
+    size_t        capacity;
+    unsigned long clipped;    // the number of pixels out of the screen
+} Font;
+
+static int fail(const char *path, unsigned long line, const char *message)
+{
+    fprintf(errStream, "%s:%lu: %s\n", path, line, message);
+    return 1;
+}
+
+static int compareGlyphs(const void *a, const void *b)
+{
+    const uint32_t ca = ((const Glyph *)a)->codepoint;
+    const uint32_t cb = ((const Glyph *)b)->codepoint;
+
+    return (ca > cb) - (ca < cb);
+}
+
+//
+// @brief puts a row of a BDF bitmap into the columns of _glyph_
+//
+static void putBitmapRow(Font *font, Glyph *glyph, const char *hex, int width, int row, int left)
+{
+    for(int i = 0; i < width && hex[i / 4] != '\0'; ++i) {
+        const char digit[2] = { hex[i / 4], '\0' };
+        const unsigned long nibble = strtoul(digit, NULL, 16);
+
+        if(!((nibble >> (3 - i % 4)) & 1)) continue;
+
+        const int x = left + i;
+        if(x < 0 || x >= CLOCK_SCREEN_WIDTH || row < 0 || row >= font->height) {
+            ++font->clipped;
+            continue;
+        }
+
+        glyph->columns[x] |= (unsigned char)(0x80 >> row);
+        if((unsigned int)x >= glyph->width) glyph->width = (unsigned int)x + 1;
+    }
+}
+
+static int parseFont(const char *path, Font *font)
+{
+    FILE *file = fopen(path, "r");
+    if(file == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    char          line[MAX_LINE];
+    unsigned long lineNumber = 0;
+    Glyph         glyph;
+    long          encoding  = -1;
+    int           dwidth    = -1;
+    int           bbx[4]    = { 0, 0, 0, 0 };
+    int           bitmapRow = -1;   // the row of BITMAP which is being read or -1
+    int           result    = 0;
+
+    memset(font, 0, sizeof(Font));
+
+    while(result == 0 && fgets(line, sizeof(line), file) != NULL) {
+        ++lineNumber;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if(bitmapRow >= 0 && strcmp(line, "ENDCHAR") != 0) {
+            //
+            // Row r of the bitmap is (bbx.y + bbx.height - r - 1) pixels above
+            // the baseline, while the baseline is (height + y) rows below the top
+            //
+            const int ascent = font->height + font->y;
+            putBitmapRow(font, &glyph, line, bbx[0],
+                         ascent - (bbx[3] + bbx[1]) + bitmapRow,
+                         bbx[2] - (font->x < 0 ? font->x : 0));
+            ++bitmapRow;
+        } else if(strncmp(line, "FONTBOUNDINGBOX ", 16) == 0) {
+            if(sscanf(line + 16, "%d %d %d %d", &font->width, &font->height, &font->x, &font->y) != 4)
+                result = fail(path, lineNumber, "bad FONTBOUNDINGBOX");
+            else if(font->height < 1 || font->height > CLOCK_SCREEN_HEIGHT)
+                result = fail(path, lineNumber, "the font should be 1 to 8 pixels high");
+        } else if(strncmp(line, "STARTCHAR", 9) == 0) {
+            if(font->height == 0) {
+                result = fail(path, lineNumber, "STARTCHAR before FONTBOUNDINGBOX");
+                break;
+            }
+
+            memset(&glyph, 0, sizeof(Glyph));
+            encoding = -1;
+            dwidth   = -1;
+            bbx[0] = font->width; bbx[1] = font->height; bbx[2] = font->x; bbx[3] = font->y;
+        } else if(strncmp(line, "ENCODING ", 9) == 0) {
+            encoding = strtol(line + 9, NULL, 10);
+        } else if(strncmp(line, "DWIDTH ", 7) == 0) {
+            dwidth = atoi(line + 7);
+        } else if(strncmp(line, "BBX ", 4) == 0) {
+            if(sscanf(line + 4, "%d %d %d %d", &bbx[0], &bbx[1], &bbx[2], &bbx[3]) != 4)
+                result = fail(path, lineNumber, "bad BBX");
+        } else if(strcmp(line, "BITMAP") == 0) {
+            bitmapRow = 0;
+        } else if(strcmp(line, "ENDCHAR") == 0) {
+            bitmapRow = -1;
+
+            //
+            // Glyphs which are not in Unicode are of no use
+            //
+            if(encoding < 0 || encoding > 0x10ffff) continue;
+
+            if(dwidth >= 0) {
+                const unsigned int width = dwidth > CLOCK_SCREEN_WIDTH ? CLOCK_SCREEN_WIDTH : (unsigned int)dwidth;
+                if(width > glyph.width) glyph.width = width;
+            }
+            glyph.codepoint = (uint32_t)encoding;
+
+            if(font->count == font->capacity) {
+                font->capacity = font->capacity ? font->capacity * 2 : 256;
+                font->glyphs   = realloc(font->glyphs, font->capacity * sizeof(Glyph));
+                if(font->glyphs == NULL) {
+                    result = fail(path, lineNumber, "out of memory");
+                    break;
+                }
+            }
+            font->glyphs[font->count++] = glyph;
+        }
+    }
+
+    fclose(file);
+
+    if(result == 0 && font->count == 0) {
+        result = fail(path, lineNumber, "the font has no Unicode glyphs");
+    }
+
+    return result;
+}
+
+//
+// @brief builds the atlas of a parsed font
+// @returns the atlas or NULL
+//
+static unsigned char *buildAtlas(const Font *font, unsigned int defaultGlyph, size_t *size)
+{
+    size_t rangeCount = 0;
+    size_t columnsSize = 0;
+
+    for(size_t i = 0; i < font->count; ++i) {
+        if(i == 0 || font->glyphs[i].codepoint != font->glyphs[i - 1].codepoint + 1) {
+            ++rangeCount;
+        }
+        columnsSize += font->glyphs[i].width;
+    }
+
+    *size = CLOCK_FONT_HEADER_SIZE + rangeCount * CLOCK_FONT_RANGE_SIZE
+          + font->count * CLOCK_FONT_GLYPH_SIZE + columnsSize;
+
+    unsigned char *atlas = calloc(1, *size);
+    if(atlas == NULL) return NULL;
+
+    memcpy(atlas, CLOCK_FONT_MAGIC, 4);
+    atlas[4]  = CLOCK_FONT_VERSION;
+    atlas[5]  = (unsigned char)font->height;
+    atlas[6]  = (unsigned char)font->count;
+    atlas[7]  = (unsigned char)(font->count >> 8);
+    atlas[8]  = (unsigned char)rangeCount;
+    atlas[9]  = (unsigned char)(rangeCount >> 8);
+    atlas[10] = (unsigned char)defaultGlyph;
+    atlas[11] = (unsigned char)(defaultGlyph >> 8);
+    for(unsigned int b = 0; b < 4; ++b) {
+        atlas[12 + b] = (unsigned char)(columnsSize >> (8 * b));
+    }
+
+    unsigned char *range   = atlas + CLOCK_FONT_HEADER_SIZE - CLOCK_FONT_RANGE_SIZE;
+    unsigned char *glyphs  = atlas + CLOCK_FONT_HEADER_SIZE + rangeCount * CLOCK_FONT_RANGE_SIZE;
+    unsigned char *columns = glyphs + font->count * CLOCK_FONT_GLYPH_SIZE;
+    size_t         offset  = 0;
+    size_t         first   = 0;
+
+    for(size_t i = 0; i < font->count; ++i) {
+        const Glyph *glyph = &font->glyphs[i];
+
+        if(i == 0 || glyph->codepoint != font->glyphs[i - 1].codepoint + 1) {
+            range += CLOCK_FONT_RANGE_SIZE;
+            first  = i;
+            for(unsigned int b = 0; b < 4; ++b) {
+                range[b] = (unsigned char)(glyph->codepoint >> (8 * b));
+            }
+            range[6] = (unsigned char)i;
+            range[7] = (unsigned char)(i >> 8);
+        }
+
+        const size_t count = i - first + 1;
+        range[4] = (unsigned char)count;
+        range[5] = (unsigned char)(count >> 8);
+
+        unsigned char *entry = glyphs + i * CLOCK_FONT_GLYPH_SIZE;
+        entry[0] = (unsigned char)offset;
+        entry[1] = (unsigned char)(offset >> 8);
+        entry[2] = (unsigned char)(offset >> 16);
+        entry[3] = (unsigned char)glyph->width;
+
+        memcpy(columns + offset, glyph->columns, glyph->width);
+        offset += glyph->width;
+    }
+
+    return atlas;
+}
+
+static int writeAtlas(const char *path, const char *name, const unsigned char *atlas, size_t size)
+{
+    FILE *file = fopen(path, name ? "w" : "wb");
+    if(file == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    if(name == NULL) {
+        fwrite(atlas, 1, size, file);
+    } else {
+        fprintf(file,
+            "// @brief a BinaryClock font atlas\n"
+            "//\n"
+            "// @warning generated by tools/bdf_atlas, do not edit\n"
+            "//\n\n"
+            "const unsigned char %s[%zu] ROM_DATA = {\n", name, size);
+
+        for(size_t i = 0; i < size; ++i) {
+            fprintf(file, "%s0x%02x,%s",
+                    (i % 12) ? " " : "    ",
+                    atlas[i],
+                    (i % 12 == 11 || i + 1 == size) ? "\n" : "");
+        }
+
+        fprintf(file, "};\n\nconst size_t %sSize = sizeof(%s);\n", name, name);
+    }
+
+    if(fclose(file) != 0) {
+        perror(path);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int usage(void)
+{
+    fprintf(errStream, "usage: bdf-atlas [-c name] [-d codepoint] font.bdf output\n");
+    return 2;
+}
+
+int main(int argc, char *argv[])
+{
+    errStream = stderr;
+    outStream = stdout;
+
+    const char *name             = NULL;
+    long        defaultCodepoint = '?';
+    Bool        isDefaultGiven   = FALSE;
+    int         i;
+
+    for(i = 1; i < argc && argv[i][0] == '-'; i += 2) {
+        if(i + 1 == argc) return usage();
+
+        if(strcmp(argv[i], "-c") == 0) {
+            name = argv[i + 1];
+        } else if(strcmp(argv[i], "-d") == 0) {
+            defaultCodepoint = strtol(argv[i + 1], NULL, 0);
+            isDefaultGiven   = TRUE;
+        } else {
+            return usage();
+        }
+    }
+
+    if(argc - i != 2) return usage();
+
+    const char *input  = argv[i];
+    const char *output = argv[i + 1];
+
+    Font font;
+    if(parseFont(input, &font)) return 1;
+
+    qsort(font.glyphs, font.count, sizeof(Glyph), compareGlyphs);
+
+    unsigned int defaultGlyph = 0;
+    Bool isDefaultFound = FALSE;
+
+    for(size_t g = 0; g < font.count; ++g) {
+        if(g > 0 && font.glyphs[g].codepoint == font.glyphs[g - 1].codepoint) {
+            fprintf(errStream, "%s: codepoint U+%04lX is encoded twice\n", input, (unsigned long)font.glyphs[g].codepoint);
+            return 1;
+        }
+        if(font.glyphs[g].codepoint == (uint32_t)defaultCodepoint) {
+            defaultGlyph   = (unsigned int)g;
+            isDefaultFound = TRUE;
+        }
+    }
+
+    if(font.count > 0xffff) {
+        fprintf(errStream, "%s: %zu glyphs is more than an atlas holds\n", input, font.count);
+        return 1;
+    }
+
+    if(isDefaultGiven && !isDefaultFound) {
+        fprintf(errStream, "%s: the font has no codepoint U+%04lX\n", input, (unsigned long)defaultCodepoint);
+        return 1;
+    }
+
+    if(font.clipped) {
+        fprintf(errStream, "%s: warning: %lu pixels are out of the screen and are dropped\n", input, font.clipped);
+    }
+
+    size_t size;
+    unsigned char *atlas = buildAtlas(&font, defaultGlyph, &size);
+    if(atlas == NULL) {
+        fprintf(errStream, "out of memory\n");
+        return 1;
+    }
+
+    //
+    // The library should accept what it is given
+    //
+    ClockFont loaded;
+    if(clock_font_load(&loaded, atlas, size) != 0) {
+        fprintf(errStream, "%s: the atlas is invalid\n", input);
+        return 1;
+    }
+
+    int result = writeAtlas(output, name, atlas, size);
+
+    free(atlas);
+    free(font.glyphs);
+
+    return result;
+}
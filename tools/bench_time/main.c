@@ -0,0 +1,130 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief Measures the cost of advancing the clock time on the host. It
+//        prints the CPU cycles (or nanoseconds of CPU time where there is
+//        no cycle counter) per call of every variant.
+//
+//        Usage: bench-time [iterations]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <date_time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+
+#define COUNTER_UNIT "cycles"
+#define readCounter() ( (unsigned long long)__rdtsc() )
+#else
+#define COUNTER_UNIT "ns"
+#define readCounter() ( (unsigned long long)clock() * (1000000000ULL / CLOCKS_PER_SEC) )
+#endif
+
+FILE *errStream;
+FILE *outStream;
+
+#define DEFAULT_ITERATIONS 10000000UL
+
+//
+// A main loop tick is a few dozen milliseconds. The deltas vary, so that
+// a branch predictor doesn't learn a single path
+//
+#define tickMillis(i) ( 20UL + (i) % 31UL )
+
+//
+// The result of every variant is kept here, so that it is not optimized out
+//
+static volatile int Sink;
+
+typedef int (* Variant)(DateTime *dt, unsigned long millis);
+
+//
+// @brief advances the time the way date_time_addMillis() did before it had
+//        the fast path: a division by MILLIS_IN_A_DAY and a full normalization
+//
+static int addMillisNormalize(DateTime *dt, unsigned long millis)
+{
+    dt->day += millis / MILLIS_IN_A_DAY;
+    dt->millisecond += (int)(millis % MILLIS_IN_A_DAY);
+
+    return date_time_normalize(dt);
+}
+
+static DateTimeClock Clock;
+
+//
+// @brief advances the canonical epoch time and refreshes its broken-down view,
+//        the way clock_update() does. _dt_ is not used
+//
+static int addMillisClock(DateTime *dt, unsigned long millis)
+{
+    (void)dt;
+
+    date_time_clock_add(&Clock, millis);
+
+    unsigned int changed;
+
+    return date_time_clock_refresh(&Clock, &changed);
+}
+
+static int run(const char *name, Variant variant, unsigned long iterations, double *perCall)
+{
+    DateTime dt = { 2013, DECEMBER, 31, 23, 0, 0, 0 };
+
+    Call(date_time_clock_set(&Clock, &dt, NULL));
+
+    const unsigned long long start = readCounter();
+
+    for(unsigned long i = 0; i < iterations; ++i) {
+        Call(variant(&dt, tickMillis(i)));
+    }
+
+    const unsigned long long end = readCounter();
+
+    Sink = dt.year + dt.month + dt.day + dt.hour + dt.minute + dt.second + dt.millisecond
+         + Clock.dateTime.second;
+    *perCall = (double)(end - start) / (double)iterations;
+
+    fprintf(outStream, "%-26s %10.1f %s/call\n", name, *perCall, COUNTER_UNIT);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    errStream = stderr;
+    outStream = stdout;
+
+    const unsigned long iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_ITERATIONS;
+    double normalize, fast, clock;
+
+    if(iterations == 0) {
+        fprintf(errStream, "Usage: %s [iterations]\n", argv[0]);
+        return EINVAL;
+    }
+
+    fprintf(outStream, "%lu ticks of 20..50 ms\n", iterations);
+
+    Call(run("date_time_normalize()", addMillisNormalize, iterations, &normalize));
+    Call(run("date_time_addMillis()", date_time_addMillis, iterations, &fast));
+    Call(run("date_time_clock_refresh()", addMillisClock, iterations, &clock));
+
+    fprintf(outStream, "speedup %.1fx, %.1fx\n", normalize / fast, normalize / clock);
+
+    return 0;
+}
@@ -0,0 +1,392 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief Compiles a text source of events into an event database
+//        (see lib/clock_event_db.h)
+//
+//        Usage: event-db [-y year] events.txt output
+//
+//        -y year  the year which the order of the events is sorted for.
+//                 It is 2000 by default
+//
+//        The output is replaced with rename(), so that a clock which has it
+//        mapped may swap the new one in (see emulator/emulator_events.h)
+//
+//        Every line of the source is an event, empty lines and lines which
+//        start with '#' are skipped. An event is three comma separated
+//        fields, the name being the rest of the line, so it may have commas:
+//
+//        date,year,name
+//
+//        date  MM/DD       day DD of month MM, i.e. 12/25
+//              MM/ddd/N    the N-th day of week ddd of month MM, i.e.
+//                          11/thu/4 for the fourth Thursday of November.
+//                          A negative N counts from the end of the month,
+//                          i.e. 07/fri/-1 for the last Friday of July.
+//                          [ 1 <= |N| <= 4 ]
+//              DDD         day of year DDD, i.e. 256
+//        year  the year the event started in
+//        name  the name of the event
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <clock_event_db.h>
+
+FILE *errStream;
+FILE *outStream;
+
+#define MAX_LINE 1024
+
+typedef struct {
+    int      yearStarted;
+    uint16_t blob_1;
+    uint8_t  blob_2;
+    char    *name;
+    uint32_t nameOffset;
+    unsigned int dateKey;   // month and day in the year of the order
+} Event;
+
+typedef struct {
+    Event  *events;
+    size_t  count;
+    size_t  capacity;
+} Events;
+
+static int fail(const char *path, unsigned long line, const char *message)
+{
+    fprintf(errStream, "%s:%lu: %s\n", path, line, message);
+    return 1;
+}
+
+//
+// @brief sorts pointers to events by name or by date
+//
+static int compareNames(const void *a, const void *b)
+{
+    return strcmp((*(const Event * const *)a)->name, (*(const Event * const *)b)->name);
+}
+
+static const Event *SortedEvents;
+
+static int compareDates(const void *a, const void *b)
+{
+    const uint32_t ia = *(const uint32_t *)a;
+    const uint32_t ib = *(const uint32_t *)b;
+    const unsigned int ka = SortedEvents[ia].dateKey;
+    const unsigned int kb = SortedEvents[ib].dateKey;
+
+    if(ka != kb) return (ka > kb) - (ka < kb);
+    return (ia > ib) - (ia < ib);
+}
+
+//
+// @brief parses the date rule of an event
+// @returns 0 on success or a message of what is wrong
+//
+static const char *parseDate(const char *date, int year, ClockEvent *event)
+{
+    int  month;
+    int  day;
+    int  week;
+    char dayOfWeek[4];
+    char tail;
+
+    if(sscanf(date, "%d/%3[a-zA-Z]/%d%c", &month, dayOfWeek, &week, &tail) == 3) {
+        if(month < 1 || month > 12) return "the month should be 1 to 12";
+        if(week == 0 || week < -4 || week > 4) return "the week should be 1 to 4 or -1 to -4";
+
+        int d = SUNDAY;
+        while(d <= SATURDAY && strncasecmp(dayOfWeek, DateTimeDayOfWeekStr[d], 3) != 0) ++d;
+        if(d > SATURDAY) return "the day of week should be sun, mon, tue, wed, thu, fri or sat";
+
+        const int m = month - 1;
+        const int w = (week > 0 ? week : -week) - 1;
+        const ClockEvent e = clock_event_initDayOfWeek(d, w, week > 0, m, year, NULL);
+        memcpy(event, &e, sizeof(ClockEvent));
+    } else if(sscanf(date, "%d/%d%c", &month, &day, &tail) == 2) {
+        if(month < 1 || month > 12) return "the month should be 1 to 12";
+
+        int daysInMonth;
+        date_time_daysInMonth(0, month - 1, &daysInMonth); // leap year to account for February 29
+        if(day < 1 || day > daysInMonth) return "the day is out of the month";
+
+        const int m = month - 1;
+        const ClockEvent e = clock_event_initDayOfMonth(day, m, year, NULL);
+        memcpy(event, &e, sizeof(ClockEvent));
+    } else if(sscanf(date, "%d%c", &day, &tail) == 1) {
+        if(day < 1 || day > 366) return "the day of year should be 1 to 366";
+
+        const ClockEvent e = clock_event_initDayOfYear(day, year, NULL);
+        memcpy(event, &e, sizeof(ClockEvent));
+    } else {
+        return "the date should be MM/DD, MM/ddd/N or DDD";
+    }
+
+    return NULL;
+}
+
+static int parseEvents(const char *path, int orderYear, Events *events)
+{
+    FILE *file = fopen(path, "r");
+    if(file == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    char          line[MAX_LINE];
+    unsigned long lineNumber = 0;
+    int           result     = 0;
+
+    memset(events, 0, sizeof(Events));
+
+    while(result == 0 && fgets(line, sizeof(line), file) != NULL) {
+        ++lineNumber;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if(line[0] == '\0' || line[0] == '#') continue;
+
+        char *year = strchr(line, ',');
+        char *name = year ? strchr(year + 1, ',') : NULL;
+        if(name == NULL) {
+            result = fail(path, lineNumber, "an event should be date,year,name");
+            break;
+        }
+        *year++ = '\0';
+        *name++ = '\0';
+
+        char *end;
+        const long yearStarted = strtol(year, &end, 10);
+        if(end == year || *end != '\0') {
+            result = fail(path, lineNumber, "bad year");
+            break;
+        }
+
+        const size_t nameLength = strlen(name);
+        if(nameLength == 0 || nameLength > CLOCK_EVENT_DB_MAX_NAME) {
+            char message[64];
+            snprintf(message, sizeof(message), "the name should be 1 to %u characters", (unsigned int)CLOCK_EVENT_DB_MAX_NAME);
+            result = fail(path, lineNumber, message);
+            break;
+        }
+
+        ClockEvent event;
+        const char *error = parseDate(line, (int)yearStarted, &event);
+        if(error != NULL) {
+            result = fail(path, lineNumber, error);
+            break;
+        }
+
+        ClockEventDetails details;
+        if(clock_event_getEventDetails(&event, orderYear, &details) != 0) {
+            result = fail(path, lineNumber, "the date doesn't exist");
+            break;
+        }
+
+        if(events->count == events->capacity) {
+            events->capacity = events->capacity ? events->capacity * 2 : 256;
+            events->events   = realloc(events->events, events->capacity * sizeof(Event));
+            if(events->events == NULL) {
+                result = fail(path, lineNumber, "out of memory");
+                break;
+            }
+        }
+
+        Event *e = &events->events[events->count++];
+        e->yearStarted = event.yearStarted;
+        e->blob_1      = event.blob_1;
+        e->blob_2      = event.blob_2;
+        e->name        = malloc(nameLength + 1);
+        e->dateKey     = (unsigned int)details.month << 5 | (unsigned int)details.dayOfMonth;
+
+        if(e->name == NULL) {
+            result = fail(path, lineNumber, "out of memory");
+        } else {
+            memcpy(e->name, name, nameLength + 1);
+        }
+    }
+
+    fclose(file);
+
+    return result;
+}
+
+static void write32(unsigned char *p, uint32_t n)
+{
+    for(unsigned int b = 0; b < 4; ++b) {
+        p[b] = (unsigned char)(n >> (8 * b));
+    }
+}
+
+static unsigned char *buildDb(Events *events, size_t *size)
+{
+    //
+    // Equal names are stored once
+    //
+    Event **byName = malloc((events->count ? events->count : 1) * sizeof(Event *));
+    if(byName == NULL) return NULL;
+
+    for(size_t i = 0; i < events->count; ++i) {
+        byName[i] = &events->events[i];
+    }
+    qsort(byName, events->count, sizeof(Event *), compareNames);
+
+    size_t stringsSize = 0;
+    for(size_t i = 0; i < events->count; ++i) {
+        if(i > 0 && strcmp(byName[i]->name, byName[i - 1]->name) == 0) {
+            byName[i]->nameOffset = byName[i - 1]->nameOffset;
+        } else {
+            byName[i]->nameOffset = (uint32_t)stringsSize;
+            stringsSize += strlen(byName[i]->name) + 1;
+        }
+    }
+
+    *size = CLOCK_EVENT_DB_HEADER_SIZE
+          + events->count * (CLOCK_EVENT_DB_EVENT_SIZE + CLOCK_EVENT_DB_ORDER_SIZE)
+          + stringsSize;
+
+    unsigned char *db = calloc(1, *size);
+    uint32_t *order = malloc((events->count ? events->count : 1) * sizeof(uint32_t));
+    if(db == NULL || order == NULL) {
+        free(byName);
+        free(order);
+        free(db);
+        return NULL;
+    }
+
+    memcpy(db, CLOCK_EVENT_DB_MAGIC, 4);
+    db[4] = CLOCK_EVENT_DB_VERSION;
+    write32(db + 8, (uint32_t)events->count);
+    write32(db + 12, (uint32_t)stringsSize);
+
+    unsigned char *record  = db + CLOCK_EVENT_DB_HEADER_SIZE;
+    unsigned char *index   = record + events->count * CLOCK_EVENT_DB_EVENT_SIZE;
+    char          *strings = (char *)(index + events->count * CLOCK_EVENT_DB_ORDER_SIZE);
+
+    for(size_t i = 0; i < events->count; ++i, record += CLOCK_EVENT_DB_EVENT_SIZE) {
+        const Event *e = &events->events[i];
+
+        write32(record, (uint32_t)e->yearStarted);
+        record[4] = (unsigned char)e->blob_1;
+        record[5] = (unsigned char)(e->blob_1 >> 8);
+        record[6] = e->blob_2;
+        write32(record + 8, e->nameOffset);
+
+        strcpy(strings + e->nameOffset, e->name);
+        order[i] = (uint32_t)i;
+    }
+
+    SortedEvents = events->events;
+    qsort(order, events->count, sizeof(uint32_t), compareDates);
+
+    for(size_t i = 0; i < events->count; ++i, index += CLOCK_EVENT_DB_ORDER_SIZE) {
+        write32(index, order[i]);
+    }
+
+    free(byName);
+    free(order);
+
+    return db;
+}
+
+static int usage(void)
+{
+    fprintf(errStream, "usage: event-db [-y year] events.txt output\n");
+    return 2;
+}
+
+int main(int argc, char *argv[])
+{
+    errStream = stderr;
+    outStream = stdout;
+
+    long orderYear = 2000;
+    int  i;
+
+    for(i = 1; i < argc && argv[i][0] == '-'; i += 2) {
+        if(i + 1 == argc) return usage();
+
+        if(strcmp(argv[i], "-y") == 0) {
+            orderYear = strtol(argv[i + 1], NULL, 10);
+        } else {
+            return usage();
+        }
+    }
+
+    if(argc - i != 2) return usage();
+
+    const char *input  = argv[i];
+    const char *output = argv[i + 1];
+
+    Events events;
+    if(parseEvents(input, (int)orderYear, &events)) return 1;
+
+    if(events.count > 0xffffffffUL) {
+        fprintf(errStream, "%s: %zu events is more than a database holds\n", input, events.count);
+        return 1;
+    }
+
+    size_t size;
+    unsigned char *db = buildDb(&events, &size);
+    if(db == NULL) {
+        fprintf(errStream, "out of memory\n");
+        return 1;
+    }
+
+    //
+    // The database replaces the output with rename(), so that a clock which
+    // has the old one mapped keeps reading it until it swaps the new one in
+    //
+    char temporary[FILENAME_MAX];
+    if(snprintf(temporary, sizeof(temporary), "%s.tmp", output) >= (int)sizeof(temporary)) {
+        fprintf(errStream, "%s: the path is too long\n", output);
+        return 1;
+    }
+
+    FILE *file = fopen(temporary, "wb");
+    if(file == NULL) {
+        perror(temporary);
+        return 1;
+    }
+
+    //
+    // A short write, i.e. on a full disk, leaves the output as it was
+    //
+    const Bool isWritten = fwrite(db, 1, size, file) == size && fflush(file) == 0;
+
+    if(fclose(file) != 0 || ! isWritten) {
+        perror(temporary);
+        remove(temporary);
+        return 1;
+    }
+
+    if(rename(temporary, output) != 0) {
+        perror(output);
+        remove(temporary);
+        return 1;
+    }
+
+    fprintf(outStream, "%s: %zu events, %zu bytes\n", output, events.count, size);
+
+    free(db);
+    for(size_t e = 0; e < events.count; ++e) {
+        free(events.events[e].name);
+    }
+    free(events.events);
+
+    return 0;
+}
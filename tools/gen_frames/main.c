@@ -0,0 +1,233 @@
+// Copyright [2013] [Sergey Markelov]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// @brief Renders the sliding frames of the constant messages of
+//        lib/clock_messages.h and prints them with the packed messages as
+//        lib/clock_messages.c. With 'alphabet' packs ClockAlphabet instead
+//        and prints it as lib/clock_alphabet_packed.c
+//
+//        Usage: gen-frames > lib/clock_messages.c
+//               gen-frames alphabet > lib/clock_alphabet_packed.c
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include <clock_batch.h>
+#include <clock_messages.h>
+#include <clock_packed.h>
+#include <clock_text.h>
+#include <date_time.h>
+
+FILE *errStream;
+FILE *outStream;
+
+typedef struct {
+    const char *name;    // the name of the text array
+    const char *macro;   // the macro which holds the text
+    const char *text;
+} Message;
+
+static const Message Messages[] = {
+    { "ClockMessageHello",    "CLOCK_MESSAGE_HELLO",     CLOCK_MESSAGE_HELLO },
+    { "ClockMessageNoEvents", "CLOCK_MESSAGE_NO_EVENTS", CLOCK_MESSAGE_NO_EVENTS },
+};
+
+static ClockText  Strip;
+static ClockFrame Frames[CLOCK_TEXT_MAX_COLUMNS];
+static size_t     Counts[countof(Messages)];
+
+static int printBytes(const unsigned char *bytes, size_t size)
+{
+    for(size_t i = 0; i < size; ++i) {
+        fprintf(outStream, "%s0x%02x,%s",
+                (i % 12) ? " " : "    ",
+                bytes[i],
+                (i % 12 == 11 || i + 1 == size) ? "\n" : "");
+    }
+
+    return 0;
+}
+
+static int printHeader(const char *brief, const char *include)
+{
+    fprintf(outStream,
+        "// Copyright [2013] [Sergey Markelov]\n"
+        "//\n"
+        "// Licensed under the Apache License, Version 2.0 (the \"License\");\n"
+        "// you may not use this file except in compliance with the License.\n"
+        "// You may obtain a copy of the License at\n"
+        "//\n"
+        "//     http://www.apache.org/licenses/LICENSE-2.0\n"
+        "//\n"
+        "// Unless required by applicable law or agreed to in writing, software\n"
+        "// distributed under the License is distributed on an \"AS IS\" BASIS,\n"
+        "// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n"
+        "// See the License for the specific language governing permissions and\n"
+        "// limitations under the License.\n"
+        "//\n"
+        "// @brief %s\n"
+        "//\n"
+        "// @warning generated by tools/gen_frames, do not edit. Run 'make frames'\n"
+        "//          from the top directory instead\n"
+        "//\n\n"
+        "#include \"%s\"\n\n", brief, include);
+
+    return 0;
+}
+
+//
+// @brief prints ClockAlphabet packed column by column, see clock_alphabet.h
+//
+static int printAlphabet()
+{
+    static unsigned char columns[CLOCK_ALPHABET_SIZE * CLOCK_SCREEN_WIDTH];
+    static unsigned char extents[CLOCK_ALPHABET_SIZE];
+    static unsigned int  offsets[CLOCK_ALPHABET_BLOCKS];
+    size_t size = 0;
+
+    for(int i = 0; i < CLOCK_ALPHABET_SIZE; ++i) {
+        unsigned char glyph[CLOCK_PATTERN_SIZE];
+
+        if(i % CLOCK_ALPHABET_BLOCK == 0) {
+            offsets[i / CLOCK_ALPHABET_BLOCK] = (unsigned int)size;
+        }
+
+        //
+        // The rows of the transposed glyph are its columns
+        //
+        clock_frame_toPattern(clock_frame_transpose(clock_frame_fromPattern(ClockAlphabet[i])), glyph);
+
+        unsigned int left  = 0;
+        unsigned int right = CLOCK_SCREEN_WIDTH;
+
+        while(left < right && glyph[left] == 0)      ++left;
+        while(right > left && glyph[right - 1] == 0) --right;
+
+        extents[i] = (unsigned char)(right > left ? (left << 4 | (right - left)) : 0);
+
+        memcpy(columns + size, glyph + left, right - left);
+        size += right - left;
+    }
+
+    Call(printHeader("BinaryClock packed alphabet", "clock_alphabet.h"));
+
+    fprintf(outStream, "const unsigned char ClockAlphabetColumns[%zu] ROM_DATA = {\n", size);
+    Call(printBytes(columns, size));
+    fprintf(outStream, "};\n\n");
+
+    fprintf(outStream, "const unsigned char ClockAlphabetExtents[CLOCK_ALPHABET_SIZE] ROM_DATA = {\n");
+    Call(printBytes(extents, CLOCK_ALPHABET_SIZE));
+    fprintf(outStream, "};\n\n");
+
+    fprintf(outStream, "const uint16_t ClockAlphabetOffsets[CLOCK_ALPHABET_BLOCKS] ROM_DATA = {\n   ");
+    for(size_t i = 0; i < CLOCK_ALPHABET_BLOCKS; ++i) {
+        fprintf(outStream, " %u,", offsets[i]);
+    }
+    fprintf(outStream, "\n};\n");
+
+    return 0;
+}
+
+static int printFrames(const Message *message, size_t *count)
+{
+    Call(clock_text_prepareProportional(&Strip, message->text, CLOCK_TEXT_DEFAULT_SPACING));
+
+    *count = Strip.size - CLOCK_SCREEN_WIDTH + 1;
+    Call(clock_batch_slideText(&Strip, 0, *count, Frames));
+
+    unsigned char packed[clock_packed_size(CLOCK_TEXT_MAX_LENGTH)];
+    size_t        packedSize;
+
+    Call(clock_packed_pack(message->text, packed, sizeof(packed), &packedSize));
+
+    fprintf(outStream, "//\n// %s\n//\n", message->macro);
+    fprintf(outStream, "const unsigned char %s[%zu] ROM_DATA = {\n", message->name, packedSize);
+    Call(printBytes(packed, packedSize));
+    fprintf(outStream, "};\n\n");
+    fprintf(outStream, "static const ClockFrame %sFrames[%zu] ROM_DATA = {\n", message->name, *count);
+
+    for(size_t i = 0; i < *count; ++i) {
+        fprintf(outStream, "%s0x%016llxULL,%s",
+                (i % 4) ? " " : "    ",
+                (unsigned long long)Frames[i],
+                (i % 4 == 3 || i + 1 == *count) ? "\n" : "");
+    }
+
+    fprintf(outStream, "};\n\n");
+
+    return 0;
+}
+
+//
+// @brief prints DateTimeYears, see date_time.h. The calendar is calculated
+//        here from the Gregorian rules, independently of lib/date_time.c
+//
+static int printCalendar()
+{
+    unsigned char years[DATE_TIME_TABLE_YEARS];
+
+    for(int i = 0; i < DATE_TIME_TABLE_YEARS; ++i) {
+        const int year = DATE_TIME_TABLE_FIRST_YEAR + i;
+        const int isLeap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+
+        //
+        // January 1 of year 1 is a Monday. Every year moves it by one
+        // day of week, and every leap year by one more
+        //
+        const int y = year - 1;
+        const int dayOfWeek = (y + y / 4 - y / 100 + y / 400 + 1) % 7;
+
+        years[i] = (unsigned char)(dayOfWeek | (isLeap ? DATE_TIME_YEAR_LEAP : 0));
+    }
+
+    Call(printHeader("BinaryClock Gregorian calendar", "date_time.h"));
+
+    fprintf(outStream, "const unsigned char DateTimeYears[DATE_TIME_TABLE_YEARS] ROM_DATA = {\n");
+    Call(printBytes(years, DATE_TIME_TABLE_YEARS));
+    fprintf(outStream, "};\n");
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    errStream = stderr;
+    outStream = stdout;
+
+    if(argc > 1 && strcmp(argv[1], "alphabet") == 0) {
+        Call(printAlphabet());
+        return 0;
+    }
+
+    if(argc > 1 && strcmp(argv[1], "calendar") == 0) {
+        Call(printCalendar());
+        return 0;
+    }
+
+    Call(printHeader("BinaryClock constant messages and their sliding frames", "clock_messages.h"));
+
+    for(size_t i = 0; i < countof(Messages); ++i) {
+        Call(printFrames(&Messages[i], &Counts[i]));
+    }
+
+    fprintf(outStream, "const ClockCacheEntry ClockMessages[] = {\n");
+    for(size_t i = 0; i < countof(Messages); ++i) {
+        fprintf(outStream, "    { %s, %sFrames, %zu },\n", Messages[i].name, Messages[i].name, Counts[i]);
+    }
+    fprintf(outStream, "};\n\n");
+    fprintf(outStream, "const size_t ClockMessagesCount = countof(ClockMessages);\n");
+
+    return 0;
+}